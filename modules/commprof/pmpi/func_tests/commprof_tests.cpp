@@ -0,0 +1,179 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+#include <string>
+#include <vector>
+
+#include "commprof/pmpi/include/commprof.hpp"
+#include "core/perf/include/perf_mpi.hpp"
+
+namespace {
+
+const ppc::core::CommCallStats *find_call(const ppc::core::CommProfile &profile, const std::string &name) {
+  for (const auto &call : profile.calls) {
+    if (call.name == name) return &call;
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+TEST(commprof_tests, check_point_to_point_and_collectives) {
+  int rank = 0;
+  int size = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  auto profiler = ppc::commprof::make_comm_profiler();
+
+  std::vector<int> send(10, rank);
+  std::vector<int> recv(10);
+  int value = rank;
+  int sum = 0;
+  profiler->start();
+  // Ring exchange of 40 bytes
+  MPI_Request request;
+  MPI_Isend(send.data(), 10, MPI_INT, (rank + 1) % size, 0, MPI_COMM_WORLD, &request);
+  MPI_Recv(recv.data(), 10, MPI_INT, (rank + size - 1) % size, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+  MPI_Wait(&request, MPI_STATUS_IGNORE);
+  MPI_Bcast(&value, 1, MPI_INT, 0, MPI_COMM_WORLD);
+  MPI_Allreduce(&value, &sum, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+  profiler->stop();
+  auto profile = ppc::core::reduce_comm_profile(MPI_COMM_WORLD, profiler->collect());
+
+  ASSERT_EQ(profile.num_ranks, size);
+  ASSERT_EQ(profile.traffic_bytes.size(), static_cast<size_t>(size * size));
+  const auto *isend = find_call(profile, "isend");
+  ASSERT_NE(isend, nullptr);
+  EXPECT_EQ(isend->calls, static_cast<uint64_t>(size));
+  EXPECT_EQ(isend->bytes, 40U * size);
+  const auto *recv_call = find_call(profile, "recv");
+  ASSERT_NE(recv_call, nullptr);
+  EXPECT_EQ(recv_call->bytes, 40U * size);
+  ASSERT_NE(find_call(profile, "bcast"), nullptr);
+  ASSERT_NE(find_call(profile, "allreduce"), nullptr);
+
+  // Ring message, bcast from rank 0 and allreduce to every other rank
+  auto expected_bytes = [&](int from, int to) {
+    uint64_t bytes = 0;
+    if (to == (from + 1) % size) bytes += 40;
+    if (from != to) bytes += (from == 0 ? 4 : 0) + 4;
+    return bytes;
+  };
+  for (int from = 0; from < size; from++) {
+    for (int to = 0; to < size; to++) {
+      EXPECT_EQ(profile.traffic_bytes[from * size + to], expected_bytes(from, to));
+    }
+  }
+  EXPECT_GE(profile.comm_time_sec, 0.0);
+}
+
+TEST(commprof_tests, check_stopped_profiler_counts_nothing) {
+  auto profiler = ppc::commprof::make_comm_profiler();
+  int value = 1;
+  MPI_Bcast(&value, 1, MPI_INT, 0, MPI_COMM_WORLD);
+  MPI_Barrier(MPI_COMM_WORLD);
+  auto profile = ppc::core::reduce_comm_profile(MPI_COMM_WORLD, profiler->collect());
+  for (const auto &call : profile.calls) EXPECT_EQ(call.calls, 0U);
+  EXPECT_EQ(profile.total_bytes(), 0U);
+  EXPECT_EQ(profile.total_messages(), 0U);
+}
+
+TEST(commprof_tests, check_nonblocking_and_send_modes) {
+  int rank = 0;
+  int size = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  auto profiler = ppc::commprof::make_comm_profiler();
+
+  std::vector<int> send(10, rank);
+  std::vector<int> recv(10);
+  int value = rank;
+  int sum = 0;
+  profiler->start();
+  // Irecv of 40 bytes from previous rank, completed by Waitall
+  std::vector<MPI_Request> requests(2);
+  MPI_Irecv(recv.data(), 10, MPI_INT, (rank + size - 1) % size, 0, MPI_COMM_WORLD, &requests[0]);
+  MPI_Isend(send.data(), 10, MPI_INT, (rank + 1) % size, 0, MPI_COMM_WORLD, &requests[1]);
+  MPI_Waitall(2, requests.data(), MPI_STATUSES_IGNORE);
+  MPI_Request request;
+  MPI_Iallreduce(&value, &sum, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD, &request);
+  int flag = 0;
+  while (flag == 0) MPI_Testall(1, &request, &flag, MPI_STATUSES_IGNORE);
+  MPI_Exscan(&value, &sum, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+  std::vector<int> counts(size, 1);
+  std::vector<int> values(size, rank);
+  MPI_Reduce_scatter(values.data(), &sum, counts.data(), MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+  profiler->stop();
+  auto profile = ppc::core::reduce_comm_profile(MPI_COMM_WORLD, profiler->collect());
+
+  const auto *irecv = find_call(profile, "irecv");
+  ASSERT_NE(irecv, nullptr);
+  EXPECT_EQ(irecv->bytes, 40U * size);
+  const auto *iallreduce = find_call(profile, "iallreduce");
+  ASSERT_NE(iallreduce, nullptr);
+  EXPECT_EQ(iallreduce->calls, static_cast<uint64_t>(size));
+  ASSERT_NE(find_call(profile, "exscan"), nullptr);
+  const auto *reduce_scatter = find_call(profile, "reduce_scatter");
+  ASSERT_NE(reduce_scatter, nullptr);
+  EXPECT_EQ(reduce_scatter->bytes, 4U * size * (size - 1));
+}
+
+TEST(commprof_tests, check_receives_completed_after_stop_or_cancelled) {
+  int rank = 0;
+  int size = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  auto profiler = ppc::commprof::make_comm_profiler();
+
+  std::vector<int> send(10, rank);
+  std::vector<int> recv(10);
+  profiler->start();
+  // nothing is sent with tag 1
+  MPI_Request cancelled;
+  MPI_Irecv(recv.data(), 10, MPI_INT, MPI_ANY_SOURCE, 1, MPI_COMM_WORLD, &cancelled);
+  MPI_Cancel(&cancelled);
+  MPI_Wait(&cancelled, MPI_STATUS_IGNORE);
+  MPI_Request late;
+  MPI_Irecv(recv.data(), 10, MPI_INT, (rank + size - 1) % size, 0, MPI_COMM_WORLD, &late);
+  MPI_Send(send.data(), 10, MPI_INT, (rank + 1) % size, 0, MPI_COMM_WORLD);
+  profiler->stop();
+  // completion outside of profiled run isn't counted
+  MPI_Wait(&late, MPI_STATUS_IGNORE);
+  auto profile = ppc::core::reduce_comm_profile(MPI_COMM_WORLD, profiler->collect());
+
+  const auto *irecv = find_call(profile, "irecv");
+  ASSERT_NE(irecv, nullptr);
+  EXPECT_EQ(irecv->calls, 2U * size);
+  EXPECT_EQ(irecv->bytes, 0U);
+}
+
+TEST(commprof_tests, check_profile_is_reduced_over_subset_of_ranks) {
+  int rank = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  // only even ranks take part in measurement, collect itself doesn't communicate
+  MPI_Comm even;
+  MPI_Comm_split(MPI_COMM_WORLD, rank % 2 == 0 ? 0 : MPI_UNDEFINED, rank, &even);
+  if (even == MPI_COMM_NULL) return;
+  auto profiler = ppc::commprof::make_comm_profiler();
+  int value = rank;
+  profiler->start();
+  MPI_Bcast(&value, 1, MPI_INT, 0, even);
+  profiler->stop();
+  auto profile = ppc::core::reduce_comm_profile(even, profiler->collect());
+  int even_size = 0;
+  MPI_Comm_size(even, &even_size);
+  const auto *bcast = find_call(profile, "bcast");
+  ASSERT_NE(bcast, nullptr);
+  EXPECT_EQ(bcast->calls, static_cast<uint64_t>(even_size));
+  EXPECT_EQ(profile.total_bytes(), 4U * (even_size - 1));
+  MPI_Comm_free(&even);
+}
+
+int main(int argc, char **argv) {
+  MPI_Init(&argc, &argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  auto result = RUN_ALL_TESTS();
+  MPI_Finalize();
+  return result;
+}
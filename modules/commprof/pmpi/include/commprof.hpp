@@ -0,0 +1,21 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_COMMPROF_INCLUDE_COMMPROF_HPP_
+#define MODULES_COMMPROF_INCLUDE_COMMPROF_HPP_
+
+#include <memory>
+
+#include "core/perf/include/comm_profile.hpp"
+
+namespace ppc {
+namespace commprof {
+
+// Profiler counting MPI calls intercepted by this library through PMPI interface.
+// Library has to be linked as whole archive, then its profiler is also registered as
+// default one of ppc::core::PerfAttr and is used when PPC_COMM_PROFILE is set.
+std::shared_ptr<ppc::core::CommProfiler> make_comm_profiler();
+
+}  // namespace commprof
+}  // namespace ppc
+
+#endif  // MODULES_COMMPROF_INCLUDE_COMMPROF_HPP_
@@ -0,0 +1,586 @@
+// Copyright 2024 Nesterov Alexander
+#include "commprof/pmpi/include/commprof.hpp"
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <numeric>
+#include <unordered_map>
+#include <vector>
+
+#include "core/trace/include/trace.hpp"
+
+namespace {
+
+enum CallType {
+  SEND,
+  RECV,
+  ISEND,
+  IRECV,
+  SENDRECV,
+  WAIT,
+  PROBE,
+  BCAST,
+  REDUCE,
+  ALLREDUCE,
+  GATHER,
+  SCATTER,
+  ALLGATHER,
+  ALLTOALL,
+  SCAN,
+  BARRIER,
+  IREDUCE,
+  IALLREDUCE,
+  REDUCE_SCATTER,
+  EXSCAN,
+  NUM_CALL_TYPES
+};
+
+const std::array<const char *, NUM_CALL_TYPES> call_names = {
+    "send",    "recv",       "isend",          "irecv",  "sendrecv",  "wait",     "probe", "bcast",
+    "reduce",  "allreduce",  "gather",         "scatter", "allgather", "alltoall", "scan",  "barrier",
+    "ireduce", "iallreduce", "reduce_scatter", "exscan"};
+
+// Counters of this rank, they are updated only while profiler is started. Threads of rank may call MPI at once
+// (MPI_THREAD_MULTIPLE), so everything but enabled flag is guarded by mutex, which isn't held over MPI calls
+struct State {
+  std::atomic<bool> enabled{false};
+  std::mutex mutex;
+  int world_rank = 0;
+  int world_size = 0;
+  std::array<uint64_t, NUM_CALL_TYPES> calls{};
+  std::array<uint64_t, NUM_CALL_TYPES> bytes{};
+  std::array<double, NUM_CALL_TYPES> time{};
+  // traffic from this rank to every rank of MPI_COMM_WORLD
+  std::vector<uint64_t> row_bytes;
+  std::vector<uint64_t> row_messages;
+  // datatypes of receives posted by MPI_Irecv, their bytes are counted on completion
+  std::unordered_map<MPI_Request, MPI_Datatype> pending_receives;
+
+  void reset() {
+    calls.fill(0);
+    bytes.fill(0);
+    time.fill(0.0);
+    row_bytes.assign(world_size, 0);
+    row_messages.assign(world_size, 0);
+  }
+};
+
+State &state() {
+  static State s;
+  return s;
+}
+
+void init_world() {
+  auto &s = state();
+  std::lock_guard<std::mutex> lock(s.mutex);
+  if (s.world_size > 0) return;
+  PMPI_Comm_rank(MPI_COMM_WORLD, &s.world_rank);
+  PMPI_Comm_size(MPI_COMM_WORLD, &s.world_size);
+  s.reset();
+}
+
+uint64_t type_bytes(int count, MPI_Datatype datatype) {
+  int size = 0;
+  PMPI_Type_size(datatype, &size);
+  return static_cast<uint64_t>(count) * static_cast<uint64_t>(size);
+}
+
+// Ranks of MPI_COMM_WORLD for all ranks of comm, MPI_UNDEFINED for ranks out of it
+std::vector<int> world_ranks(MPI_Comm comm) {
+  int size = 0;
+  PMPI_Comm_size(comm, &size);
+  std::vector<int> ranks(size);
+  std::iota(ranks.begin(), ranks.end(), 0);
+  if (comm == MPI_COMM_WORLD) return ranks;
+  MPI_Group group;
+  MPI_Group world_group;
+  PMPI_Comm_group(comm, &group);
+  PMPI_Comm_group(MPI_COMM_WORLD, &world_group);
+  std::vector<int> translated(size, MPI_UNDEFINED);
+  PMPI_Group_translate_ranks(group, size, ranks.data(), world_group, translated.data());
+  PMPI_Group_free(&group);
+  PMPI_Group_free(&world_group);
+  return translated;
+}
+
+void add_traffic_world(int world_peer, uint64_t bytes) {
+  auto &s = state();
+  std::lock_guard<std::mutex> lock(s.mutex);
+  if (world_peer < 0 || world_peer >= s.world_size) return;
+  s.row_bytes[world_peer] += bytes;
+  s.row_messages[world_peer]++;
+}
+
+// Message of given size to one rank of comm (MPI_PROC_NULL is skipped)
+void add_traffic(MPI_Comm comm, int peer, uint64_t bytes) {
+  if (!state().enabled || peer < 0) return;
+  if (comm == MPI_COMM_WORLD) {
+    add_traffic_world(peer, bytes);
+    return;
+  }
+  auto ranks = world_ranks(comm);
+  if (peer < static_cast<int>(ranks.size())) add_traffic_world(ranks[peer], bytes);
+}
+
+// Messages to every other rank of comm, bytes_to(comm_rank) gives size of each
+template <typename BytesTo>
+void add_traffic_to_all(MPI_Comm comm, BytesTo bytes_to) {
+  if (!state().enabled) return;
+  int rank = 0;
+  PMPI_Comm_rank(comm, &rank);
+  auto ranks = world_ranks(comm);
+  for (int peer = 0; peer < static_cast<int>(ranks.size()); peer++) {
+    if (peer == rank) continue;
+    auto bytes = bytes_to(peer);
+    if (bytes > 0) add_traffic_world(ranks[peer], bytes);
+  }
+}
+
+// Counts bytes of receive posted by MPI_Irecv once request is completed with status, if profiler is still started
+void complete_receive(MPI_Request request, const MPI_Status &status) {
+  auto &s = state();
+  std::lock_guard<std::mutex> lock(s.mutex);
+  auto it = s.pending_receives.find(request);
+  if (it == s.pending_receives.end()) return;
+  int received = 0;
+  if (s.enabled && PMPI_Get_count(&status, it->second, &received) == MPI_SUCCESS && received != MPI_UNDEFINED) {
+    s.bytes[IRECV] += type_bytes(received, it->second);
+  }
+  s.pending_receives.erase(it);
+}
+
+// Request won't be completed by wait or test (freed) or its receive may not happen (cancelled), handle of
+// request may be reused by MPI later
+void forget_receive(MPI_Request request) {
+  auto &s = state();
+  std::lock_guard<std::mutex> lock(s.mutex);
+  s.pending_receives.erase(request);
+}
+
+// Completion of requests[i] for every i with done(i), statuses may be MPI_STATUSES_IGNORE
+template <typename Done>
+void complete_receives(const std::vector<MPI_Request> &requests, const MPI_Status *statuses, Done done) {
+  for (size_t i = 0; i < requests.size(); i++) {
+    if (done(i)) complete_receive(requests[i], statuses[i]);
+  }
+}
+
+bool is_root(MPI_Comm comm, int root) {
+  int rank = 0;
+  PMPI_Comm_rank(comm, &rank);
+  return rank == root;
+}
+
+// Counts one call and its time
+class CallScope {
+ public:
+  explicit CallScope(CallType type_)
+      : type(type_),
+        active(state().enabled),
+        begin(active ? PMPI_Wtime() : 0.0),
+        trace_begin(ppc::core::Tracer::instance().enabled() ? ppc::core::Tracer::now_ns() : -1) {}
+  CallScope(const CallScope &) = delete;
+  CallScope &operator=(const CallScope &) = delete;
+  ~CallScope() {
+    // calls are on timeline whenever tracing is on, not only in profiled runs
+    if (trace_begin >= 0) {
+      ppc::core::Tracer::instance().record(call_names[type], "mpi", trace_begin, ppc::core::Tracer::now_ns());
+    }
+    if (!active) return;
+    const auto end = PMPI_Wtime();
+    std::lock_guard<std::mutex> lock(state().mutex);
+    state().calls[type]++;
+    state().time[type] += end - begin;
+  }
+
+  void add_bytes(uint64_t bytes) {
+    if (!active) return;
+    std::lock_guard<std::mutex> lock(state().mutex);
+    state().bytes[type] += bytes;
+  }
+
+ private:
+  CallType type;
+  bool active;
+  double begin;
+  int64_t trace_begin;
+};
+
+class PmpiCommProfiler : public ppc::core::CommProfiler {
+ public:
+  void start() override {
+    init_world();
+    state().enabled = true;
+  }
+
+  void stop() override { state().enabled = false; }
+
+  // Profile of this rank only: its calls and its row of traffic matrix, reduced over ranks of measurement by
+  // ppc::core::reduce_comm_profile, so no collective is called here
+  ppc::core::CommProfile collect() override {
+    init_world();
+    auto &s = state();
+    s.enabled = false;
+    std::lock_guard<std::mutex> lock(s.mutex);
+    auto n = s.world_size;
+
+    ppc::core::CommProfile profile;
+    profile.num_ranks = n;
+    profile.traffic_bytes.assign(static_cast<size_t>(n) * n, 0);
+    profile.traffic_messages.assign(static_cast<size_t>(n) * n, 0);
+    std::copy(s.row_bytes.begin(), s.row_bytes.end(), profile.traffic_bytes.begin() + s.world_rank * n);
+    std::copy(s.row_messages.begin(), s.row_messages.end(), profile.traffic_messages.begin() + s.world_rank * n);
+    // all types are listed in the same order on every rank, so profiles are reduced element-wise
+    for (int type = 0; type < NUM_CALL_TYPES; type++) {
+      profile.calls.push_back({call_names[type], s.calls[type], s.bytes[type], s.time[type]});
+      profile.comm_time_sec += s.time[type];
+    }
+    s.reset();
+    return profile;
+  }
+};
+
+// Whole archive linking keeps this registration in executable
+[[maybe_unused]] const bool registered = [] {
+  ppc::core::register_comm_profiler(ppc::commprof::make_comm_profiler());
+  return true;
+}();
+
+}  // namespace
+
+std::shared_ptr<ppc::core::CommProfiler> ppc::commprof::make_comm_profiler() {
+  static auto profiler = std::make_shared<PmpiCommProfiler>();
+  return profiler;
+}
+
+extern "C" {
+
+int MPI_Send(const void *buf, int count, MPI_Datatype datatype, int dest, int tag, MPI_Comm comm) {
+  CallScope scope(SEND);
+  scope.add_bytes(type_bytes(count, datatype));
+  add_traffic(comm, dest, type_bytes(count, datatype));
+  return PMPI_Send(buf, count, datatype, dest, tag, comm);
+}
+
+int MPI_Ssend(const void *buf, int count, MPI_Datatype datatype, int dest, int tag, MPI_Comm comm) {
+  CallScope scope(SEND);
+  scope.add_bytes(type_bytes(count, datatype));
+  add_traffic(comm, dest, type_bytes(count, datatype));
+  return PMPI_Ssend(buf, count, datatype, dest, tag, comm);
+}
+
+int MPI_Bsend(const void *buf, int count, MPI_Datatype datatype, int dest, int tag, MPI_Comm comm) {
+  CallScope scope(SEND);
+  scope.add_bytes(type_bytes(count, datatype));
+  add_traffic(comm, dest, type_bytes(count, datatype));
+  return PMPI_Bsend(buf, count, datatype, dest, tag, comm);
+}
+
+int MPI_Rsend(const void *buf, int count, MPI_Datatype datatype, int dest, int tag, MPI_Comm comm) {
+  CallScope scope(SEND);
+  scope.add_bytes(type_bytes(count, datatype));
+  add_traffic(comm, dest, type_bytes(count, datatype));
+  return PMPI_Rsend(buf, count, datatype, dest, tag, comm);
+}
+
+int MPI_Isend(const void *buf, int count, MPI_Datatype datatype, int dest, int tag, MPI_Comm comm,
+              MPI_Request *request) {
+  CallScope scope(ISEND);
+  scope.add_bytes(type_bytes(count, datatype));
+  add_traffic(comm, dest, type_bytes(count, datatype));
+  return PMPI_Isend(buf, count, datatype, dest, tag, comm, request);
+}
+
+int MPI_Recv(void *buf, int count, MPI_Datatype datatype, int source, int tag, MPI_Comm comm, MPI_Status *status) {
+  CallScope scope(RECV);
+  MPI_Status local_status;
+  auto *used_status = status == MPI_STATUS_IGNORE ? &local_status : status;
+  auto result = PMPI_Recv(buf, count, datatype, source, tag, comm, used_status);
+  int received = 0;
+  if (result == MPI_SUCCESS && PMPI_Get_count(used_status, datatype, &received) == MPI_SUCCESS &&
+      received != MPI_UNDEFINED) {
+    scope.add_bytes(type_bytes(received, datatype));
+  }
+  return result;
+}
+
+int MPI_Irecv(void *buf, int count, MPI_Datatype datatype, int source, int tag, MPI_Comm comm, MPI_Request *request) {
+  CallScope scope(IRECV);
+  auto result = PMPI_Irecv(buf, count, datatype, source, tag, comm, request);
+  // message traffic is counted by its sender, received bytes are known once request is completed
+  if (result == MPI_SUCCESS && state().enabled) {
+    std::lock_guard<std::mutex> lock(state().mutex);
+    state().pending_receives[*request] = datatype;
+  }
+  return result;
+}
+
+int MPI_Cancel(MPI_Request *request) {
+  forget_receive(*request);
+  return PMPI_Cancel(request);
+}
+
+int MPI_Request_free(MPI_Request *request) {
+  forget_receive(*request);
+  return PMPI_Request_free(request);
+}
+
+int MPI_Sendrecv(const void *sendbuf, int sendcount, MPI_Datatype sendtype, int dest, int sendtag, void *recvbuf,
+                 int recvcount, MPI_Datatype recvtype, int source, int recvtag, MPI_Comm comm, MPI_Status *status) {
+  CallScope scope(SENDRECV);
+  scope.add_bytes(type_bytes(sendcount, sendtype));
+  add_traffic(comm, dest, type_bytes(sendcount, sendtype));
+  return PMPI_Sendrecv(sendbuf, sendcount, sendtype, dest, sendtag, recvbuf, recvcount, recvtype, source, recvtag,
+                       comm, status);
+}
+
+int MPI_Wait(MPI_Request *request, MPI_Status *status) {
+  CallScope scope(WAIT);
+  MPI_Status local_status;
+  auto *used_status = status == MPI_STATUS_IGNORE ? &local_status : status;
+  const auto posted = *request;
+  auto result = PMPI_Wait(request, used_status);
+  if (result == MPI_SUCCESS) complete_receive(posted, *used_status);
+  return result;
+}
+
+int MPI_Waitall(int count, MPI_Request array_of_requests[], MPI_Status array_of_statuses[]) {
+  CallScope scope(WAIT);
+  std::vector<MPI_Status> local_statuses(array_of_statuses == MPI_STATUSES_IGNORE ? count : 0);
+  auto *used_statuses = array_of_statuses == MPI_STATUSES_IGNORE ? local_statuses.data() : array_of_statuses;
+  const std::vector<MPI_Request> posted(array_of_requests, array_of_requests + count);
+  auto result = PMPI_Waitall(count, array_of_requests, used_statuses);
+  if (result == MPI_SUCCESS) complete_receives(posted, used_statuses, [](size_t) { return true; });
+  return result;
+}
+
+int MPI_Waitany(int count, MPI_Request array_of_requests[], int *index, MPI_Status *status) {
+  CallScope scope(WAIT);
+  MPI_Status local_status;
+  auto *used_status = status == MPI_STATUS_IGNORE ? &local_status : status;
+  const std::vector<MPI_Request> posted(array_of_requests, array_of_requests + count);
+  auto result = PMPI_Waitany(count, array_of_requests, index, used_status);
+  if (result == MPI_SUCCESS && *index != MPI_UNDEFINED) complete_receive(posted[*index], *used_status);
+  return result;
+}
+
+int MPI_Waitsome(int incount, MPI_Request array_of_requests[], int *outcount, int array_of_indices[],
+                 MPI_Status array_of_statuses[]) {
+  CallScope scope(WAIT);
+  std::vector<MPI_Status> local_statuses(array_of_statuses == MPI_STATUSES_IGNORE ? incount : 0);
+  auto *used_statuses = array_of_statuses == MPI_STATUSES_IGNORE ? local_statuses.data() : array_of_statuses;
+  const std::vector<MPI_Request> posted(array_of_requests, array_of_requests + incount);
+  auto result = PMPI_Waitsome(incount, array_of_requests, outcount, array_of_indices, used_statuses);
+  if (result == MPI_SUCCESS && *outcount != MPI_UNDEFINED) {
+    for (int i = 0; i < *outcount; i++) complete_receive(posted[array_of_indices[i]], used_statuses[i]);
+  }
+  return result;
+}
+
+int MPI_Test(MPI_Request *request, int *flag, MPI_Status *status) {
+  CallScope scope(WAIT);
+  MPI_Status local_status;
+  auto *used_status = status == MPI_STATUS_IGNORE ? &local_status : status;
+  const auto posted = *request;
+  auto result = PMPI_Test(request, flag, used_status);
+  if (result == MPI_SUCCESS && *flag != 0) complete_receive(posted, *used_status);
+  return result;
+}
+
+int MPI_Testall(int count, MPI_Request array_of_requests[], int *flag, MPI_Status array_of_statuses[]) {
+  CallScope scope(WAIT);
+  std::vector<MPI_Status> local_statuses(array_of_statuses == MPI_STATUSES_IGNORE ? count : 0);
+  auto *used_statuses = array_of_statuses == MPI_STATUSES_IGNORE ? local_statuses.data() : array_of_statuses;
+  const std::vector<MPI_Request> posted(array_of_requests, array_of_requests + count);
+  auto result = PMPI_Testall(count, array_of_requests, flag, used_statuses);
+  if (result == MPI_SUCCESS && *flag != 0) complete_receives(posted, used_statuses, [](size_t) { return true; });
+  return result;
+}
+
+int MPI_Probe(int source, int tag, MPI_Comm comm, MPI_Status *status) {
+  CallScope scope(PROBE);
+  return PMPI_Probe(source, tag, comm, status);
+}
+
+int MPI_Iprobe(int source, int tag, MPI_Comm comm, int *flag, MPI_Status *status) {
+  CallScope scope(PROBE);
+  return PMPI_Iprobe(source, tag, comm, flag, status);
+}
+
+int MPI_Bcast(void *buffer, int count, MPI_Datatype datatype, int root, MPI_Comm comm) {
+  CallScope scope(BCAST);
+  if (is_root(comm, root)) {
+    auto bytes = type_bytes(count, datatype);
+    scope.add_bytes(bytes);
+    add_traffic_to_all(comm, [&](int) { return bytes; });
+  }
+  return PMPI_Bcast(buffer, count, datatype, root, comm);
+}
+
+int MPI_Reduce(const void *sendbuf, void *recvbuf, int count, MPI_Datatype datatype, MPI_Op op, int root,
+               MPI_Comm comm) {
+  CallScope scope(REDUCE);
+  if (!is_root(comm, root)) {
+    scope.add_bytes(type_bytes(count, datatype));
+    add_traffic(comm, root, type_bytes(count, datatype));
+  }
+  return PMPI_Reduce(sendbuf, recvbuf, count, datatype, op, root, comm);
+}
+
+int MPI_Allreduce(const void *sendbuf, void *recvbuf, int count, MPI_Datatype datatype, MPI_Op op, MPI_Comm comm) {
+  CallScope scope(ALLREDUCE);
+  auto bytes = type_bytes(count, datatype);
+  scope.add_bytes(bytes);
+  add_traffic_to_all(comm, [&](int) { return bytes; });
+  return PMPI_Allreduce(sendbuf, recvbuf, count, datatype, op, comm);
+}
+
+int MPI_Ireduce(const void *sendbuf, void *recvbuf, int count, MPI_Datatype datatype, MPI_Op op, int root,
+                MPI_Comm comm, MPI_Request *request) {
+  CallScope scope(IREDUCE);
+  if (!is_root(comm, root)) {
+    scope.add_bytes(type_bytes(count, datatype));
+    add_traffic(comm, root, type_bytes(count, datatype));
+  }
+  return PMPI_Ireduce(sendbuf, recvbuf, count, datatype, op, root, comm, request);
+}
+
+int MPI_Iallreduce(const void *sendbuf, void *recvbuf, int count, MPI_Datatype datatype, MPI_Op op, MPI_Comm comm,
+                   MPI_Request *request) {
+  CallScope scope(IALLREDUCE);
+  auto bytes = type_bytes(count, datatype);
+  scope.add_bytes(bytes);
+  add_traffic_to_all(comm, [&](int) { return bytes; });
+  return PMPI_Iallreduce(sendbuf, recvbuf, count, datatype, op, comm, request);
+}
+
+// Every rank sends recvcounts[peer] elements of its contribution to every other peer
+int MPI_Reduce_scatter(const void *sendbuf, void *recvbuf, const int recvcounts[], MPI_Datatype datatype, MPI_Op op,
+                       MPI_Comm comm) {
+  CallScope scope(REDUCE_SCATTER);
+  add_traffic_to_all(comm, [&](int peer) {
+    scope.add_bytes(type_bytes(recvcounts[peer], datatype));
+    return type_bytes(recvcounts[peer], datatype);
+  });
+  return PMPI_Reduce_scatter(sendbuf, recvbuf, recvcounts, datatype, op, comm);
+}
+
+int MPI_Scan(const void *sendbuf, void *recvbuf, int count, MPI_Datatype datatype, MPI_Op op, MPI_Comm comm) {
+  CallScope scope(SCAN);
+  auto bytes = type_bytes(count, datatype);
+  scope.add_bytes(bytes);
+  int rank = 0;
+  PMPI_Comm_rank(comm, &rank);
+  add_traffic_to_all(comm, [&](int peer) { return peer > rank ? bytes : 0; });
+  return PMPI_Scan(sendbuf, recvbuf, count, datatype, op, comm);
+}
+
+int MPI_Exscan(const void *sendbuf, void *recvbuf, int count, MPI_Datatype datatype, MPI_Op op, MPI_Comm comm) {
+  CallScope scope(EXSCAN);
+  auto bytes = type_bytes(count, datatype);
+  scope.add_bytes(bytes);
+  int rank = 0;
+  PMPI_Comm_rank(comm, &rank);
+  add_traffic_to_all(comm, [&](int peer) { return peer > rank ? bytes : 0; });
+  return PMPI_Exscan(sendbuf, recvbuf, count, datatype, op, comm);
+}
+
+int MPI_Gather(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, int recvcount,
+               MPI_Datatype recvtype, int root, MPI_Comm comm) {
+  CallScope scope(GATHER);
+  if (!is_root(comm, root)) {
+    scope.add_bytes(type_bytes(sendcount, sendtype));
+    add_traffic(comm, root, type_bytes(sendcount, sendtype));
+  }
+  return PMPI_Gather(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, root, comm);
+}
+
+int MPI_Gatherv(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, const int recvcounts[],
+                const int displs[], MPI_Datatype recvtype, int root, MPI_Comm comm) {
+  CallScope scope(GATHER);
+  if (!is_root(comm, root)) {
+    scope.add_bytes(type_bytes(sendcount, sendtype));
+    add_traffic(comm, root, type_bytes(sendcount, sendtype));
+  }
+  return PMPI_Gatherv(sendbuf, sendcount, sendtype, recvbuf, recvcounts, displs, recvtype, root, comm);
+}
+
+int MPI_Scatter(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, int recvcount,
+                MPI_Datatype recvtype, int root, MPI_Comm comm) {
+  CallScope scope(SCATTER);
+  if (is_root(comm, root)) {
+    auto bytes = type_bytes(sendcount, sendtype);
+    add_traffic_to_all(comm, [&](int) {
+      scope.add_bytes(bytes);
+      return bytes;
+    });
+  }
+  return PMPI_Scatter(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, root, comm);
+}
+
+int MPI_Scatterv(const void *sendbuf, const int sendcounts[], const int displs[], MPI_Datatype sendtype,
+                 void *recvbuf, int recvcount, MPI_Datatype recvtype, int root, MPI_Comm comm) {
+  CallScope scope(SCATTER);
+  if (is_root(comm, root)) {
+    add_traffic_to_all(comm, [&](int peer) {
+      scope.add_bytes(type_bytes(sendcounts[peer], sendtype));
+      return type_bytes(sendcounts[peer], sendtype);
+    });
+  }
+  return PMPI_Scatterv(sendbuf, sendcounts, displs, sendtype, recvbuf, recvcount, recvtype, root, comm);
+}
+
+int MPI_Allgather(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, int recvcount,
+                  MPI_Datatype recvtype, MPI_Comm comm) {
+  CallScope scope(ALLGATHER);
+  auto bytes = sendbuf == MPI_IN_PLACE ? type_bytes(recvcount, recvtype) : type_bytes(sendcount, sendtype);
+  scope.add_bytes(bytes);
+  add_traffic_to_all(comm, [&](int) { return bytes; });
+  return PMPI_Allgather(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, comm);
+}
+
+int MPI_Allgatherv(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, const int recvcounts[],
+                   const int displs[], MPI_Datatype recvtype, MPI_Comm comm) {
+  CallScope scope(ALLGATHER);
+  int rank = 0;
+  PMPI_Comm_rank(comm, &rank);
+  auto bytes = sendbuf == MPI_IN_PLACE ? type_bytes(recvcounts[rank], recvtype) : type_bytes(sendcount, sendtype);
+  scope.add_bytes(bytes);
+  add_traffic_to_all(comm, [&](int) { return bytes; });
+  return PMPI_Allgatherv(sendbuf, sendcount, sendtype, recvbuf, recvcounts, displs, recvtype, comm);
+}
+
+int MPI_Alltoall(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, int recvcount,
+                 MPI_Datatype recvtype, MPI_Comm comm) {
+  CallScope scope(ALLTOALL);
+  auto bytes = sendbuf == MPI_IN_PLACE ? type_bytes(recvcount, recvtype) : type_bytes(sendcount, sendtype);
+  add_traffic_to_all(comm, [&](int) {
+    scope.add_bytes(bytes);
+    return bytes;
+  });
+  return PMPI_Alltoall(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, comm);
+}
+
+int MPI_Alltoallv(const void *sendbuf, const int sendcounts[], const int sdispls[], MPI_Datatype sendtype,
+                  void *recvbuf, const int recvcounts[], const int rdispls[], MPI_Datatype recvtype, MPI_Comm comm) {
+  CallScope scope(ALLTOALL);
+  bool in_place = sendbuf == MPI_IN_PLACE;
+  add_traffic_to_all(comm, [&](int peer) {
+    auto bytes = in_place ? type_bytes(recvcounts[peer], recvtype) : type_bytes(sendcounts[peer], sendtype);
+    scope.add_bytes(bytes);
+    return bytes;
+  });
+  return PMPI_Alltoallv(sendbuf, sendcounts, sdispls, sendtype, recvbuf, recvcounts, rdispls, recvtype, comm);
+}
+
+int MPI_Barrier(MPI_Comm comm) {
+  CallScope scope(BARRIER);
+  return PMPI_Barrier(comm);
+}
+
+}  // extern "C"
@@ -0,0 +1,82 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "core/affinity/include/affinity.hpp"
+
+TEST(affinity_tests, check_parse_placement) {
+  auto placement = ppc::core::Placement::parse("0,2,4-6", "interleave");
+  EXPECT_EQ(placement.affinity, ppc::core::AffinityPolicy::EXPLICIT);
+  EXPECT_EQ(placement.cpus, std::vector<int>({0, 2, 4, 5, 6}));
+  EXPECT_EQ(placement.memory, ppc::core::MemoryPolicy::INTERLEAVE);
+  EXPECT_EQ(placement.describe(), "0 2 4 5 6/interleave");
+  EXPECT_EQ(placement.cpu_for_worker(1), 2);
+  EXPECT_EQ(placement.cpu_for_worker(6), 2);
+
+  EXPECT_EQ(ppc::core::Placement::parse("", "").describe(), "none/default");
+  EXPECT_EQ(ppc::core::Placement::parse("scatter", "first_touch").describe(), "scatter/first_touch");
+  EXPECT_EQ(ppc::core::Placement::parse("none", "").cpu_for_worker(0), -1);
+
+  EXPECT_THROW(ppc::core::Placement::parse("spread", ""), std::invalid_argument);
+  EXPECT_THROW(ppc::core::Placement::parse("3-1", ""), std::invalid_argument);
+  EXPECT_THROW(ppc::core::Placement::parse("compact", "local"), std::invalid_argument);
+}
+
+TEST(affinity_tests, check_policies_use_allowed_cpus) {
+  const auto &topology = ppc::core::cpu_topology();
+  ASSERT_FALSE(topology.empty());
+  EXPECT_GE(ppc::core::numa_nodes_count(), 1);
+  auto allowed = [&](int cpu) {
+    return std::any_of(topology.begin(), topology.end(), [cpu](const auto &info) { return info.cpu == cpu; });
+  };
+  for (const auto *name : {"compact", "scatter"}) {
+    auto placement = ppc::core::Placement::parse(name, "");
+    std::vector<int> cpus;
+    for (size_t i = 0; i < topology.size(); i++) cpus.push_back(placement.cpu_for_worker(static_cast<int>(i)));
+    EXPECT_TRUE(std::all_of(cpus.begin(), cpus.end(), allowed));
+    std::sort(cpus.begin(), cpus.end());
+    EXPECT_EQ(std::adjacent_find(cpus.begin(), cpus.end()), cpus.end());
+  }
+}
+
+TEST(affinity_tests, check_placed_copy) {
+  auto previous = ppc::core::current_placement();
+  std::vector<int> src(100000);
+  std::iota(src.begin(), src.end(), 0);
+  for (const auto *memory : {"default", "first_touch", "interleave"}) {
+    ppc::core::set_current_placement(ppc::core::Placement::parse("compact", memory));
+    std::vector<int> dst(src.size());
+    EXPECT_TRUE(ppc::core::place_memory(dst.data(), dst.size() * sizeof(int), 3, ppc::core::current_placement()));
+    ppc::core::placed_copy(dst.data(), src.data(), src.size() * sizeof(int), 3);
+    EXPECT_EQ(dst, src);
+  }
+  ppc::core::set_current_placement(previous);
+}
+
+TEST(affinity_tests, check_placement_scope_restores_placement) {
+  auto previous = ppc::core::current_placement().describe();
+#ifdef __linux__
+  cpu_set_t before;
+  ASSERT_EQ(pthread_getaffinity_np(pthread_self(), sizeof(before), &before), 0);
+#endif
+  {
+    const ppc::core::PlacementScope scope(ppc::core::Placement::parse("compact", "interleave"));
+    EXPECT_EQ(ppc::core::current_placement().describe(), "compact/interleave");
+  }
+  EXPECT_EQ(ppc::core::current_placement().describe(), previous);
+#ifdef __linux__
+  cpu_set_t after;
+  ASSERT_EQ(pthread_getaffinity_np(pthread_self(), sizeof(after), &after), 0);
+  EXPECT_TRUE(CPU_EQUAL(&before, &after));
+#endif
+}
@@ -0,0 +1,89 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_AFFINITY_HPP_
+#define MODULES_CORE_INCLUDE_AFFINITY_HPP_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace ppc::core {
+
+// How worker threads are pinned to logical CPUs
+enum class AffinityPolicy {
+  NONE,     // not pinned
+  COMPACT,  // fill cores of one NUMA node before the next one
+  SCATTER,  // round-robin over NUMA nodes, physical cores before their hyper-threads
+  EXPLICIT  // given list of CPUs
+};
+
+// Where pages of task's buffers are placed
+enum class MemoryPolicy {
+  DEFAULT,      // first touch of whichever thread writes first
+  FIRST_TOUCH,  // i-th chunk of buffer on NUMA node of i-th worker
+  INTERLEAVE    // pages round-robin over all NUMA nodes
+};
+
+struct Placement {
+  AffinityPolicy affinity = AffinityPolicy::NONE;
+  // CPUs of EXPLICIT policy
+  std::vector<int> cpus;
+  MemoryPolicy memory = MemoryPolicy::DEFAULT;
+
+  // affinity: none, compact, scatter or list of CPUs like "0,2,4-7"; memory: default, first_touch or interleave.
+  // Throws std::invalid_argument for unknown values
+  static Placement parse(const std::string &affinity, const std::string &memory);
+  // Parse PPC_AFFINITY and PPC_MEMORY_POLICY environment variables
+  static Placement from_env();
+  // e.g. "scatter/interleave" or "0 2 4/default"
+  [[nodiscard]] std::string describe() const;
+  // Logical CPU of index-th worker thread, -1 if workers are not pinned
+  [[nodiscard]] int cpu_for_worker(int index) const;
+};
+
+// Logical CPU available to process and its location
+struct CpuInfo {
+  int cpu = 0;
+  int core = 0;
+  int package = 0;
+  int node = 0;
+};
+
+// CPUs of current affinity mask of process, read from Linux sysfs once (single CPU 0 elsewhere)
+const std::vector<CpuInfo> &cpu_topology();
+int numa_nodes_count();
+
+// Placement honoured by tasks and Perf, from environment until it's set
+Placement current_placement();
+void set_current_placement(const Placement &placement);
+
+// Pin calling thread to logical CPU, false if it's not supported or failed
+bool pin_current_thread(int cpu);
+// Pin calling thread as index-th worker of current placement (no-op without affinity policy)
+void pin_worker(int index);
+
+// Makes placement current and pins calling thread as worker 0 while scope lives, previous placement and
+// affinity mask of calling thread are restored on destruction
+class PlacementScope {
+ public:
+  explicit PlacementScope(const Placement &placement);
+  ~PlacementScope();
+  PlacementScope(const PlacementScope &) = delete;
+  PlacementScope &operator=(const PlacementScope &) = delete;
+
+ private:
+  Placement previous;
+  // CPUs of affinity mask of calling thread, empty if it's not supported
+  std::vector<int> previous_cpus;
+};
+
+// Move pages of buffer by memory policy of placement for num_workers equal chunks,
+// false if it's not supported (Linux mbind only); single NUMA node needs no placement
+bool place_memory(void *data, size_t bytes, int num_workers, const Placement &placement);
+// Copy src to dst with num_workers threads pinned as workers of current placement, so every chunk
+// of dst is first touched near the worker which processes it; plain memcpy without placement
+void placed_copy(void *dst, const void *src, size_t bytes, int num_workers);
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_AFFINITY_HPP_
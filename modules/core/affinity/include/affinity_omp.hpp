@@ -0,0 +1,21 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_AFFINITY_OMP_HPP_
+#define MODULES_CORE_INCLUDE_AFFINITY_OMP_HPP_
+
+#include <omp.h>
+
+#include "core/affinity/include/affinity.hpp"
+
+namespace ppc::core {
+
+// Pin threads of OpenMP team as workers of current placement, team threads are reused by next parallel regions
+inline void pin_omp_threads() {
+  if (current_placement().affinity == AffinityPolicy::NONE) return;
+#pragma omp parallel
+  pin_worker(omp_get_thread_num());
+}
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_AFFINITY_OMP_HPP_
@@ -0,0 +1,29 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_AFFINITY_TBB_HPP_
+#define MODULES_CORE_INCLUDE_AFFINITY_TBB_HPP_
+
+#include <tbb/tbb.h>
+
+#include "core/affinity/include/affinity.hpp"
+
+namespace ppc::core {
+
+// Pin every thread entering current task arena as worker of current placement while observer lives
+class TbbPinningObserver : public oneapi::tbb::task_scheduler_observer {
+ public:
+  TbbPinningObserver() {
+    if (current_placement().affinity != AffinityPolicy::NONE) observe(true);
+  }
+  ~TbbPinningObserver() override { observe(false); }
+  TbbPinningObserver(const TbbPinningObserver &) = delete;
+  TbbPinningObserver &operator=(const TbbPinningObserver &) = delete;
+
+  void on_scheduler_entry(bool /*is_worker*/) override {
+    pin_worker(oneapi::tbb::this_task_arena::current_thread_index());
+  }
+};
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_AFFINITY_TBB_HPP_
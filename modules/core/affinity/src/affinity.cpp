@@ -0,0 +1,378 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/affinity/include/affinity.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// Constants of linux/mempolicy.h, mbind is called directly to avoid dependency on libnuma
+constexpr int kMpolPreferred = 1;
+constexpr int kMpolInterleave = 3;
+constexpr unsigned kMpolMfMove = 1U << 1;
+
+std::string get_env(const char *name) {
+#ifdef _MSC_VER
+  char *buf = nullptr;
+  size_t len = 0;
+  if (_dupenv_s(&buf, &len, name) != 0 || buf == nullptr) return {};
+  std::string value(buf);
+  free(buf);
+  return value;
+#else
+  const char *value = std::getenv(name);
+  return value != nullptr ? value : "";
+#endif
+}
+
+int parse_cpu(const std::string &value) {
+  size_t pos = 0;
+  int cpu = -1;
+  try {
+    cpu = std::stoi(value, &pos);
+  } catch (const std::exception &) {
+    pos = 0;
+  }
+  if (pos == 0 || pos != value.size() || cpu < 0) {
+    throw std::invalid_argument("Invalid CPU '" + value + "' in affinity");
+  }
+  return cpu;
+}
+
+// "0,2,4-7" -> 0 2 4 5 6 7
+std::vector<int> parse_cpu_list(const std::string &value) {
+  std::vector<int> cpus;
+  std::stringstream stream(value);
+  std::string item;
+  while (std::getline(stream, item, ',')) {
+    auto dash = item.find('-');
+    if (dash == std::string::npos) {
+      cpus.push_back(parse_cpu(item));
+      continue;
+    }
+    int first = parse_cpu(item.substr(0, dash));
+    int last = parse_cpu(item.substr(dash + 1));
+    if (first > last) throw std::invalid_argument("Invalid CPU range '" + item + "' in affinity");
+    for (int cpu = first; cpu <= last; cpu++) cpus.push_back(cpu);
+  }
+  if (cpus.empty()) throw std::invalid_argument("Empty CPU list in affinity");
+  return cpus;
+}
+
+#ifdef __linux__
+int read_sysfs_int(const std::filesystem::path &path, int default_value) {
+  std::ifstream file(path);
+  int value = default_value;
+  if (!(file >> value)) return default_value;
+  return value;
+}
+
+int sysfs_node(const std::filesystem::path &cpu_dir) {
+  std::error_code error;
+  for (const auto &entry : std::filesystem::directory_iterator(cpu_dir, error)) {
+    auto name = entry.path().filename().string();
+    if (name.rfind("node", 0) == 0 && name.size() > 4 &&
+        std::all_of(name.begin() + 4, name.end(), [](char c) { return c >= '0' && c <= '9'; })) {
+      return std::stoi(name.substr(4));
+    }
+  }
+  return 0;
+}
+#endif
+
+std::vector<ppc::core::CpuInfo> read_topology() {
+  std::vector<ppc::core::CpuInfo> cpus;
+#ifdef __linux__
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  if (sched_getaffinity(0, sizeof(mask), &mask) == 0) {
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+      if (!CPU_ISSET(cpu, &mask)) continue;
+      std::filesystem::path dir = "/sys/devices/system/cpu/cpu" + std::to_string(cpu);
+      ppc::core::CpuInfo info;
+      info.cpu = cpu;
+      info.core = read_sysfs_int(dir / "topology" / "core_id", cpu);
+      info.package = read_sysfs_int(dir / "topology" / "physical_package_id", 0);
+      info.node = sysfs_node(dir);
+      cpus.push_back(info);
+    }
+  }
+#endif
+  if (cpus.empty()) cpus.push_back({});
+  return cpus;
+}
+
+// Worker order of COMPACT and SCATTER policies
+std::vector<int> worker_order(ppc::core::AffinityPolicy policy) {
+  auto cpus = ppc::core::cpu_topology();
+  std::sort(cpus.begin(), cpus.end(), [](const auto &a, const auto &b) {
+    return std::tie(a.node, a.package, a.core, a.cpu) < std::tie(b.node, b.package, b.core, b.cpu);
+  });
+  std::vector<int> order;
+  if (policy == ppc::core::AffinityPolicy::COMPACT) {
+    for (const auto &info : cpus) order.push_back(info.cpu);
+    return order;
+  }
+  // Per node: first hardware thread of every core, then the second ones and so on
+  std::map<int, std::vector<int>> nodes;
+  std::map<std::tuple<int, int, int>, int> sibling;
+  std::vector<std::pair<int, int>> ranked;
+  for (const auto &info : cpus) {
+    int rank = sibling[{info.node, info.package, info.core}]++;
+    ranked.emplace_back(rank, info.cpu);
+  }
+  std::map<int, std::vector<std::pair<int, int>>> per_node;
+  for (size_t i = 0; i < cpus.size(); i++) per_node[cpus[i].node].push_back(ranked[i]);
+  for (auto &[node, list] : per_node) {
+    std::stable_sort(list.begin(), list.end(), [](const auto &a, const auto &b) { return a.first < b.first; });
+    for (const auto &item : list) nodes[node].push_back(item.second);
+  }
+  for (size_t i = 0; order.size() < cpus.size(); i++) {
+    for (const auto &[node, list] : nodes) {
+      if (i < list.size()) order.push_back(list[i]);
+    }
+  }
+  return order;
+}
+
+int node_of_cpu(int cpu) {
+  for (const auto &info : ppc::core::cpu_topology()) {
+    if (info.cpu == cpu) return info.node;
+  }
+  return 0;
+}
+
+bool bind_range([[maybe_unused]] void *data, [[maybe_unused]] size_t bytes, [[maybe_unused]] int mode,
+                [[maybe_unused]] const std::vector<int> &nodes) {
+#if defined(__linux__) && defined(SYS_mbind)
+  std::vector<unsigned long> mask(1);
+  int max_node = 0;
+  for (int node : nodes) {
+    auto bits = 8 * sizeof(unsigned long);
+    if (static_cast<size_t>(node) / bits >= mask.size()) mask.resize(node / bits + 1);
+    mask[node / bits] |= 1UL << (node % bits);
+    max_node = std::max(max_node, node);
+  }
+  return syscall(SYS_mbind, data, bytes, mode, mask.data(), max_node + 2, kMpolMfMove) == 0;
+#else
+  return false;
+#endif
+}
+
+std::mutex placement_mutex;
+
+ppc::core::Placement &placement_storage() {
+  static ppc::core::Placement placement = ppc::core::Placement::from_env();
+  return placement;
+}
+
+}  // namespace
+
+ppc::core::Placement ppc::core::Placement::parse(const std::string &affinity, const std::string &memory) {
+  Placement placement;
+  if (affinity.empty() || affinity == "none") {
+    placement.affinity = AffinityPolicy::NONE;
+  } else if (affinity == "compact") {
+    placement.affinity = AffinityPolicy::COMPACT;
+  } else if (affinity == "scatter") {
+    placement.affinity = AffinityPolicy::SCATTER;
+  } else {
+    placement.affinity = AffinityPolicy::EXPLICIT;
+    placement.cpus = parse_cpu_list(affinity);
+  }
+  if (memory.empty() || memory == "default") {
+    placement.memory = MemoryPolicy::DEFAULT;
+  } else if (memory == "first_touch") {
+    placement.memory = MemoryPolicy::FIRST_TOUCH;
+  } else if (memory == "interleave") {
+    placement.memory = MemoryPolicy::INTERLEAVE;
+  } else {
+    throw std::invalid_argument("Unknown memory policy '" + memory + "'");
+  }
+  return placement;
+}
+
+ppc::core::Placement ppc::core::Placement::from_env() {
+  return parse(get_env("PPC_AFFINITY"), get_env("PPC_MEMORY_POLICY"));
+}
+
+std::string ppc::core::Placement::describe() const {
+  std::string result;
+  switch (affinity) {
+    case AffinityPolicy::NONE:
+      result = "none";
+      break;
+    case AffinityPolicy::COMPACT:
+      result = "compact";
+      break;
+    case AffinityPolicy::SCATTER:
+      result = "scatter";
+      break;
+    case AffinityPolicy::EXPLICIT:
+      for (size_t i = 0; i < cpus.size(); i++) {
+        if (i > 0) result += ' ';
+        result += std::to_string(cpus[i]);
+      }
+      break;
+  }
+  switch (memory) {
+    case MemoryPolicy::DEFAULT:
+      return result + "/default";
+    case MemoryPolicy::FIRST_TOUCH:
+      return result + "/first_touch";
+    case MemoryPolicy::INTERLEAVE:
+      return result + "/interleave";
+  }
+  return result;
+}
+
+int ppc::core::Placement::cpu_for_worker(int index) const {
+  if (index < 0) throw std::invalid_argument("Negative worker index");
+  switch (affinity) {
+    case AffinityPolicy::NONE:
+      return -1;
+    case AffinityPolicy::EXPLICIT:
+      if (cpus.empty()) return -1;
+      return cpus[index % cpus.size()];
+    case AffinityPolicy::COMPACT:
+    case AffinityPolicy::SCATTER: {
+      auto order = worker_order(affinity);
+      return order[index % order.size()];
+    }
+  }
+  return -1;
+}
+
+const std::vector<ppc::core::CpuInfo> &ppc::core::cpu_topology() {
+  static const std::vector<CpuInfo> topology = read_topology();
+  return topology;
+}
+
+int ppc::core::numa_nodes_count() {
+  const auto &cpus = cpu_topology();
+  auto max_node = std::max_element(cpus.begin(), cpus.end(), [](const auto &a, const auto &b) {
+    return a.node < b.node;
+  })->node;
+  return max_node + 1;
+}
+
+ppc::core::Placement ppc::core::current_placement() {
+  std::lock_guard lock(placement_mutex);
+  return placement_storage();
+}
+
+void ppc::core::set_current_placement(const Placement &placement) {
+  std::lock_guard lock(placement_mutex);
+  placement_storage() = placement;
+}
+
+bool ppc::core::pin_current_thread([[maybe_unused]] int cpu) {
+#ifdef __linux__
+  if (cpu < 0 || cpu >= CPU_SETSIZE) return false;
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  CPU_SET(cpu, &mask);
+  return pthread_setaffinity_np(pthread_self(), sizeof(mask), &mask) == 0;
+#else
+  return false;
+#endif
+}
+
+void ppc::core::pin_worker(int index) {
+  auto cpu = current_placement().cpu_for_worker(index);
+  if (cpu >= 0) pin_current_thread(cpu);
+}
+
+ppc::core::PlacementScope::PlacementScope(const Placement &placement) : previous(current_placement()) {
+#ifdef __linux__
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  if (pthread_getaffinity_np(pthread_self(), sizeof(mask), &mask) == 0) {
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+      if (CPU_ISSET(cpu, &mask)) previous_cpus.push_back(cpu);
+    }
+  }
+#endif
+  set_current_placement(placement);
+  pin_worker(0);
+}
+
+ppc::core::PlacementScope::~PlacementScope() {
+  set_current_placement(previous);
+#ifdef __linux__
+  if (previous_cpus.empty()) return;
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  for (int cpu : previous_cpus) CPU_SET(cpu, &mask);
+  pthread_setaffinity_np(pthread_self(), sizeof(mask), &mask);
+#endif
+}
+
+bool ppc::core::place_memory(void *data, size_t bytes, int num_workers, const Placement &placement) {
+  if (placement.memory == MemoryPolicy::DEFAULT || data == nullptr || bytes == 0) return true;
+  if (num_workers < 1) throw std::invalid_argument("Number of workers must be positive");
+  if (numa_nodes_count() == 1) return true;
+#ifdef __linux__
+  const auto page = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+  auto page_begin = [page](uintptr_t addr) { return addr / page * page; };
+  auto begin = reinterpret_cast<uintptr_t>(data);
+  auto end = begin + bytes;
+  if (placement.memory == MemoryPolicy::INTERLEAVE) {
+    std::vector<int> nodes(numa_nodes_count());
+    for (size_t i = 0; i < nodes.size(); i++) nodes[i] = static_cast<int>(i);
+    auto first = page_begin(begin);
+    return bind_range(reinterpret_cast<void *>(first), end - first, kMpolInterleave, nodes);
+  }
+  bool placed = true;
+  auto chunk = (bytes + num_workers - 1) / num_workers;
+  for (int worker = 0; worker < num_workers; worker++) {
+    auto first = page_begin(begin + std::min(bytes, chunk * worker));
+    auto last = std::min(end, begin + chunk * (worker + 1));
+    if (last <= first) continue;
+    auto cpu = placement.cpu_for_worker(worker);
+    auto node = cpu >= 0 ? node_of_cpu(cpu) : worker % numa_nodes_count();
+    placed = bind_range(reinterpret_cast<void *>(first), last - first, kMpolPreferred, {node}) && placed;
+  }
+  return placed;
+#else
+  return false;
+#endif
+}
+
+void ppc::core::placed_copy(void *dst, const void *src, size_t bytes, int num_workers) {
+  auto placement = current_placement();
+  if (num_workers <= 1 || bytes == 0 ||
+      (placement.affinity == AffinityPolicy::NONE && placement.memory == MemoryPolicy::DEFAULT)) {
+    if (bytes != 0) std::memcpy(dst, src, bytes);
+    return;
+  }
+  place_memory(dst, bytes, num_workers, placement);
+  auto chunk = (bytes + num_workers - 1) / num_workers;
+  std::vector<std::thread> threads;
+  for (int worker = 0; worker < num_workers; worker++) {
+    auto first = std::min(bytes, chunk * worker);
+    auto last = std::min(bytes, chunk * (worker + 1));
+    threads.emplace_back([&, worker, first, last] {
+      pin_worker(worker);
+      std::memcpy(static_cast<char *>(dst) + first, static_cast<const char *>(src) + first, last - first);
+    });
+  }
+  for (auto &thread : threads) thread.join();
+}
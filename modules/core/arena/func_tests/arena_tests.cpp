@@ -0,0 +1,56 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <utility>
+
+#include "core/arena/include/arena.hpp"
+
+TEST(arena_tests, check_alignment) {
+  ppc::core::BufferArena arena;
+  auto a = arena.get<double>("a", 13);
+  auto b = arena.get<uint8_t>("b", 7);
+  ASSERT_EQ(a.size(), 13U);
+  ASSERT_EQ(b.size(), 7U);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(a.data()) % ppc::core::BufferArena::ALIGNMENT, 0U);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(b.data()) % ppc::core::BufferArena::ALIGNMENT, 0U);
+  EXPECT_NE(static_cast<void *>(a.data()), static_cast<void *>(b.data()));
+}
+
+TEST(arena_tests, check_reuse) {
+  ppc::core::BufferArena arena;
+  auto first = arena.get<int>("tmp", 100);
+  first[99] = 42;
+  auto second = arena.get<int>("tmp", 50);
+  EXPECT_EQ(first.data(), second.data());
+  auto third = arena.get<int>("tmp", 100);
+  EXPECT_EQ(first.data(), third.data());
+  EXPECT_EQ(third[99], 42);
+  EXPECT_EQ(arena.allocations_count(), 1U);
+
+  arena.get<int>("tmp", 1000);
+  EXPECT_EQ(arena.allocations_count(), 2U);
+  EXPECT_GE(arena.allocated_bytes(), 1000 * sizeof(int));
+}
+
+TEST(arena_tests, check_release_and_move) {
+  ppc::core::BufferArena arena;
+  arena.get<float>("a", 10);
+  arena.get<float>("b", 10);
+  arena.release("a");
+  EXPECT_EQ(arena.allocated_bytes(), ppc::core::BufferArena::ALIGNMENT);
+
+  ppc::core::BufferArena moved(std::move(arena));
+  EXPECT_EQ(moved.allocated_bytes(), ppc::core::BufferArena::ALIGNMENT);
+  moved.clear();
+  EXPECT_EQ(moved.allocated_bytes(), 0U);
+}
+
+TEST(arena_tests, check_huge_pages) {
+  ppc::core::BufferArena arena;
+  arena.set_huge_pages(true);
+  auto buf = arena.get<double>("big", ppc::core::BufferArena::HUGE_PAGE_SIZE / sizeof(double) + 1);
+  buf[buf.size() - 1] = 1.0;
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(buf.data()) % ppc::core::BufferArena::ALIGNMENT, 0U);
+  EXPECT_GE(arena.allocated_bytes(), buf.size_bytes());
+}
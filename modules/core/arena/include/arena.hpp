@@ -0,0 +1,67 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_ARENA_HPP_
+#define MODULES_CORE_INCLUDE_ARENA_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+
+namespace ppc::core {
+
+// Named aligned buffers owned by task. Storage of a buffer is kept between calls
+// (e.g. between repeated pipeline runs in Perf) and is reallocated only when a
+// bigger size is requested, so measured code doesn't pay for malloc and page faults.
+class BufferArena {
+ public:
+  static constexpr size_t ALIGNMENT = 64;
+  static constexpr size_t HUGE_PAGE_SIZE = size_t{2} << 20;
+
+  BufferArena() = default;
+  BufferArena(const BufferArena &) = delete;
+  BufferArena &operator=(const BufferArena &) = delete;
+  BufferArena(BufferArena &&other) noexcept;
+  BufferArena &operator=(BufferArena &&other) noexcept;
+  ~BufferArena();
+
+  // Back buffers of at least HUGE_PAGE_SIZE bytes by transparent huge pages (Linux only)
+  void set_huge_pages(bool use_huge_pages_) { use_huge_pages = use_huge_pages_; }
+
+  // Buffer of count elements named name, its content is kept only while it doesn't grow
+  template <class T>
+  std::span<T> get(const std::string &name, size_t count) {
+    static_assert(std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>,
+                  "BufferArena holds only trivially copyable types");
+    static_assert(alignof(T) <= ALIGNMENT, "BufferArena alignment is not enough for type");
+    return {static_cast<T *>(acquire(name, count * sizeof(T))), count};
+  }
+
+  // Free buffer named name
+  void release(const std::string &name);
+  // Free all buffers
+  void clear();
+
+  [[nodiscard]] size_t allocated_bytes() const;
+  [[nodiscard]] uint64_t allocations_count() const { return num_allocations; }
+
+ private:
+  struct Block {
+    void *ptr = nullptr;
+    size_t capacity = 0;
+    bool huge = false;
+  };
+
+  void *acquire(const std::string &name, size_t bytes);
+  static void free_block(Block &block);
+
+  std::unordered_map<std::string, Block> blocks;
+  bool use_huge_pages = false;
+  uint64_t num_allocations = 0;
+};
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_ARENA_HPP_
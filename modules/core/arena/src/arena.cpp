@@ -0,0 +1,107 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/arena/include/arena.hpp"
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+#include <utility>
+
+#include "core/perf/include/mem_tracker.hpp"
+
+namespace {
+
+size_t round_up(size_t value, size_t multiple) { return (value + multiple - 1) / multiple * multiple; }
+
+}  // namespace
+
+ppc::core::BufferArena::BufferArena(BufferArena &&other) noexcept
+    : blocks(std::move(other.blocks)), use_huge_pages(other.use_huge_pages), num_allocations(other.num_allocations) {
+  other.blocks.clear();
+}
+
+ppc::core::BufferArena &ppc::core::BufferArena::operator=(BufferArena &&other) noexcept {
+  if (this != &other) {
+    clear();
+    blocks = std::move(other.blocks);
+    other.blocks.clear();
+    use_huge_pages = other.use_huge_pages;
+    num_allocations = other.num_allocations;
+  }
+  return *this;
+}
+
+ppc::core::BufferArena::~BufferArena() { clear(); }
+
+void *ppc::core::BufferArena::acquire(const std::string &name, size_t bytes) {
+  auto &block = blocks[name];
+  if (bytes <= block.capacity && block.ptr != nullptr) return block.ptr;
+
+  free_block(block);
+  auto capacity = round_up(std::max<size_t>(bytes, 1), ALIGNMENT);
+#ifdef __linux__
+  if (use_huge_pages && capacity >= HUGE_PAGE_SIZE) {
+    capacity = round_up(capacity, HUGE_PAGE_SIZE);
+    void *ptr = mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (ptr == MAP_FAILED) throw std::bad_alloc();
+    madvise(ptr, capacity, MADV_HUGEPAGE);
+    block = {ptr, capacity, true};
+    num_allocations++;
+    MemoryTracker::on_buffer_allocate(capacity);
+    return ptr;
+  }
+#endif
+#ifdef _MSC_VER
+  void *ptr = _aligned_malloc(capacity, ALIGNMENT);
+#else
+  void *ptr = std::aligned_alloc(ALIGNMENT, capacity);
+#endif
+  if (ptr == nullptr) throw std::bad_alloc();
+  block = {ptr, capacity, false};
+  num_allocations++;
+  MemoryTracker::on_buffer_allocate(capacity);
+  return ptr;
+}
+
+void ppc::core::BufferArena::free_block(Block &block) {
+  if (block.ptr == nullptr) return;
+  MemoryTracker::on_buffer_free(block.capacity);
+#ifdef __linux__
+  if (block.huge) {
+    munmap(block.ptr, block.capacity);
+    block = {};
+    return;
+  }
+#endif
+#ifdef _MSC_VER
+  _aligned_free(block.ptr);
+#else
+  std::free(block.ptr);
+#endif
+  block = {};
+}
+
+void ppc::core::BufferArena::release(const std::string &name) {
+  auto it = blocks.find(name);
+  if (it == blocks.end()) return;
+  free_block(it->second);
+  blocks.erase(it);
+}
+
+void ppc::core::BufferArena::clear() {
+  for (auto &[name, block] : blocks) {
+    free_block(block);
+  }
+  blocks.clear();
+}
+
+size_t ppc::core::BufferArena::allocated_bytes() const {
+  size_t bytes = 0;
+  for (const auto &[name, block] : blocks) {
+    bytes += block.capacity;
+  }
+  return bytes;
+}
@@ -0,0 +1,111 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_TESTS_BACKEND_KERNELS_PERF_TESTS_HPP_
+#define MODULES_CORE_TESTS_BACKEND_KERNELS_PERF_TESTS_HPP_
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "core/backend/include/kernel_tasks.hpp"
+#include "core/dataset/include/dataset.hpp"
+#include "core/gen/include/generators.hpp"
+#include "core/perf/include/perf.hpp"
+
+// Performance tests of dot task shared by backends, every backend instantiates them with its default
+// constructed executor:
+//   INSTANTIATE_TYPED_TEST_SUITE_P(openmp, BackendKernelsPerfTest, ppc::core::OmpExecutor);
+// MPI backend loads datasets and times runs collectively, so it calls run_dot_perf itself.
+
+namespace ppc::test {
+
+// Inputs of dot are generated once into dataset cache and mapped by later runs
+constexpr uint64_t DOT_PERF_COUNT = 10000000;
+
+inline std::string dot_perf_generator() { return ppc::core::generator_key("uniform_vector", -100, 100); }
+
+inline std::function<void(std::span<int64_t>)> dot_perf_fill(uint64_t seed) {
+  return [seed](std::span<int64_t> out) { ppc::core::fill_uniform<int64_t>(out, -100, 100, seed); };
+}
+
+// Perf attributes timed by steady clock of process
+inline std::shared_ptr<ppc::core::PerfAttr> local_perf_attr() {
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 10;
+  const auto t0 = std::chrono::high_resolution_clock::now();
+  perfAttr->current_timer = [t0] {
+    auto current_time_point = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(current_time_point - t0).count();
+    return static_cast<double>(duration) * 1e-9;
+  };
+  return perfAttr;
+}
+
+// Measures dot of a and b by DotTask of Exec with pipeline_run or task_run, statistics are printed and
+// result is checked if report is set
+template <typename Exec>
+void run_dot_perf(const ppc::core::MappedDataset &a, const ppc::core::MappedDataset &b,
+                  const std::shared_ptr<ppc::core::PerfAttr> &perfAttr, bool task_run, bool report = true) {
+  auto a_values = a.as<int64_t>();
+  auto b_values = b.as<int64_t>();
+  const auto expected = std::inner_product(a_values.begin(), a_values.end(), b_values.begin(), int64_t{0});
+  std::vector<int64_t> out(1, 0);
+
+  // Create TaskData
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  ppc::core::attach_input(*taskData, a);
+  ppc::core::attach_input(*taskData, b);
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  auto task = std::make_shared<ppc::core::DotTask<Exec, int64_t>>(taskData);
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  auto perfAnalyzer = std::make_shared<ppc::core::Perf>(task);
+  if (task_run) {
+    perfAnalyzer->task_run(perfAttr, perfResults);
+  } else {
+    perfAnalyzer->pipeline_run(perfAttr, perfResults);
+  }
+  if (report) {
+    ppc::core::Perf::print_perf_statistic(perfResults);
+    ASSERT_EQ(expected, out[0]);
+  }
+}
+
+}  // namespace ppc::test
+
+template <typename Exec>
+class BackendKernelsPerfTest : public ::testing::Test {
+ protected:
+  ppc::core::DatasetCache cache;
+  ppc::core::MappedDataset a =
+      cache.get<int64_t>(ppc::test::dot_perf_generator(), 1, {ppc::test::DOT_PERF_COUNT}, ppc::test::dot_perf_fill(1));
+  ppc::core::MappedDataset b =
+      cache.get<int64_t>(ppc::test::dot_perf_generator(), 2, {ppc::test::DOT_PERF_COUNT}, ppc::test::dot_perf_fill(2));
+};
+
+TYPED_TEST_SUITE_P(BackendKernelsPerfTest);
+
+TYPED_TEST_P(BackendKernelsPerfTest, test_pipeline_run) {
+  ppc::test::run_dot_perf<TypeParam>(this->a, this->b, ppc::test::local_perf_attr(), false);
+}
+
+TYPED_TEST_P(BackendKernelsPerfTest, test_task_run) {
+  ppc::test::run_dot_perf<TypeParam>(this->a, this->b, ppc::test::local_perf_attr(), true);
+}
+
+REGISTER_TYPED_TEST_SUITE_P(BackendKernelsPerfTest, test_pipeline_run, test_task_run);
+
+#endif  // MODULES_CORE_TESTS_BACKEND_KERNELS_PERF_TESTS_HPP_
@@ -0,0 +1,92 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_TESTS_BACKEND_KERNELS_TESTS_HPP_
+#define MODULES_CORE_TESTS_BACKEND_KERNELS_TESTS_HPP_
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+#include "core/backend/func_tests/check_executor.hpp"
+#include "core/backend/include/kernel_tasks.hpp"
+
+// Functional tests of kernels and kernel tasks shared by backends, every backend instantiates them with its
+// default constructed executor:
+//   INSTANTIATE_TYPED_TEST_SUITE_P(openmp, BackendKernelsTest, ppc::core::OmpExecutor);
+
+namespace ppc::test {
+
+// Executor of rank of communicator, its parallel_for runs own block of rank only
+template <typename Exec>
+concept DistributedExecutor = requires(const Exec &exec) { exec.communicator(); };
+
+}  // namespace ppc::test
+
+template <typename Exec>
+class BackendKernelsTest : public ::testing::Test {};
+
+TYPED_TEST_SUITE_P(BackendKernelsTest);
+
+TYPED_TEST_P(BackendKernelsTest, check_primitives) {
+  ppc::test::check_primitives(TypeParam(), ppc::test::DistributedExecutor<TypeParam>);
+  ppc::test::check_kernels(TypeParam());
+}
+
+TYPED_TEST_P(BackendKernelsTest, check_dot_task) {
+  std::vector<int64_t> a(1001);
+  std::vector<int64_t> b(1001);
+  for (size_t i = 0; i < a.size(); i++) {
+    a[i] = static_cast<int64_t>(i % 11) - 5;
+    b[i] = static_cast<int64_t>(i % 3);
+  }
+  std::vector<int64_t> out(1, 0);
+
+  // Create TaskData
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(a.data()));
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(b.data()));
+  taskData->inputs_count = {static_cast<uint32_t>(a.size()), static_cast<uint32_t>(b.size())};
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  ppc::core::DotTask<TypeParam, int64_t> task(taskData);
+  ASSERT_TRUE(task.validation());
+  task.pre_processing();
+  task.run();
+  task.post_processing();
+  EXPECT_EQ(out[0], std::inner_product(a.begin(), a.end(), b.begin(), int64_t{0}));
+}
+
+TYPED_TEST_P(BackendKernelsTest, check_column_max_task) {
+  const size_t rows = 37;
+  const size_t cols = 13;
+  std::vector<int32_t> matrix(rows * cols);
+  for (size_t i = 0; i < matrix.size(); i++) matrix[i] = static_cast<int32_t>((i * 7919) % 101) - 50;
+  std::vector<int32_t> out(cols, 0);
+
+  // Create TaskData
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(matrix.data()));
+  taskData->inputs_count.emplace_back(matrix.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  ppc::core::ColumnMaxTask<TypeParam, int32_t> task(taskData);
+  ASSERT_TRUE(task.validation());
+  task.pre_processing();
+  task.run();
+  task.post_processing();
+  for (size_t col = 0; col < cols; col++) {
+    int32_t expected = matrix[col];
+    for (size_t row = 1; row < rows; row++) expected = std::max(expected, matrix[row * cols + col]);
+    EXPECT_EQ(out[col], expected);
+  }
+}
+
+REGISTER_TYPED_TEST_SUITE_P(BackendKernelsTest, check_primitives, check_dot_task, check_column_max_task);
+
+#endif  // MODULES_CORE_TESTS_BACKEND_KERNELS_TESTS_HPP_
@@ -0,0 +1,59 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+
+#include "core/backend/func_tests/check_executor.hpp"
+#include "core/backend/include/backend.hpp"
+#ifdef _OPENMP
+#include "core/backend/include/backend_omp.hpp"
+#endif
+
+TEST(backend_tests, check_block_range) {
+  EXPECT_EQ(ppc::core::block_range(0, 10, 3, 0), std::make_pair(size_t{0}, size_t{3}));
+  EXPECT_EQ(ppc::core::block_range(0, 10, 3, 1), std::make_pair(size_t{3}, size_t{6}));
+  EXPECT_EQ(ppc::core::block_range(0, 10, 3, 2), std::make_pair(size_t{6}, size_t{10}));
+  EXPECT_EQ(ppc::core::block_range(5, 7, 4, 0), std::make_pair(size_t{5}, size_t{5}));
+}
+
+TEST(backend_tests, check_seq_executor) {
+  ppc::test::check_primitives(ppc::core::SeqExecutor());
+  ppc::test::check_kernels(ppc::core::SeqExecutor());
+}
+
+TEST(backend_tests, check_stl_executor) {
+  for (int num_threads : {1, 3, 8}) {
+    ppc::test::check_primitives(ppc::core::StlExecutor(num_threads));
+    ppc::test::check_kernels(ppc::core::StlExecutor(num_threads));
+  }
+}
+
+TEST(backend_tests, check_pool_executor) {
+  for (int num_threads : {1, 3, 8}) {
+    ppc::core::PoolExecutor pool(num_threads);
+    ppc::test::check_primitives(pool);
+    ppc::test::check_kernels(pool);
+  }
+}
+
+TEST(backend_tests, check_thread_pool_rethrows_exception_of_block) {
+  ppc::core::ThreadPool pool(4);
+  auto failing = [](size_t part) {
+    if (part == 2) throw std::runtime_error("block failed");
+  };
+  EXPECT_THROW(pool.run(4, failing), std::runtime_error);
+  EXPECT_THROW(pool.run(5, failing), std::invalid_argument);
+  std::atomic<size_t> sum = 0;
+  pool.run(3, [&](size_t part) { sum += part; });
+  EXPECT_EQ(sum, 3U);
+}
+
+#ifdef _OPENMP
+TEST(backend_tests, check_omp_executor) {
+  ppc::test::check_primitives(ppc::core::OmpExecutor());
+  ppc::test::check_kernels(ppc::core::OmpExecutor());
+}
+#endif
@@ -0,0 +1,74 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_TESTS_CHECK_EXECUTOR_HPP_
+#define MODULES_CORE_TESTS_CHECK_EXECUTOR_HPP_
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <vector>
+
+#include "core/backend/include/kernels.hpp"
+
+namespace ppc::test {
+
+
+// parallel_for of MPI executor runs own block of rank only, it is checked by caller with local_for
+template <typename Exec>
+void check_primitives(const Exec &exec, bool local_for = false) {
+  const size_t n = 1237;
+  std::vector<int64_t> in(n);
+  for (size_t i = 0; i < n; i++) in[i] = static_cast<int64_t>((i * 7919) % 1000) - 500;
+
+  if (!local_for) {
+    std::vector<int> touched(n, 0);
+    exec.parallel_for(size_t{0}, n, [&](size_t i) { touched[i]++; });
+    EXPECT_TRUE(std::all_of(touched.begin(), touched.end(), [](int count) { return count == 1; }));
+  }
+
+  std::vector<int64_t> squares(n - 10);
+  exec.parallel_transform(size_t{10}, n, squares.begin(), [&](size_t i) { return in[i] * in[i]; });
+  EXPECT_EQ(squares.front(), in[10] * in[10]);
+  EXPECT_EQ(squares.back(), in[n - 1] * in[n - 1]);
+
+  auto sum = exec.parallel_reduce(size_t{0}, n, int64_t{0}, [&](size_t i) { return in[i]; }, std::plus<>());
+  EXPECT_EQ(sum, std::accumulate(in.begin(), in.end(), int64_t{0}));
+  auto max = exec.parallel_reduce(size_t{0}, n, INT64_MIN, [&](size_t i) { return in[i]; },
+                                  [](int64_t a, int64_t b) { return std::max(a, b); });
+  EXPECT_EQ(max, *std::max_element(in.begin(), in.end()));
+  auto empty = exec.parallel_reduce(size_t{5}, size_t{5}, int64_t{1}, [&](size_t i) { return in[i]; },
+                                    std::multiplies<>());
+  EXPECT_EQ(empty, 1);
+
+  std::vector<int64_t> scan(n);
+  std::vector<int64_t> expected_scan(n);
+  exec.inclusive_scan(in.begin(), in.end(), scan.begin(), int64_t{0}, std::plus<>());
+  std::inclusive_scan(in.begin(), in.end(), expected_scan.begin());
+  EXPECT_EQ(scan, expected_scan);
+
+  auto sorted = in;
+  exec.sort(sorted.begin(), sorted.end(), std::greater<>());
+  auto expected_sorted = in;
+  std::sort(expected_sorted.begin(), expected_sorted.end(), std::greater<>());
+  EXPECT_EQ(sorted, expected_sorted);
+}
+
+template <typename Exec>
+void check_kernels(const Exec &exec) {
+  std::vector<double> a = {1.0, 2.0, 3.0, 4.0};
+  std::vector<double> b = {0.5, 0.5, 2.0, -1.0};
+  EXPECT_DOUBLE_EQ(ppc::core::kernels::dot(exec, a.data(), b.data(), a.size()), 3.5);
+
+  // 3 x 4 matrix
+  std::vector<int> matrix = {1, -5, 7, 0, 9, -2, 3, 0, 4, -8, 8, 0};
+  std::vector<int> result(4);
+  ppc::core::kernels::column_max(exec, matrix.data(), 3, 4, result.data());
+  EXPECT_EQ(result, std::vector<int>({9, -2, 8, 0}));
+}
+
+}  // namespace ppc::test
+
+#endif  // MODULES_CORE_TESTS_CHECK_EXECUTOR_HPP_
@@ -0,0 +1,227 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_BACKEND_HPP_
+#define MODULES_CORE_INCLUDE_BACKEND_HPP_
+
+#include <algorithm>
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "core/affinity/include/affinity.hpp"
+
+namespace ppc::core {
+
+// Execution backends share one interface, so kernel written once as template over executor runs on every backend:
+//   parallel_for(begin, end, f)                       - f(i) for every index of [begin, end)
+//   parallel_transform(begin, end, out, f)            - out[i - begin] = f(i)
+//   parallel_reduce(begin, end, identity, map, op)    - op-fold of map(i), op is associative with neutral identity
+//   inclusive_scan(first, last, d_first, identity, op) - prefix op-folds of [first, last)
+//   sort(first, last, comp)
+// Executors are chosen at compile time, see backend_omp.hpp, backend_tbb.hpp and backend_mpi.hpp
+template <typename E>
+concept Executor = requires(const E &exec) {
+  { E::name } -> std::convertible_to<const char *>;
+  { exec.concurrency() } -> std::convertible_to<int>;
+};
+
+// Threads count from PPC_NUM_THREADS or OMP_NUM_THREADS, fallback (hardware concurrency if 0) by default
+int default_num_threads(int fallback = 0);
+
+// [first, last) of part-th of parts nearly equal blocks of [begin, end)
+inline std::pair<size_t, size_t> block_range(size_t begin, size_t end, size_t parts, size_t part) {
+  auto n = end - begin;
+  return {begin + n * part / parts, begin + n * (part + 1) / parts};
+}
+
+class SeqExecutor {
+ public:
+  static constexpr const char *name = "seq";
+  [[nodiscard]] int concurrency() const { return 1; }
+
+  template <typename F>
+  void parallel_for(size_t begin, size_t end, F &&f) const {
+    for (auto i = begin; i < end; i++) f(i);
+  }
+  template <typename Out, typename F>
+  void parallel_transform(size_t begin, size_t end, Out out, F &&f) const {
+    for (auto i = begin; i < end; i++) out[i - begin] = f(i);
+  }
+  template <typename T, typename Map, typename Op>
+  T parallel_reduce(size_t begin, size_t end, T identity, Map &&map, Op &&op) const {
+    for (auto i = begin; i < end; i++) identity = op(identity, map(i));
+    return identity;
+  }
+  template <typename In, typename Out, typename T, typename Op>
+  void inclusive_scan(In first, In last, Out d_first, T identity, Op &&op) const {
+    for (; first != last; ++first, ++d_first) *d_first = identity = op(identity, *first);
+  }
+  template <typename It, typename Compare = std::less<>>
+  void sort(It first, It last, Compare comp = {}) const {
+    std::sort(first, last, comp);
+  }
+};
+
+// Primitives over nearly equal blocks, Derived runs for_blocks(parts, f) calling f(part) for every block in parallel
+template <typename Derived>
+class BlockExecutor {
+ public:
+  template <typename F>
+  void parallel_for(size_t begin, size_t end, F &&f) const {
+    auto parts = parts_of(end - begin);
+    self().for_blocks(parts, [&](size_t part) {
+      auto [lo, hi] = block_range(begin, end, parts, part);
+      for (auto i = lo; i < hi; i++) f(i);
+    });
+  }
+  template <typename Out, typename F>
+  void parallel_transform(size_t begin, size_t end, Out out, F &&f) const {
+    parallel_for(begin, end, [&](size_t i) { out[i - begin] = f(i); });
+  }
+  template <typename T, typename Map, typename Op>
+  T parallel_reduce(size_t begin, size_t end, T identity, Map &&map, Op &&op) const {
+    auto parts = parts_of(end - begin);
+    std::vector<Slot<T>> partial(parts, {identity});
+    self().for_blocks(parts, [&](size_t part) {
+      auto [lo, hi] = block_range(begin, end, parts, part);
+      auto acc = identity;
+      for (auto i = lo; i < hi; i++) acc = op(acc, map(i));
+      partial[part].value = acc;
+    });
+    for (const auto &slot : partial) identity = op(identity, slot.value);
+    return identity;
+  }
+  // Two passes: totals of blocks, then scan of every block from prefix of totals of previous blocks
+  template <typename In, typename Out, typename T, typename Op>
+  void inclusive_scan(In first, In last, Out d_first, T identity, Op &&op) const {
+    auto n = static_cast<size_t>(std::distance(first, last));
+    auto parts = parts_of(n);
+    std::vector<Slot<T>> offsets(parts, {identity});
+    self().for_blocks(parts, [&](size_t part) {
+      auto [lo, hi] = block_range(0, n, parts, part);
+      if (part + 1 == parts) return;
+      auto acc = identity;
+      for (auto i = lo; i < hi; i++) acc = op(acc, first[i]);
+      offsets[part + 1].value = acc;
+    });
+    for (size_t part = 1; part < parts; part++) offsets[part].value = op(offsets[part - 1].value, offsets[part].value);
+    self().for_blocks(parts, [&](size_t part) {
+      auto [lo, hi] = block_range(0, n, parts, part);
+      auto acc = offsets[part].value;
+      for (auto i = lo; i < hi; i++) d_first[i] = acc = op(acc, first[i]);
+    });
+  }
+  // Blocks are sorted in parallel, then merged pairwise in log(parts) rounds
+  template <typename It, typename Compare = std::less<>>
+  void sort(It first, It last, Compare comp = {}) const {
+    auto n = static_cast<size_t>(std::distance(first, last));
+    auto parts = parts_of(n);
+    auto bound = [&](size_t part) { return first + block_range(0, n, parts, std::min(part, parts)).first; };
+    self().for_blocks(parts, [&](size_t part) { std::sort(bound(part), bound(part + 1), comp); });
+    for (size_t width = 1; width < parts; width *= 2) {
+      auto pairs = (parts + 2 * width - 1) / (2 * width);
+      self().for_blocks(pairs, [&](size_t pair) {
+        auto lo = pair * 2 * width;
+        std::inplace_merge(bound(lo), bound(lo + width), bound(lo + 2 * width), comp);
+      });
+    }
+  }
+
+ private:
+  // wrapper keeps partial results of vector<bool> in separate bytes
+  template <typename T>
+  struct Slot {
+    T value;
+  };
+
+  const Derived &self() const { return static_cast<const Derived &>(*this); }
+  [[nodiscard]] size_t parts_of(size_t n) const {
+    return std::max<size_t>(std::min<size_t>(n, self().concurrency()), 1);
+  }
+};
+
+// std::thread per block, block 0 runs on calling thread, workers are pinned by current placement
+class StlExecutor : public BlockExecutor<StlExecutor> {
+ public:
+  static constexpr const char *name = "stl";
+  explicit StlExecutor(int num_threads = 0) : num_threads(num_threads > 0 ? num_threads : default_num_threads()) {}
+  [[nodiscard]] int concurrency() const { return num_threads; }
+
+  template <typename F>
+  void for_blocks(size_t parts, F &&f) const {
+    std::vector<std::thread> threads;
+    threads.reserve(parts);
+    for (size_t part = 1; part < parts; part++) {
+      threads.emplace_back([&f, part] {
+        pin_worker(static_cast<int>(part));
+        f(part);
+      });
+    }
+    if (parts > 0) f(0);
+    for (auto &thread : threads) thread.join();
+  }
+
+ private:
+  int num_threads;
+};
+
+// size() - 1 persistent workers, started once and pinned as workers 1, 2, ... of placement current at start,
+// so repeated parallel regions (e.g. every iteration of solver) don't create threads
+class ThreadPool {
+ public:
+  explicit ThreadPool(int num_threads);
+  ~ThreadPool();
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  [[nodiscard]] int size() const { return static_cast<int>(workers.size()) + 1; }
+  // f(part) for every part of [0, parts) in parallel, part 0 on calling thread, parts is at most size().
+  // Calls from different threads are serialized, first exception of blocks is rethrown
+  void run(size_t parts, const std::function<void(size_t)> &f);
+
+ private:
+  void work(size_t part);
+
+  std::vector<std::thread> workers;
+  std::mutex run_mutex;
+  std::mutex mutex;
+  std::condition_variable wake;
+  std::condition_variable done;
+  const std::function<void(size_t)> *job = nullptr;
+  size_t job_parts = 0;
+  uint64_t generation = 0;
+  size_t pending = 0;
+  bool stopping = false;
+  std::exception_ptr error;
+};
+
+// Block per worker of persistent ThreadPool, shared by copies of executor
+class PoolExecutor : public BlockExecutor<PoolExecutor> {
+ public:
+  static constexpr const char *name = "pool";
+  explicit PoolExecutor(int num_threads = 0)
+      : pool(std::make_shared<ThreadPool>(num_threads > 0 ? num_threads : default_num_threads())) {}
+  [[nodiscard]] int concurrency() const { return pool->size(); }
+
+  template <typename F>
+  void for_blocks(size_t parts, F &&f) const {
+    pool->run(parts, f);
+  }
+
+ private:
+  std::shared_ptr<ThreadPool> pool;
+};
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_BACKEND_HPP_
@@ -0,0 +1,107 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_BACKEND_MPI_HPP_
+#define MODULES_CORE_INCLUDE_BACKEND_MPI_HPP_
+
+#include <boost/mpi/collectives.hpp>
+#include <boost/mpi/collectives/all_gatherv.hpp>
+#include <boost/mpi/communicator.hpp>
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "core/backend/include/backend.hpp"
+
+namespace ppc::core {
+
+// Ranks of communicator take nearly equal blocks of index range, block of rank is processed by Local executor.
+// Inputs have to be present on every rank, results of parallel_transform, parallel_reduce, inclusive_scan and
+// sort are replicated on every rank, parallel_for runs own block of rank only (its writes stay local).
+// Outputs of scan and sort have to be contiguous and their elements transferable by Boost.MPI.
+template <typename Local = SeqExecutor>
+class MpiExecutor {
+ public:
+  static constexpr const char *name = "mpi";
+  explicit MpiExecutor(boost::mpi::communicator world = {}, Local local = {})
+      : world(std::move(world)), local(std::move(local)) {}
+  [[nodiscard]] int concurrency() const { return world.size() * local.concurrency(); }
+  [[nodiscard]] const boost::mpi::communicator &communicator() const { return world; }
+
+  template <typename F>
+  void parallel_for(size_t begin, size_t end, F &&f) const {
+    auto [lo, hi] = own_block(begin, end);
+    local.parallel_for(lo, hi, f);
+  }
+  template <typename Out, typename F>
+  void parallel_transform(size_t begin, size_t end, Out out, F &&f) const {
+    using T = std::iter_value_t<Out>;
+    auto [lo, hi] = own_block(begin, end);
+    std::vector<T> block(hi - lo);
+    local.parallel_transform(lo, hi, block.begin(), f);
+    all_gather_blocks(block, std::to_address(out), end - begin);
+  }
+  template <typename T, typename Map, typename Op>
+  T parallel_reduce(size_t begin, size_t end, T identity, Map &&map, Op &&op) const {
+    auto [lo, hi] = own_block(begin, end);
+    auto partial = local.parallel_reduce(lo, hi, identity, map, op);
+    T result = identity;
+    boost::mpi::all_reduce(world, partial, result, op);
+    return result;
+  }
+  // Every rank scans own block, then adds prefix of totals of blocks of previous ranks
+  template <typename In, typename Out, typename T, typename Op>
+  void inclusive_scan(In first, In last, Out d_first, T identity, Op &&op) const {
+    auto n = static_cast<size_t>(std::distance(first, last));
+    auto [lo, hi] = own_block(0, n);
+    std::vector<T> block(hi - lo);
+    local.inclusive_scan(first + lo, first + hi, block.begin(), identity, op);
+    std::vector<T> totals;
+    boost::mpi::all_gather(world, block.empty() ? identity : block.back(), totals);
+    auto offset = identity;
+    for (int rank = 0; rank < world.rank(); rank++) offset = op(offset, totals[rank]);
+    local.parallel_for(0, block.size(), [&](size_t i) { block[i] = op(offset, block[i]); });
+    all_gather_blocks(block, std::to_address(d_first), n);
+  }
+  // Every rank sorts own block, sorted blocks are gathered on all ranks and merged pairwise
+  template <typename It, typename Compare = std::less<>>
+  void sort(It first, It last, Compare comp = {}) const {
+    auto n = static_cast<size_t>(std::distance(first, last));
+    auto [lo, hi] = own_block(0, n);
+    std::vector<std::iter_value_t<It>> block(first + lo, first + hi);
+    local.sort(block.begin(), block.end(), comp);
+    all_gather_blocks(block, std::to_address(first), n);
+    const auto parts = static_cast<size_t>(world.size());
+    auto bound = [&](size_t part) { return first + block_range(0, n, parts, std::min(part, parts)).first; };
+    for (size_t width = 1; width < parts; width *= 2) {
+      for (size_t part = 0; part < parts; part += 2 * width) {
+        std::inplace_merge(bound(part), bound(part + width), bound(part + 2 * width), comp);
+      }
+    }
+  }
+
+ private:
+  boost::mpi::communicator world;
+  Local local;
+
+  [[nodiscard]] std::pair<size_t, size_t> own_block(size_t begin, size_t end) const {
+    return block_range(begin, end, world.size(), world.rank());
+  }
+  template <typename T>
+  void all_gather_blocks(const std::vector<T> &block, T *out, size_t n) const {
+    std::vector<int> sizes(world.size());
+    for (int rank = 0; rank < world.size(); rank++) {
+      auto [lo, hi] = block_range(0, n, world.size(), rank);
+      sizes[rank] = static_cast<int>(hi - lo);
+    }
+    std::vector<T> gathered(n);
+    boost::mpi::all_gatherv(world, block.data(), gathered.data(), sizes);
+    std::copy(gathered.begin(), gathered.end(), out);
+  }
+};
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_BACKEND_MPI_HPP_
@@ -0,0 +1,29 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_BACKEND_OMP_HPP_
+#define MODULES_CORE_INCLUDE_BACKEND_OMP_HPP_
+
+#include <omp.h>
+
+#include "core/affinity/include/affinity_omp.hpp"
+#include "core/backend/include/backend.hpp"
+
+namespace ppc::core {
+
+// OpenMP thread of team per block, team is pinned by current placement once
+class OmpExecutor : public BlockExecutor<OmpExecutor> {
+ public:
+  static constexpr const char *name = "omp";
+  OmpExecutor() { pin_omp_threads(); }
+  [[nodiscard]] int concurrency() const { return omp_get_max_threads(); }
+
+  template <typename F>
+  void for_blocks(size_t parts, F &&f) const {
+#pragma omp parallel for schedule(static, 1) num_threads(static_cast<int>(parts))
+    for (int part = 0; part < static_cast<int>(parts); part++) f(static_cast<size_t>(part));
+  }
+};
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_BACKEND_OMP_HPP_
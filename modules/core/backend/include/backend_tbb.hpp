@@ -0,0 +1,78 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_BACKEND_TBB_HPP_
+#define MODULES_CORE_INCLUDE_BACKEND_TBB_HPP_
+
+#include <tbb/tbb.h>
+
+#include <functional>
+#include <iterator>
+#include <memory>
+
+#include "core/backend/include/backend.hpp"
+
+namespace ppc::core {
+
+// oneTBB algorithms with work stealing over automatically split ranges, run in own arena of num_threads
+// (default_num_threads() by default), so PPC_NUM_THREADS limits them like other backends
+class TbbExecutor {
+ public:
+  static constexpr const char *name = "tbb";
+  explicit TbbExecutor(int num_threads = 0)
+      : arena(std::make_shared<oneapi::tbb::task_arena>(num_threads > 0 ? num_threads : default_num_threads())) {}
+  [[nodiscard]] int concurrency() const { return arena->max_concurrency(); }
+
+  template <typename F>
+  void parallel_for(size_t begin, size_t end, F &&f) const {
+    arena->execute([&] {
+      oneapi::tbb::parallel_for(oneapi::tbb::blocked_range<size_t>(begin, end),
+                                [&](const oneapi::tbb::blocked_range<size_t> &r) {
+                                  for (auto i = r.begin(); i != r.end(); i++) f(i);
+                                });
+    });
+  }
+  template <typename Out, typename F>
+  void parallel_transform(size_t begin, size_t end, Out out, F &&f) const {
+    parallel_for(begin, end, [&](size_t i) { out[i - begin] = f(i); });
+  }
+  template <typename T, typename Map, typename Op>
+  T parallel_reduce(size_t begin, size_t end, T identity, Map &&map, Op &&op) const {
+    return arena->execute([&] {
+      return oneapi::tbb::parallel_reduce(
+          oneapi::tbb::blocked_range<size_t>(begin, end), identity,
+          [&](const oneapi::tbb::blocked_range<size_t> &r, T acc) {
+            for (auto i = r.begin(); i != r.end(); i++) acc = op(acc, map(i));
+            return acc;
+          },
+          op);
+    });
+  }
+  template <typename In, typename Out, typename T, typename Op>
+  void inclusive_scan(In first, In last, Out d_first, T identity, Op &&op) const {
+    auto n = static_cast<size_t>(std::distance(first, last));
+    arena->execute([&] {
+      oneapi::tbb::parallel_scan(
+          oneapi::tbb::blocked_range<size_t>(0, n), identity,
+          [&](const oneapi::tbb::blocked_range<size_t> &r, T acc, bool is_final) {
+            for (auto i = r.begin(); i != r.end(); i++) {
+              acc = op(acc, first[i]);
+              if (is_final) d_first[i] = acc;
+            }
+            return acc;
+          },
+          op);
+    });
+  }
+  template <typename It, typename Compare = std::less<>>
+  void sort(It first, It last, Compare comp = {}) const {
+    arena->execute([&] { oneapi::tbb::parallel_sort(first, last, comp); });
+  }
+
+ private:
+  // shared by copies, so executor stays cheap to pass by value
+  std::shared_ptr<oneapi::tbb::task_arena> arena;
+};
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_BACKEND_TBB_HPP_
@@ -0,0 +1,152 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_KERNEL_TASKS_HPP_
+#define MODULES_CORE_INCLUDE_KERNEL_TASKS_HPP_
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/backend/include/backend.hpp"
+#include "core/backend/include/kernels.hpp"
+#include "core/registry/include/registry.hpp"
+#include "core/task/include/task.hpp"
+
+namespace ppc::core {
+
+// Dot product of inputs[0] and inputs[1] into outputs[0][0]
+template <Executor Exec, typename T>
+class DotTask : public Task {
+ public:
+  explicit DotTask(std::shared_ptr<TaskData> taskData_, Exec exec_ = Exec())
+      : Task(std::move(taskData_)), exec(std::move(exec_)) {}
+  bool validation() override {
+    internal_order_test();
+    return taskData->inputs_count.size() == 2 && taskData->inputs_count[0] == taskData->inputs_count[1] &&
+           taskData->outputs_count.size() == 1 && taskData->outputs_count[0] == 1;
+  }
+  bool pre_processing() override {
+    internal_order_test();
+    a = reinterpret_cast<T *>(taskData->inputs[0]);
+    b = reinterpret_cast<T *>(taskData->inputs[1]);
+    return true;
+  }
+  bool run() override {
+    internal_order_test();
+    res = kernels::dot(exec, a, b, taskData->inputs_count[0]);
+    return true;
+  }
+  bool post_processing() override {
+    internal_order_test();
+    reinterpret_cast<T *>(taskData->outputs[0])[0] = res;
+    return true;
+  }
+
+ private:
+  Exec exec;
+  const T *a = nullptr;
+  const T *b = nullptr;
+  T res{};
+};
+
+// Maximums of columns of row-major matrix inputs[0] into outputs[0], count of columns is outputs_count[0]
+template <Executor Exec, typename T>
+class ColumnMaxTask : public Task {
+ public:
+  explicit ColumnMaxTask(std::shared_ptr<TaskData> taskData_, Exec exec_ = Exec())
+      : Task(std::move(taskData_)), exec(std::move(exec_)) {}
+  bool validation() override {
+    internal_order_test();
+    return taskData->inputs_count.size() == 1 && taskData->outputs_count.size() == 1 &&
+           taskData->outputs_count[0] > 0 && taskData->inputs_count[0] % taskData->outputs_count[0] == 0;
+  }
+  bool pre_processing() override {
+    internal_order_test();
+    matrix = reinterpret_cast<T *>(taskData->inputs[0]);
+    cols = taskData->outputs_count[0];
+    rows = taskData->inputs_count[0] / cols;
+    res.resize(cols);
+    return true;
+  }
+  bool run() override {
+    internal_order_test();
+    kernels::column_max(exec, matrix, rows, cols, res.data());
+    return true;
+  }
+  bool post_processing() override {
+    internal_order_test();
+    std::copy(res.begin(), res.end(), reinterpret_cast<T *>(taskData->outputs[0]));
+    return true;
+  }
+
+ private:
+  Exec exec;
+  const T *matrix = nullptr;
+  size_t rows = 0;
+  size_t cols = 0;
+  std::vector<T> res;
+};
+
+// Registers "<backend>/backend_dot" and "<backend>/backend_column_max" tasks of executor, so one bench run
+// compares the same kernels over all backends; inputs are generated on every process
+template <Executor Exec>
+struct KernelTasksRegistrar {
+  static constexpr size_t COLUMNS = 1000;
+
+  KernelTasksRegistrar() {
+    const std::string backend = Exec::name;
+    auto &registry = TaskRegistry::instance();
+    registry.add({backend + "/backend_dot",
+                  [](std::shared_ptr<TaskData> taskData) { return std::make_shared<DotTask<Exec, int64_t>>(taskData); },
+                  [](uint64_t size) {
+                    // a, b and output
+                    auto data = std::make_shared<std::vector<std::vector<int64_t>>>(3);
+                    auto &a = (*data)[0];
+                    auto &b = (*data)[1];
+                    auto &out = (*data)[2];
+                    a.resize(size);
+                    b.resize(size);
+                    out.resize(1);
+                    int64_t expected = 0;
+                    for (uint64_t i = 0; i < size; i++) {
+                      a[i] = static_cast<int64_t>(i % 7) - 3;
+                      b[i] = static_cast<int64_t>(i % 5);
+                      expected += a[i] * b[i];
+                    }
+                    BenchInput input;
+                    input.taskData = std::make_shared<TaskData>();
+                    input.taskData->inputs = {reinterpret_cast<uint8_t *>(a.data()),
+                                              reinterpret_cast<uint8_t *>(b.data())};
+                    input.taskData->inputs_count = {static_cast<uint32_t>(size), static_cast<uint32_t>(size)};
+                    input.taskData->outputs = {reinterpret_cast<uint8_t *>(out.data())};
+                    input.taskData->outputs_count = {1};
+                    input.storage = data;
+                    input.check = [data, expected] { return (*data)[2][0] == expected; };
+                    return input;
+                  },
+                  {1000000, 10000000}});
+    registry.add({backend + "/backend_column_max",
+                  [](std::shared_ptr<TaskData> taskData) {
+                    return std::make_shared<ColumnMaxTask<Exec, int32_t>>(taskData);
+                  },
+                  [](uint64_t size) {
+                    auto rows = std::max<uint64_t>(size / COLUMNS, 1);
+                    std::vector<int32_t> matrix(rows * COLUMNS);
+                    std::vector<int32_t> expected(COLUMNS, 0);
+                    for (uint64_t i = 0; i < matrix.size(); i++) {
+                      matrix[i] = static_cast<int32_t>((i * 2654435761U) % 1000);
+                      expected[i % COLUMNS] = std::max(expected[i % COLUMNS], matrix[i]);
+                    }
+                    return make_bench_input(std::move(matrix), std::vector<int32_t>(COLUMNS, -1),
+                                            [expected](const std::vector<int32_t> &out) { return out == expected; });
+                  },
+                  {1000000, 10000000}});
+  }
+};
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_KERNEL_TASKS_HPP_
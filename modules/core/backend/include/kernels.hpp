@@ -0,0 +1,34 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_KERNELS_HPP_
+#define MODULES_CORE_INCLUDE_KERNELS_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <limits>
+
+#include "core/backend/include/backend.hpp"
+
+namespace ppc::core::kernels {
+
+// Kernels written once for every executor of backend.hpp
+
+template <Executor Exec, typename T>
+T dot(const Exec &exec, const T *a, const T *b, size_t n) {
+  return exec.parallel_reduce(size_t{0}, n, T{}, [a, b](size_t i) { return a[i] * b[i]; }, std::plus<>());
+}
+
+// Maximum of every column of row-major matrix
+template <Executor Exec, typename T>
+void column_max(const Exec &exec, const T *matrix, size_t rows, size_t cols, T *result) {
+  exec.parallel_transform(size_t{0}, cols, result, [=](size_t col) {
+    auto max = std::numeric_limits<T>::lowest();
+    for (size_t row = 0; row < rows; row++) max = std::max(max, matrix[row * cols + col]);
+    return max;
+  });
+}
+
+}  // namespace ppc::core::kernels
+
+#endif  // MODULES_CORE_INCLUDE_KERNELS_HPP_
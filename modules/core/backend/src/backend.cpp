@@ -0,0 +1,101 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/backend/include/backend.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+int ppc::core::default_num_threads(int fallback) {
+  for (const auto *name : {"PPC_NUM_THREADS", "OMP_NUM_THREADS"}) {
+#ifdef _MSC_VER
+    char *buf = nullptr;
+    size_t len = 0;
+    if (_dupenv_s(&buf, &len, name) != 0 || buf == nullptr) continue;
+    std::string value(buf);
+    free(buf);
+#else
+    const char *env = std::getenv(name);
+    if (env == nullptr) continue;
+    std::string value(env);
+#endif
+    try {
+      auto num_threads = std::stoi(value);
+      if (num_threads > 0) return num_threads;
+    } catch (const std::exception &) {
+      continue;
+    }
+  }
+  if (fallback > 0) return fallback;
+  return std::max(static_cast<int>(std::thread::hardware_concurrency()), 1);
+}
+
+ppc::core::ThreadPool::ThreadPool(int num_threads) {
+  if (num_threads < 1) throw std::invalid_argument("Thread pool needs at least one thread");
+  workers.reserve(static_cast<size_t>(num_threads - 1));
+  for (int part = 1; part < num_threads; part++) workers.emplace_back([this, part] { work(part); });
+}
+
+ppc::core::ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard lock(mutex);
+    stopping = true;
+  }
+  wake.notify_all();
+  for (auto &worker : workers) worker.join();
+}
+
+void ppc::core::ThreadPool::run(size_t parts, const std::function<void(size_t)> &f) {
+  if (parts > static_cast<size_t>(size())) throw std::invalid_argument("More blocks than threads of pool");
+  if (parts <= 1) {
+    if (parts == 1) f(0);
+    return;
+  }
+  std::lock_guard run_lock(run_mutex);
+  {
+    std::lock_guard lock(mutex);
+    job = &f;
+    job_parts = parts;
+    pending = parts - 1;
+    error = nullptr;
+    generation++;
+  }
+  wake.notify_all();
+  std::exception_ptr own_error;
+  try {
+    f(0);
+  } catch (...) {
+    own_error = std::current_exception();
+  }
+  std::unique_lock lock(mutex);
+  done.wait(lock, [this] { return pending == 0; });
+  job = nullptr;
+  if (own_error) std::rethrow_exception(own_error);
+  if (error) std::rethrow_exception(error);
+}
+
+void ppc::core::ThreadPool::work(size_t part) {
+  pin_worker(static_cast<int>(part));
+  uint64_t seen = 0;
+  while (true) {
+    std::unique_lock lock(mutex);
+    wake.wait(lock, [&] { return stopping || generation != seen; });
+    if (stopping) return;
+    seen = generation;
+    if (part >= job_parts) continue;
+    const auto *f = job;
+    lock.unlock();
+    std::exception_ptr own_error;
+    try {
+      (*f)(part);
+    } catch (...) {
+      own_error = std::current_exception();
+    }
+    lock.lock();
+    if (own_error && !error) error = own_error;
+    if (--pending == 0) done.notify_one();
+  }
+}
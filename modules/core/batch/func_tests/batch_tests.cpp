@@ -0,0 +1,84 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+#include "core/batch/include/batch.hpp"
+#include "core/task/func_tests/test_task.hpp"
+
+namespace {
+
+struct Instance {
+  std::vector<int32_t> in;
+  std::vector<int32_t> out;
+  std::shared_ptr<ppc::core::TaskData> taskData;
+};
+
+std::vector<Instance> make_instances(size_t count) {
+  std::vector<Instance> instances(count);
+  for (size_t i = 0; i < count; i++) {
+    auto &instance = instances[i];
+    instance.in = std::vector<int32_t>(i + 1, 1);
+    instance.out = std::vector<int32_t>(1, 0);
+    instance.taskData = std::make_shared<ppc::core::TaskData>();
+    instance.taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(instance.in.data()));
+    instance.taskData->inputs_count.emplace_back(instance.in.size());
+    instance.taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(instance.out.data()));
+    instance.taskData->outputs_count.emplace_back(instance.out.size());
+  }
+  return instances;
+}
+
+std::vector<std::shared_ptr<ppc::core::TaskData>> get_batch(const std::vector<Instance> &instances) {
+  std::vector<std::shared_ptr<ppc::core::TaskData>> batch;
+  for (const auto &instance : instances) batch.push_back(instance.taskData);
+  return batch;
+}
+
+}  // namespace
+
+TEST(batch_tests, check_sequential_batch) {
+  auto instances = make_instances(100);
+  int created = 0;
+  ppc::core::BatchRunner runner([&](std::shared_ptr<ppc::core::TaskData> taskData) {
+    created++;
+    return std::make_shared<ppc::test::TestTask<int32_t>>(taskData);
+  });
+
+  auto results = runner.run(get_batch(instances));
+  ASSERT_EQ(results.size(), instances.size());
+  EXPECT_EQ(created, 1);
+  for (size_t i = 0; i < instances.size(); i++) {
+    EXPECT_TRUE(results[i]);
+    EXPECT_EQ(static_cast<size_t>(instances[i].out[0]), i + 1);
+  }
+}
+
+TEST(batch_tests, check_parallel_batch) {
+  auto instances = make_instances(257);
+  ppc::core::BatchRunner runner([](std::shared_ptr<ppc::core::TaskData> taskData) {
+    return std::make_shared<ppc::test::TestTask<int32_t>>(taskData);
+  });
+
+  auto results = runner.run(get_batch(instances), 4);
+  ASSERT_EQ(results.size(), instances.size());
+  for (size_t i = 0; i < instances.size(); i++) {
+    EXPECT_TRUE(results[i]);
+    EXPECT_EQ(static_cast<size_t>(instances[i].out[0]), i + 1);
+  }
+}
+
+TEST(batch_tests, check_failed_validation) {
+  auto instances = make_instances(10);
+  instances[3].taskData->outputs_count[0] = 2;
+  ppc::core::BatchRunner runner([](std::shared_ptr<ppc::core::TaskData> taskData) {
+    return std::make_shared<ppc::test::TestTask<int32_t>>(taskData);
+  });
+
+  auto results = runner.run(get_batch(instances), 2);
+  for (size_t i = 0; i < instances.size(); i++) {
+    EXPECT_EQ(results[i], i != 3);
+  }
+  EXPECT_EQ(instances[4].out[0], 5);
+}
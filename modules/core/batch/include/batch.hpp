@@ -0,0 +1,35 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_BATCH_HPP_
+#define MODULES_CORE_INCLUDE_BATCH_HPP_
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "core/task/include/task.hpp"
+
+namespace ppc::core {
+
+// Runs full pipeline of one task type for many small instances. Task objects are
+// created once per worker and rebound to every next instance, instances are
+// dispatched dynamically over worker threads.
+class BatchRunner {
+ public:
+  using TaskFactory = std::function<std::shared_ptr<Task>(std::shared_ptr<TaskData>)>;
+
+  explicit BatchRunner(TaskFactory factory_);
+
+  // Run every instance of batch with num_threads workers, result[i] is false if
+  // validation or any other stage of i-th instance failed
+  [[nodiscard]] std::vector<bool> run(const std::vector<std::shared_ptr<TaskData>> &batch,
+                                      size_t num_threads = 1) const;
+
+ private:
+  TaskFactory factory;
+};
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_BATCH_HPP_
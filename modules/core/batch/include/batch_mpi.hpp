@@ -0,0 +1,218 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_BATCH_MPI_HPP_
+#define MODULES_CORE_INCLUDE_BATCH_MPI_HPP_
+
+#include <boost/mpi/collectives.hpp>
+#include <boost/mpi/communicator.hpp>
+#include <boost/serialization/string.hpp>
+#include <boost/serialization/vector.hpp>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "core/arena/include/arena.hpp"
+#include "core/batch/include/batch.hpp"
+
+namespace ppc::core {
+
+// Size in bytes of one element of every input and output of task
+struct BatchLayout {
+  std::vector<size_t> input_elem_sizes;
+  std::vector<size_t> output_elem_sizes;
+};
+
+namespace detail {
+
+// Reason why batch can't be packed by layout, empty if it can
+inline std::string batch_error(const std::vector<std::shared_ptr<TaskData>> &batch, const BatchLayout &layout) {
+  const auto num_in = layout.input_elem_sizes.size();
+  const auto num_out = layout.output_elem_sizes.size();
+  // packed buffers of all instances are addressed by int counts of collectives
+  uint64_t total_in = 0;
+  uint64_t total_out = 0;
+  for (size_t i = 0; i < batch.size(); i++) {
+    const auto &taskData = batch[i];
+    const auto instance = "Instance " + std::to_string(i) + " of batch ";
+    if (!taskData) return instance + "has no task data";
+    if (taskData->inputs.size() != num_in || taskData->inputs_count.size() != num_in) {
+      return instance + "has other count of inputs than layout";
+    }
+    if (taskData->outputs.size() != num_out || taskData->outputs_count.size() != num_out) {
+      return instance + "has other count of outputs than layout";
+    }
+    for (size_t j = 0; j < num_in; j++) {
+      if (taskData->inputs[j] == nullptr && taskData->inputs_count[j] > 0) return instance + "has null input";
+      total_in += taskData->inputs_count[j] * layout.input_elem_sizes[j] + BufferArena::ALIGNMENT;
+    }
+    for (size_t j = 0; j < num_out; j++) {
+      if (taskData->outputs[j] == nullptr && taskData->outputs_count[j] > 0) return instance + "has null output";
+      total_out += taskData->outputs_count[j] * layout.output_elem_sizes[j] + BufferArena::ALIGNMENT;
+    }
+  }
+  if (total_in > INT_MAX || total_out > INT_MAX) return "Batch is too big for one collective";
+  return {};
+}
+
+}  // namespace detail
+
+// Runs batch given on root with whole instances distributed over ranks instead of splitting
+// every instance: inputs of all instances of a rank are sent in one fused scatterv and outputs
+// come back in one gatherv, so a batch costs two collectives instead of a broadcast per instance.
+// Every rank runs its instances with runner, which is expected to create sequential tasks.
+// Returns success of every instance on root and empty vector on other ranks.
+// Batch is checked on root and layout is compared with root's one before any data is sent, so all ranks
+// throw std::invalid_argument if one of them is wrong. If runner throws on some rank, that rank rethrows its
+// exception and other ranks throw std::runtime_error, no rank is left in collectives.
+inline std::vector<bool> run_batch_mpi(const boost::mpi::communicator &world, const BatchRunner &runner,
+                                       const std::vector<std::shared_ptr<TaskData>> &batch, const BatchLayout &layout,
+                                       size_t num_threads = 1, int root = 0) {
+  const auto num_in = layout.input_elem_sizes.size();
+  const auto num_out = layout.output_elem_sizes.size();
+  const auto counts_per_instance = num_in + num_out;
+  const bool is_root = world.rank() == root;
+
+  std::string error = is_root ? detail::batch_error(batch, layout) : std::string();
+  boost::mpi::broadcast(world, error, root);
+  if (!error.empty()) throw std::invalid_argument(error);
+  auto root_layout = layout;
+  boost::mpi::broadcast(world, root_layout.input_elem_sizes, root);
+  boost::mpi::broadcast(world, root_layout.output_elem_sizes, root);
+  const bool same_layout = root_layout.input_elem_sizes == layout.input_elem_sizes &&
+                           root_layout.output_elem_sizes == layout.output_elem_sizes;
+  if (!boost::mpi::all_reduce(world, same_layout, std::logical_and<>())) {
+    throw std::invalid_argument("Layout of batch differs between ranks");
+  }
+
+  // Element counts of every instance are the only metadata ranks need
+  uint64_t n = is_root ? batch.size() : 0;
+  boost::mpi::broadcast(world, n, root);
+  if (n == 0) return {};
+  std::vector<uint32_t> counts(n * counts_per_instance);
+  if (is_root) {
+    for (size_t i = 0; i < n; i++) {
+      for (size_t j = 0; j < num_in; j++) counts[i * counts_per_instance + j] = batch[i]->inputs_count[j];
+      for (size_t j = 0; j < num_out; j++) counts[i * counts_per_instance + num_in + j] = batch[i]->outputs_count[j];
+    }
+  }
+  boost::mpi::broadcast(world, counts.data(), static_cast<int>(counts.size()), root);
+
+  // Every buffer is padded to arena alignment, so unpacked buffers stay aligned
+  auto padded = [](size_t bytes) {
+    return (bytes + BufferArena::ALIGNMENT - 1) / BufferArena::ALIGNMENT * BufferArena::ALIGNMENT;
+  };
+  auto buffer_bytes = [&](size_t i, size_t j) {
+    auto elem_size = j < num_in ? layout.input_elem_sizes[j] : layout.output_elem_sizes[j - num_in];
+    return padded(counts[i * counts_per_instance + j] * elem_size);
+  };
+  auto instance_bytes = [&](size_t i, size_t first, size_t last) {
+    size_t bytes = 0;
+    for (size_t j = first; j < last; j++) bytes += buffer_bytes(i, j);
+    return bytes;
+  };
+
+  // Block partition of instances over ranks
+  const int size = world.size();
+  auto first_instance = [&](int r) { return n * r / size; };
+  std::vector<int> in_sizes(size, 0), in_displs(size, 0), out_sizes(size, 0), out_displs(size, 0);
+  std::vector<int> ok_sizes(size, 0), ok_displs(size, 0);
+  for (int r = 0; r < size; r++) {
+    for (auto i = first_instance(r); i < first_instance(r + 1); i++) {
+      in_sizes[r] += static_cast<int>(instance_bytes(i, 0, num_in));
+      out_sizes[r] += static_cast<int>(instance_bytes(i, num_in, counts_per_instance));
+    }
+    ok_sizes[r] = static_cast<int>(first_instance(r + 1) - first_instance(r));
+    if (r > 0) {
+      in_displs[r] = in_displs[r - 1] + in_sizes[r - 1];
+      out_displs[r] = out_displs[r - 1] + out_sizes[r - 1];
+      ok_displs[r] = ok_displs[r - 1] + ok_sizes[r - 1];
+    }
+  }
+  const int rank = world.rank();
+  const auto lo = first_instance(rank);
+  const auto hi = first_instance(rank + 1);
+
+  BufferArena buffers;
+  auto local_in = buffers.get<uint8_t>("inputs", in_sizes[rank]);
+  auto local_out = buffers.get<uint8_t>("outputs", out_sizes[rank]);
+  std::memset(local_out.data(), 0, local_out.size());
+  if (is_root) {
+    auto total_in = static_cast<size_t>(in_displs[size - 1] + in_sizes[size - 1]);
+    auto packed_in = buffers.get<uint8_t>("packed_inputs", total_in);
+    size_t offset = 0;
+    for (size_t i = 0; i < n; i++) {
+      for (size_t j = 0; j < num_in; j++) {
+        // empty buffers may be null
+        const auto bytes = counts[i * counts_per_instance + j] * layout.input_elem_sizes[j];
+        if (bytes > 0) std::memcpy(packed_in.data() + offset, batch[i]->inputs[j], bytes);
+        offset += buffer_bytes(i, j);
+      }
+    }
+    boost::mpi::scatterv(world, packed_in.data(), in_sizes, in_displs, local_in.data(), in_sizes[rank], root);
+  } else {
+    boost::mpi::scatterv(world, local_in.data(), in_sizes[rank], root);
+  }
+
+  // Local instances point straight into received buffers
+  std::vector<std::shared_ptr<TaskData>> local_batch;
+  size_t in_offset = 0;
+  size_t out_offset = 0;
+  for (auto i = lo; i < hi; i++) {
+    auto taskData = std::make_shared<TaskData>();
+    for (size_t j = 0; j < num_in; j++) {
+      taskData->inputs.emplace_back(local_in.data() + in_offset);
+      taskData->inputs_count.emplace_back(counts[i * counts_per_instance + j]);
+      in_offset += buffer_bytes(i, j);
+    }
+    for (size_t j = 0; j < num_out; j++) {
+      taskData->outputs.emplace_back(local_out.data() + out_offset);
+      taskData->outputs_count.emplace_back(counts[i * counts_per_instance + num_in + j]);
+      out_offset += buffer_bytes(i, num_in + j);
+    }
+    local_batch.push_back(std::move(taskData));
+  }
+  // Failure of runner is agreed on before gathers, otherwise other ranks would wait in them forever
+  std::vector<bool> local_results;
+  std::exception_ptr local_error;
+  try {
+    local_results = runner.run(local_batch, num_threads);
+  } catch (...) {
+    local_error = std::current_exception();
+  }
+  if (boost::mpi::all_reduce(world, static_cast<bool>(local_error), std::logical_or<>())) {
+    if (local_error) std::rethrow_exception(local_error);
+    throw std::runtime_error("Batch runner failed on other rank");
+  }
+  std::vector<uint8_t> local_ok(local_results.begin(), local_results.end());
+
+  if (!is_root) {
+    boost::mpi::gatherv(world, local_out.data(), out_sizes[rank], root);
+    boost::mpi::gatherv(world, local_ok.data(), ok_sizes[rank], root);
+    return {};
+  }
+
+  auto total_out = static_cast<size_t>(out_displs[size - 1] + out_sizes[size - 1]);
+  auto packed_out = buffers.get<uint8_t>("packed_outputs", total_out);
+  std::vector<uint8_t> ok(n);
+  boost::mpi::gatherv(world, local_out.data(), out_sizes[rank], packed_out.data(), out_sizes, out_displs, root);
+  boost::mpi::gatherv(world, local_ok.data(), ok_sizes[rank], ok.data(), ok_sizes, ok_displs, root);
+  size_t offset = 0;
+  for (size_t i = 0; i < n; i++) {
+    for (size_t j = 0; j < num_out; j++) {
+      const auto bytes = counts[i * counts_per_instance + num_in + j] * layout.output_elem_sizes[j];
+      if (bytes > 0) std::memcpy(batch[i]->outputs[j], packed_out.data() + offset, bytes);
+      offset += buffer_bytes(i, num_in + j);
+    }
+  }
+  return {ok.begin(), ok.end()};
+}
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_BATCH_MPI_HPP_
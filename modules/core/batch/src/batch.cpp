@@ -0,0 +1,51 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/batch/include/batch.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+#include <utility>
+
+ppc::core::BatchRunner::BatchRunner(TaskFactory factory_) : factory(std::move(factory_)) {}
+
+std::vector<bool> ppc::core::BatchRunner::run(const std::vector<std::shared_ptr<TaskData>> &batch,
+                                              size_t num_threads) const {
+  std::vector<char> results(batch.size(), 0);
+  std::atomic<size_t> next{0};
+  std::exception_ptr error;
+  std::atomic<bool> failed{false};
+
+  auto worker = [&]() {
+    try {
+      std::shared_ptr<Task> task;
+      for (auto i = next++; i < batch.size() && !failed; i = next++) {
+        if (task) {
+          task->rebind(batch[i]);
+        } else {
+          task = factory(batch[i]);
+        }
+        // Interrupted pipeline is fine here: rebind() starts order tracking from scratch
+        bool ok = run_stage(*task, &Task::validation) && run_stage(*task, &Task::pre_processing) &&
+                  run_stage(*task, &Task::run) && run_stage(*task, &Task::post_processing);
+        results[i] = static_cast<char>(ok);
+      }
+    } catch (...) {
+      if (!failed.exchange(true)) error = std::current_exception();
+    }
+  };
+
+  num_threads = std::clamp<size_t>(num_threads, 1, std::max<size_t>(batch.size(), 1));
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads - 1);
+  for (size_t t = 1; t < num_threads; t++) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  if (error) std::rethrow_exception(error);
+
+  return {results.begin(), results.end()};
+}
@@ -0,0 +1,97 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <climits>
+#include <functional>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "core/coll/include/coll.hpp"
+#include "core/coll/include/reduce_ops.hpp"
+
+using ppc::coll::Algorithm;
+using ppc::coll::Collective;
+
+TEST(coll_tests, check_latency_bound_messages_use_trees) {
+  EXPECT_EQ(ppc::coll::select_algorithm(Collective::BCAST, 1024, 256, 64), Algorithm::BINOMIAL);
+  EXPECT_EQ(ppc::coll::select_algorithm(Collective::BCAST, 1 << 18, 1 << 16, 4), Algorithm::BINOMIAL);
+  EXPECT_EQ(ppc::coll::select_algorithm(Collective::REDUCE, 8, 1, 16), Algorithm::BINOMIAL);
+  EXPECT_EQ(ppc::coll::select_algorithm(Collective::ALLREDUCE, 8, 1, 7), Algorithm::RECURSIVE_DOUBLING);
+  EXPECT_EQ(ppc::coll::select_algorithm(Collective::GATHER, 4096, 128, 8), Algorithm::BINOMIAL);
+  EXPECT_EQ(ppc::coll::select_algorithm(Collective::ALLGATHER, 4096, 128, 8), Algorithm::RECURSIVE_DOUBLING);
+}
+
+TEST(coll_tests, check_bandwidth_bound_messages_split_blocks) {
+  EXPECT_EQ(ppc::coll::select_algorithm(Collective::BCAST, 1 << 18, 1 << 16, 16), Algorithm::SCATTER_ALLGATHER);
+  // 16 segments of 64 KiB fill chain of 8 ranks, but not of 64 ranks
+  EXPECT_EQ(ppc::coll::select_algorithm(Collective::BCAST, 1 << 20, 1 << 18, 8), Algorithm::PIPELINED_CHAIN);
+  EXPECT_EQ(ppc::coll::select_algorithm(Collective::BCAST, 1 << 20, 1 << 18, 64), Algorithm::PIPELINED_BINARY);
+  EXPECT_EQ(ppc::coll::select_algorithm(Collective::REDUCE, 1 << 16, 1 << 13, 6), Algorithm::RABENSEIFNER);
+  EXPECT_EQ(ppc::coll::select_algorithm(Collective::ALLREDUCE, 1 << 16, 1 << 13, 8), Algorithm::RABENSEIFNER);
+  EXPECT_EQ(ppc::coll::select_algorithm(Collective::ALLREDUCE, 1 << 22, 1 << 19, 8), Algorithm::RABENSEIFNER);
+  EXPECT_EQ(ppc::coll::select_algorithm(Collective::ALLREDUCE, 1 << 22, 1 << 19, 6), Algorithm::RING);
+  EXPECT_EQ(ppc::coll::select_algorithm(Collective::SCATTER, 1 << 22, 1 << 19, 8), Algorithm::LINEAR);
+  EXPECT_EQ(ppc::coll::select_algorithm(Collective::ALLGATHER, 4096, 128, 6), Algorithm::RING);
+  // large element with fewer elements than ranks can't be split
+  EXPECT_EQ(ppc::coll::select_algorithm(Collective::ALLREDUCE, 1 << 16, 2, 8), Algorithm::RECURSIVE_DOUBLING);
+}
+
+TEST(coll_tests, check_thresholds_are_tunable) {
+  auto &limits = ppc::coll::thresholds();
+  const auto saved = limits;
+  limits.reduce_short_bytes = 0;
+  EXPECT_EQ(ppc::coll::select_algorithm(Collective::REDUCE, 64, 16, 4), Algorithm::RABENSEIFNER);
+  limits = saved;
+  EXPECT_EQ(ppc::coll::select_algorithm(Collective::REDUCE, 64, 16, 4), Algorithm::BINOMIAL);
+  EXPECT_EQ(std::string(ppc::coll::algorithm_name(Algorithm::SCATTER_ALLGATHER)), "scatter_allgather");
+}
+
+TEST(coll_tests, check_reduction_ops_identities_and_traits) {
+  EXPECT_EQ(ppc::coll::Sum<int>::identity(), 0);
+  EXPECT_EQ(ppc::coll::Prod<int>::identity(), 1);
+  EXPECT_EQ(ppc::coll::Min<int>::identity(), INT_MAX);
+  EXPECT_EQ(ppc::coll::Max<double>::identity(), -std::numeric_limits<double>::infinity());
+  EXPECT_EQ(ppc::coll::BitAnd<int>::identity(), -1);
+  EXPECT_EQ(ppc::coll::LogicalXor<int>()(7, 0), 1);
+  EXPECT_EQ(ppc::coll::LogicalXor<int>()(7, 3), 0);
+  EXPECT_TRUE(ppc::coll::reduction_traits<ppc::coll::Sum<float>>::has_identity);
+  // functors without traits are taken as commutative and associative
+  EXPECT_FALSE(ppc::coll::reduction_traits<std::plus<>>::has_identity);
+  EXPECT_TRUE(ppc::coll::reduction_traits<std::plus<>>::commutative);
+
+  std::vector<int> values = {12, 10, 7, 9, 4, 6};
+  EXPECT_EQ(ppc::coll::fold(values.data(), values.size(), ppc::coll::BitAnd<int>()), 0);
+  EXPECT_EQ(ppc::coll::fold(values.data(), values.size(), ppc::coll::Max<int>()), 12);
+  EXPECT_EQ(ppc::coll::fold(values.data(), 0, ppc::coll::Min<int>()), INT_MAX);
+}
+
+TEST(coll_tests, check_arg_min_and_arg_max_prefer_lower_index) {
+  using Value = ppc::coll::IndexedValue<double>;
+  std::vector<Value> values = {{3.0, 0}, {1.0, 1}, {5.0, 2}, {1.0, 3}, {5.0, 4}};
+  auto min = ppc::coll::fold(values.data(), values.size(), ppc::coll::ArgMin<double>());
+  auto max = ppc::coll::fold(values.data(), values.size(), ppc::coll::ArgMax<double>());
+  EXPECT_EQ(min.value, 1.0);
+  EXPECT_EQ(min.index, 1);
+  EXPECT_EQ(max.value, 5.0);
+  EXPECT_EQ(max.index, 2);
+  // reversed order of combines gives the same result
+  ppc::coll::ArgMin<double> arg_min;
+  EXPECT_EQ(arg_min(values[3], values[1]).index, 1);
+}
+
+TEST(coll_tests, check_kahan_sum_keeps_lost_bits) {
+  std::vector<double> values(1000001, 1e-16);
+  values[0] = 1.0;
+  double naive = ppc::coll::fold(values.data(), values.size(), ppc::coll::Sum<double>());
+  auto compensated = ppc::coll::fold(values.data(), values.size(), ppc::coll::KahanSum<double>());
+  EXPECT_EQ(naive, 1.0);
+  EXPECT_NEAR(ppc::coll::KahanSum<double>::result(compensated), 1.0 + 1e-10, 1e-15);
+
+  // partial sums of halves combine to the same result
+  ppc::coll::KahanSum<double> kahan;
+  auto half = values.size() / 2;
+  auto low = ppc::coll::fold(values.data(), half, kahan);
+  auto high = ppc::coll::fold(values.data() + half, values.size() - half, kahan);
+  EXPECT_NEAR(ppc::coll::KahanSum<double>::result(kahan(high, low)), 1.0 + 1e-10, 1e-15);
+}
@@ -0,0 +1,48 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_COLL_HPP_
+#define MODULES_CORE_INCLUDE_COLL_HPP_
+
+#include <cstddef>
+
+namespace ppc::coll {
+
+enum class Collective { BCAST, REDUCE, ALLREDUCE, SCATTER, GATHER, ALLGATHER };
+
+// Algorithms of collectives of coll_mpi.hpp
+enum class Algorithm {
+  AUTO,                // chosen by select_algorithm
+  LINEAR,              // root exchanges with every rank directly
+  BINOMIAL,            // binomial tree, log(p) steps with whole message
+  RECURSIVE_DOUBLING,  // pairwise exchanges with rank ^ 2^k
+  RABENSEIFNER,        // reduce-scatter by recursive halving, then gather or allgather by recursive doubling
+  RING,                // p - 1 steps over ring with 1/p of message
+  SCATTER_ALLGATHER,   // binomial scatter of blocks, then ring allgather (van de Geijn broadcast)
+  PIPELINED_CHAIN,     // segments flow down chain of ranks, every hop forwards segment while next one arrives
+  PIPELINED_BINARY     // segments flow down binary tree, shorter pipeline fill than chain for few segments
+};
+
+// Message sizes where algorithms switch, MPICH defaults for unsegmented algorithms
+struct Thresholds {
+  size_t bcast_short_bytes = 12288;
+  int bcast_min_procs = 8;
+  // broadcast of at least pipeline bytes is sent in segments of segment bytes
+  size_t bcast_pipeline_bytes = 524288;
+  size_t bcast_segment_bytes = 65536;
+  size_t reduce_short_bytes = 2048;
+  size_t allreduce_long_bytes = 524288;
+  size_t allgather_short_bytes = 81920;
+  size_t gather_long_bytes = 524288;
+};
+
+Thresholds &thresholds();
+
+// Fastest algorithm for message of count elements and bytes in total (of one rank for reduce, allreduce and
+// bcast, of all ranks for scatter, gather and allgather) in communicator of comm_size ranks
+Algorithm select_algorithm(Collective collective, size_t bytes, size_t count, int comm_size);
+
+const char *algorithm_name(Algorithm algorithm);
+
+}  // namespace ppc::coll
+
+#endif  // MODULES_CORE_INCLUDE_COLL_HPP_
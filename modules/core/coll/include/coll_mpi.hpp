@@ -0,0 +1,657 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_COLL_MPI_HPP_
+#define MODULES_CORE_INCLUDE_COLL_MPI_HPP_
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <boost/mpi/communicator.hpp>
+#include <climits>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "core/backend/include/backend.hpp"
+#include "core/coll/include/coll.hpp"
+#include "core/coll/include/reduce_ops.hpp"
+
+// Collectives over contiguous arrays of trivially copyable T, signatures follow Boost.MPI. Algorithm is
+// chosen by select_algorithm from message and communicator size unless it's given explicitly.
+// Reduction op is applied element-wise. Tree, Rabenseifner and ring algorithms need it to be commutative and
+// associative, recursive doubling keeps order of ranks and linear reduce also combines them one by one, so
+// traits of reduce_ops.hpp make AUTO choose these for ops which aren't commutative or associative.
+// All ranks of communicator have to call collective with the same count, algorithm and root.
+namespace ppc::coll {
+
+namespace detail {
+
+constexpr int TAG = 7400;
+
+inline int tag_of(Collective collective) { return TAG + static_cast<int>(collective); }
+
+inline int message_bytes(size_t count, size_t size) {
+  if (count > static_cast<size_t>(INT_MAX) / size) throw std::invalid_argument("Message of collective is over 2 GiB");
+  return static_cast<int>(count * size);
+}
+
+template <typename T>
+void send(const boost::mpi::communicator &comm, const T *data, size_t count, int dest, int tag) {
+  MPI_Send(data, message_bytes(count, sizeof(T)), MPI_BYTE, dest, tag, comm);
+}
+
+template <typename T>
+void recv(const boost::mpi::communicator &comm, T *data, size_t count, int source, int tag) {
+  MPI_Recv(data, message_bytes(count, sizeof(T)), MPI_BYTE, source, tag, comm, MPI_STATUS_IGNORE);
+}
+
+template <typename T>
+void sendrecv(const boost::mpi::communicator &comm, const T *send_data, size_t send_count, int dest, T *recv_data,
+              size_t recv_count, int source, int tag) {
+  MPI_Sendrecv(send_data, message_bytes(send_count, sizeof(T)), MPI_BYTE, dest, tag, recv_data,
+               message_bytes(recv_count, sizeof(T)), MPI_BYTE, source, tag, comm, MPI_STATUS_IGNORE);
+}
+
+// acc[i] = op(acc[i], other[i]), or op(other[i], acc[i]) if other holds values of lower ranks
+template <typename T, typename Op>
+void combine(T *__restrict acc, const T *__restrict other, size_t count, Op &op, bool other_first) {
+  if (other_first) {
+    for (size_t i = 0; i < count; i++) acc[i] = op(other[i], acc[i]);
+  } else {
+    for (size_t i = 0; i < count; i++) acc[i] = op(acc[i], other[i]);
+  }
+}
+
+// Offsets of parts nearly equal blocks of count elements, offsets[parts] == count
+inline std::vector<size_t> block_offsets(size_t count, int parts) {
+  std::vector<size_t> offsets(parts + 1, count);
+  for (int part = 0; part < parts; part++) {
+    offsets[part] = ppc::core::block_range(0, count, static_cast<size_t>(parts), static_cast<size_t>(part)).first;
+  }
+  return offsets;
+}
+
+inline int floor_pow2(int n) {
+  int pof2 = 1;
+  while (pof2 * 2 <= n) pof2 *= 2;
+  return pof2;
+}
+
+// Rank of communicator of newrank-th of pof2 participants after folding of rem extra ranks
+inline int folded_rank(int newrank, int rem) { return newrank < rem ? newrank * 2 + 1 : newrank + rem; }
+
+// Folds non power of two communicator to pof2 participants: of first 2 * rem ranks even ones give their values
+// to the next odd rank. Returns rank among participants, -1 for ranks that gave values away
+template <typename T, typename Op>
+int fold_in(const boost::mpi::communicator &comm, T *acc, T *tmp, size_t count, Op &op, int pof2, int tag) {
+  const int rank = comm.rank();
+  const int rem = comm.size() - pof2;
+  if (rank >= 2 * rem) return rank - rem;
+  if (rank % 2 == 0) {
+    send(comm, acc, count, rank + 1, tag);
+    return -1;
+  }
+  recv(comm, tmp, count, rank - 1, tag);
+  combine(acc, tmp, count, op, true);
+  return rank / 2;
+}
+
+// Returns results to ranks folded by fold_in
+template <typename T>
+void fold_out(const boost::mpi::communicator &comm, T *acc, size_t count, int pof2, int tag) {
+  const int rank = comm.rank();
+  if (rank >= 2 * (comm.size() - pof2)) return;
+  if (rank % 2 == 0) {
+    recv(comm, acc, count, rank + 1, tag);
+  } else {
+    send(comm, acc, count, rank - 1, tag);
+  }
+}
+
+template <typename T, typename Op>
+void recursive_doubling_allreduce(const boost::mpi::communicator &comm, T *acc, size_t count, Op &op, int tag) {
+  const int pof2 = floor_pow2(comm.size());
+  const int rem = comm.size() - pof2;
+  std::vector<T> tmp(count);
+  const int newrank = fold_in(comm, acc, tmp.data(), count, op, pof2, tag);
+  if (newrank >= 0) {
+    for (int mask = 1; mask < pof2; mask <<= 1) {
+      const int dst = folded_rank(newrank ^ mask, rem);
+      sendrecv(comm, acc, count, dst, tmp.data(), count, dst, tag);
+      combine(acc, tmp.data(), count, op, dst < comm.rank());
+    }
+  }
+  fold_out(comm, acc, count, pof2, tag);
+}
+
+// Block of reduce-scatter by recursive halving owned by newrank-th of pof2 participants
+inline int halving_block(int newrank, int pof2) {
+  int send_idx = 0;
+  int recv_idx = 0;
+  for (int mask = 1; mask < pof2; mask <<= 1) {
+    if (newrank < (newrank ^ mask)) {
+      send_idx = recv_idx + pof2 / (mask * 2);
+    } else {
+      recv_idx = send_idx + pof2 / (mask * 2);
+    }
+    send_idx = recv_idx;
+  }
+  return recv_idx;
+}
+
+// Rabenseifner's algorithm: reduce-scatter by recursive halving, then allgather by recursive doubling
+// (root < 0) or gather of blocks to root
+template <typename T, typename Op>
+void rabenseifner(const boost::mpi::communicator &comm, T *acc, size_t count, Op &op, int root, int tag) {
+  const int pof2 = floor_pow2(comm.size());
+  const int rem = comm.size() - pof2;
+  std::vector<T> tmp(count);
+  const int newrank = fold_in(comm, acc, tmp.data(), count, op, pof2, tag);
+  const auto offsets = block_offsets(count, pof2);
+  auto part = [&](int lo, int hi) { return offsets[hi] - offsets[lo]; };
+
+  int send_idx = 0;
+  int recv_idx = 0;
+  int last_idx = pof2;
+  int mask = 1;
+  if (newrank >= 0) {
+    for (; mask < pof2; mask <<= 1) {
+      const int newdst = newrank ^ mask;
+      const int dst = folded_rank(newdst, rem);
+      // lower half of current blocks is kept by lower participant of pair
+      int send_hi = last_idx;
+      int recv_hi = last_idx;
+      if (newrank < newdst) {
+        send_idx = recv_idx + pof2 / (mask * 2);
+        recv_hi = send_idx;
+      } else {
+        recv_idx = send_idx + pof2 / (mask * 2);
+        send_hi = recv_idx;
+      }
+      sendrecv(comm, acc + offsets[send_idx], part(send_idx, send_hi), dst, tmp.data() + offsets[recv_idx],
+               part(recv_idx, recv_hi), dst, tag);
+      combine(acc + offsets[recv_idx], tmp.data() + offsets[recv_idx], part(recv_idx, recv_hi), op, dst < comm.rank());
+      send_idx = recv_idx;
+      if (mask * 2 < pof2) last_idx = recv_idx + pof2 / (mask * 2);
+    }
+  }
+
+  if (root >= 0) {
+    // every participant owns one reduced block
+    if (comm.rank() == root) {
+      for (int p = 0; p < pof2; p++) {
+        const int source = folded_rank(p, rem);
+        const int block = halving_block(p, pof2);
+        if (source != root) recv(comm, acc + offsets[block], part(block, block + 1), source, tag);
+      }
+    } else if (newrank >= 0) {
+      send(comm, acc + offsets[send_idx], part(send_idx, send_idx + 1), root, tag);
+    }
+    return;
+  }
+
+  if (newrank >= 0) {
+    for (mask >>= 1; mask > 0; mask >>= 1) {
+      const int newdst = newrank ^ mask;
+      const int dst = folded_rank(newdst, rem);
+      if (newrank < newdst) {
+        if (mask != pof2 / 2) last_idx = last_idx + pof2 / (mask * 2);
+        recv_idx = send_idx + pof2 / (mask * 2);
+        sendrecv(comm, acc + offsets[send_idx], part(send_idx, recv_idx), dst, acc + offsets[recv_idx],
+                 part(recv_idx, last_idx), dst, tag);
+      } else {
+        recv_idx = send_idx - pof2 / (mask * 2);
+        sendrecv(comm, acc + offsets[send_idx], part(send_idx, last_idx), dst, acc + offsets[recv_idx],
+                 part(recv_idx, send_idx), dst, tag);
+        send_idx = recv_idx;
+      }
+    }
+  }
+  fold_out(comm, acc, count, pof2, tag);
+}
+
+// Reduce-scatter and allgather over ring, both in p - 1 steps with 1/p of message
+template <typename T, typename Op>
+void ring_allreduce(const boost::mpi::communicator &comm, T *acc, size_t count, Op &op, int tag) {
+  const int size = comm.size();
+  const int rank = comm.rank();
+  const int left = (rank - 1 + size) % size;
+  const int right = (rank + 1) % size;
+  const auto offsets = block_offsets(count, size);
+  auto part = [&](int block) { return offsets[block + 1] - offsets[block]; };
+  std::vector<T> tmp(count / size + 1);
+  for (int step = 0; step < size - 1; step++) {
+    const int send_block = (rank - step + size) % size;
+    const int recv_block = (rank - step - 1 + size) % size;
+    sendrecv(comm, acc + offsets[send_block], part(send_block), right, tmp.data(), part(recv_block), left, tag);
+    combine(acc + offsets[recv_block], tmp.data(), part(recv_block), op, true);
+  }
+  for (int step = 0; step < size - 1; step++) {
+    const int send_block = (rank - step + 1 + size) % size;
+    const int recv_block = (rank - step + size) % size;
+    sendrecv(comm, acc + offsets[send_block], part(send_block), right, acc + offsets[recv_block], part(recv_block),
+             left, tag);
+  }
+}
+
+template <typename T, typename Op>
+void binomial_reduce(const boost::mpi::communicator &comm, T *acc, size_t count, Op &op, int root, int tag) {
+  const int size = comm.size();
+  const int rank = comm.rank();
+  const int relative = (rank - root + size) % size;
+  std::vector<T> tmp(count);
+  for (int mask = 1; mask < size; mask <<= 1) {
+    if ((relative & mask) != 0) {
+      send(comm, acc, count, (rank - mask + size) % size, tag);
+      return;
+    }
+    if (relative + mask < size) {
+      recv(comm, tmp.data(), count, (rank + mask) % size, tag);
+      combine(acc, tmp.data(), count, op, false);
+    }
+  }
+}
+
+// Root combines values of ranks in their order
+template <typename T, typename Op>
+void linear_reduce(const boost::mpi::communicator &comm, const T *in, T *acc, size_t count, Op &op, int root,
+                   int tag) {
+  if (comm.rank() != root) {
+    send(comm, in, count, root, tag);
+    return;
+  }
+  std::vector<T> tmp(count);
+  std::vector<T> own(in, in + count);
+  for (int rank = 0; rank < comm.size(); rank++) {
+    const T *values = own.data();
+    if (rank != root) {
+      recv(comm, tmp.data(), count, rank, tag);
+      values = tmp.data();
+    }
+    if (rank == 0) {
+      std::copy(values, values + count, acc);
+    } else {
+      combine(acc, values, count, op, false);
+    }
+  }
+}
+
+template <typename T>
+void binomial_bcast(const boost::mpi::communicator &comm, T *data, size_t count, int root, int tag) {
+  const int size = comm.size();
+  const int rank = comm.rank();
+  const int relative = (rank - root + size) % size;
+  int mask = 1;
+  for (; mask < size; mask <<= 1) {
+    if ((relative & mask) != 0) {
+      recv(comm, data, count, (rank - mask + size) % size, tag);
+      break;
+    }
+  }
+  for (mask >>= 1; mask > 0; mask >>= 1) {
+    if (relative + mask < size) send(comm, data, count, (rank + mask) % size, tag);
+  }
+}
+
+// Binomial scatter of blocks ordered by rank relative to root, then ring allgather of them
+template <typename T>
+void scatter_allgather_bcast(const boost::mpi::communicator &comm, T *data, size_t count, int root, int tag) {
+  const int size = comm.size();
+  const int rank = comm.rank();
+  const int relative = (rank - root + size) % size;
+  const auto offsets = block_offsets(count, size);
+  auto blocks = [&](int lo, int hi) { return offsets[std::min(hi, size)] - offsets[lo]; };
+  int mask = 1;
+  for (; mask < size; mask <<= 1) {
+    if ((relative & mask) != 0) {
+      recv(comm, data + offsets[relative], blocks(relative, relative + mask), (rank - mask + size) % size, tag);
+      break;
+    }
+  }
+  for (mask >>= 1; mask > 0; mask >>= 1) {
+    if (relative + mask < size) {
+      send(comm, data + offsets[relative + mask], blocks(relative + mask, relative + 2 * mask), (rank + mask) % size,
+           tag);
+    }
+  }
+  const int left = (rank - 1 + size) % size;
+  const int right = (rank + 1) % size;
+  for (int step = 0; step < size - 1; step++) {
+    const int send_block = (relative - step + size) % size;
+    const int recv_block = (relative - step - 1 + size) % size;
+    sendrecv(comm, data + offsets[send_block], blocks(send_block, send_block + 1), right, data + offsets[recv_block],
+             blocks(recv_block, recv_block + 1), left, tag);
+  }
+}
+
+// Segments of segment_bytes are received from parent in chain or binary tree of ranks relative to root and
+// forwarded to children while next segments arrive, so large message takes about one transfer time
+template <typename T>
+void pipelined_bcast(const boost::mpi::communicator &comm, T *data, size_t count, int root, bool binary_tree,
+                     size_t segment_bytes, int tag) {
+  const int size = comm.size();
+  const int relative = (comm.rank() - root + size) % size;
+  auto rank_of = [&](int r) { return (r + root) % size; };
+  int parent = -1;
+  std::vector<int> children;
+  if (binary_tree) {
+    if (relative > 0) parent = (relative - 1) / 2;
+    for (int child : {2 * relative + 1, 2 * relative + 2}) {
+      if (child < size) children.push_back(child);
+    }
+  } else {
+    if (relative > 0) parent = relative - 1;
+    if (relative + 1 < size) children.push_back(relative + 1);
+  }
+
+  const size_t segment = std::max<size_t>(segment_bytes / sizeof(T), 1);
+  const size_t segments = (count + segment - 1) / segment;
+  auto segment_bytes_of = [&](size_t s) { return message_bytes(std::min(segment, count - s * segment), sizeof(T)); };
+  std::vector<MPI_Request> receives(parent >= 0 ? segments : 0);
+  for (size_t s = 0; s < receives.size(); s++) {
+    MPI_Irecv(data + s * segment, segment_bytes_of(s), MPI_BYTE, rank_of(parent), tag, comm, &receives[s]);
+  }
+  std::vector<MPI_Request> sends;
+  sends.reserve(segments * children.size());
+  for (size_t s = 0; s < segments; s++) {
+    if (parent >= 0) MPI_Wait(&receives[s], MPI_STATUS_IGNORE);
+    for (int child : children) {
+      sends.emplace_back();
+      MPI_Isend(data + s * segment, segment_bytes_of(s), MPI_BYTE, rank_of(child), tag, comm, &sends.back());
+    }
+  }
+  MPI_Waitall(static_cast<int>(sends.size()), sends.data(), MPI_STATUSES_IGNORE);
+}
+
+inline void unavailable(Algorithm algorithm, const char *collective) {
+  throw std::invalid_argument(std::string("Algorithm ") + algorithm_name(algorithm) + " isn't available for " +
+                              collective);
+}
+
+// Algorithm of reduce or all_reduce which is correct for traits of Op
+template <typename Op>
+Algorithm reduction_algorithm(Algorithm algorithm, Collective collective, size_t bytes, size_t count, int size) {
+  using traits = reduction_traits<Op>;
+  if (traits::commutative && traits::associative) {
+    return algorithm == Algorithm::AUTO ? select_algorithm(collective, bytes, count, size) : algorithm;
+  }
+  const bool ordered = algorithm == Algorithm::LINEAR ||
+                       (traits::associative && algorithm == Algorithm::RECURSIVE_DOUBLING);
+  if (algorithm == Algorithm::AUTO) {
+    return traits::associative && collective == Collective::ALLREDUCE ? Algorithm::RECURSIVE_DOUBLING
+                                                                       : Algorithm::LINEAR;
+  }
+  if (!ordered) {
+    throw std::invalid_argument(std::string("Algorithm ") + algorithm_name(algorithm) +
+                                " needs commutative and associative reduction op");
+  }
+  return algorithm;
+}
+
+}  // namespace detail
+
+template <typename T>
+void broadcast(const boost::mpi::communicator &comm, T *values, int n, int root,
+               Algorithm algorithm = Algorithm::AUTO) {
+  static_assert(std::is_trivially_copyable_v<T>, "Collectives transfer bytes of contiguous values");
+  const auto count = static_cast<size_t>(n);
+  if (comm.size() == 1 || count == 0) return;
+  if (algorithm == Algorithm::AUTO) {
+    algorithm = select_algorithm(Collective::BCAST, count * sizeof(T), count, comm.size());
+  }
+  const int tag = detail::tag_of(Collective::BCAST);
+  switch (algorithm) {
+    case Algorithm::BINOMIAL:
+      detail::binomial_bcast(comm, values, count, root, tag);
+      break;
+    case Algorithm::SCATTER_ALLGATHER:
+      detail::scatter_allgather_bcast(comm, values, count, root, tag);
+      break;
+    case Algorithm::PIPELINED_CHAIN:
+    case Algorithm::PIPELINED_BINARY:
+      detail::pipelined_bcast(comm, values, count, root, algorithm == Algorithm::PIPELINED_BINARY,
+                              thresholds().bcast_segment_bytes, tag);
+      break;
+    default:
+      detail::unavailable(algorithm, "broadcast");
+  }
+}
+
+// out_values are used on root only
+template <typename T, typename Op>
+void reduce(const boost::mpi::communicator &comm, const T *in_values, int n, T *out_values, Op op, int root,
+            Algorithm algorithm = Algorithm::AUTO) {
+  static_assert(std::is_trivially_copyable_v<T>, "Collectives transfer bytes of contiguous values");
+  const auto count = static_cast<size_t>(n);
+  algorithm =
+      detail::reduction_algorithm<Op>(algorithm, Collective::REDUCE, count * sizeof(T), count, comm.size());
+  const int tag = detail::tag_of(Collective::REDUCE);
+  if (algorithm == Algorithm::LINEAR) {
+    detail::linear_reduce(comm, in_values, out_values, count, op, root, tag);
+    return;
+  }
+  std::vector<T> local;
+  T *acc = out_values;
+  if (comm.rank() != root) {
+    local.assign(in_values, in_values + count);
+    acc = local.data();
+  } else if (in_values != out_values) {
+    std::copy(in_values, in_values + count, out_values);
+  }
+  if (comm.size() == 1 || count == 0) return;
+  switch (algorithm) {
+    case Algorithm::BINOMIAL:
+      detail::binomial_reduce(comm, acc, count, op, root, tag);
+      break;
+    case Algorithm::RABENSEIFNER:
+      detail::rabenseifner(comm, acc, count, op, root, tag);
+      break;
+    default:
+      detail::unavailable(algorithm, "reduce");
+  }
+}
+
+template <typename T, typename Op>
+void all_reduce(const boost::mpi::communicator &comm, const T *in_values, int n, T *out_values, Op op,
+                Algorithm algorithm = Algorithm::AUTO) {
+  static_assert(std::is_trivially_copyable_v<T>, "Collectives transfer bytes of contiguous values");
+  const auto count = static_cast<size_t>(n);
+  if (in_values != out_values) std::copy(in_values, in_values + count, out_values);
+  algorithm =
+      detail::reduction_algorithm<Op>(algorithm, Collective::ALLREDUCE, count * sizeof(T), count, comm.size());
+  if (comm.size() == 1 || count == 0) return;
+  const int tag = detail::tag_of(Collective::ALLREDUCE);
+  switch (algorithm) {
+    case Algorithm::LINEAR:
+      detail::linear_reduce(comm, out_values, out_values, count, op, 0, tag);
+      detail::binomial_bcast(comm, out_values, count, 0, tag);
+      break;
+    case Algorithm::BINOMIAL:
+      detail::binomial_reduce(comm, out_values, count, op, 0, tag);
+      detail::binomial_bcast(comm, out_values, count, 0, tag);
+      break;
+    case Algorithm::RECURSIVE_DOUBLING:
+      detail::recursive_doubling_allreduce(comm, out_values, count, op, tag);
+      break;
+    case Algorithm::RABENSEIFNER:
+      detail::rabenseifner(comm, out_values, count, op, -1, tag);
+      break;
+    case Algorithm::RING:
+      detail::ring_allreduce(comm, out_values, count, op, tag);
+      break;
+    default:
+      detail::unavailable(algorithm, "all_reduce");
+  }
+}
+
+// values of r-th rank are sizes[r] values at displs[r] of in_values of root, sizes and displs are used on root
+template <typename T>
+void scatterv(const boost::mpi::communicator &comm, const T *in_values, const std::vector<int> &sizes,
+              const std::vector<int> &displs, T *out_values, int out_size, int root) {
+  static_assert(std::is_trivially_copyable_v<T>, "Collectives transfer bytes of contiguous values");
+  const int tag = detail::tag_of(Collective::SCATTER);
+  if (comm.rank() != root) {
+    detail::recv(comm, out_values, out_size, root, tag);
+    return;
+  }
+  std::vector<MPI_Request> requests;
+  for (int r = 0; r < comm.size(); r++) {
+    if (r == root) {
+      std::copy_n(in_values + displs[r], sizes[r], out_values);
+      continue;
+    }
+    requests.emplace_back();
+    MPI_Isend(in_values + displs[r], detail::message_bytes(sizes[r], sizeof(T)), MPI_BYTE, r, tag, comm,
+              &requests.back());
+  }
+  MPI_Waitall(static_cast<int>(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+}
+
+// in_size values of every rank are stored at displs[r] of out_values of root, sizes and displs are used on root
+template <typename T>
+void gatherv(const boost::mpi::communicator &comm, const T *in_values, int in_size, T *out_values,
+             const std::vector<int> &sizes, const std::vector<int> &displs, int root) {
+  static_assert(std::is_trivially_copyable_v<T>, "Collectives transfer bytes of contiguous values");
+  const int tag = detail::tag_of(Collective::GATHER);
+  if (comm.rank() != root) {
+    detail::send(comm, in_values, in_size, root, tag);
+    return;
+  }
+  std::vector<MPI_Request> requests;
+  for (int r = 0; r < comm.size(); r++) {
+    if (r == root) {
+      std::copy_n(in_values, in_size, out_values + displs[r]);
+      continue;
+    }
+    requests.emplace_back();
+    MPI_Irecv(out_values + displs[r], detail::message_bytes(sizes[r], sizeof(T)), MPI_BYTE, r, tag, comm,
+              &requests.back());
+  }
+  MPI_Waitall(static_cast<int>(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+}
+
+// n values of every rank are stored in out_values of root in order of ranks, out_values are used on root only
+template <typename T>
+void gather(const boost::mpi::communicator &comm, const T *in_values, int n, T *out_values, int root,
+            Algorithm algorithm = Algorithm::AUTO) {
+  static_assert(std::is_trivially_copyable_v<T>, "Collectives transfer bytes of contiguous values");
+  const auto count = static_cast<size_t>(n);
+  const int size = comm.size();
+  const int rank = comm.rank();
+  if (algorithm == Algorithm::AUTO) {
+    algorithm = select_algorithm(Collective::GATHER, count * sizeof(T) * size, count, size);
+  }
+  const int tag = detail::tag_of(Collective::GATHER);
+  if (algorithm == Algorithm::LINEAR) {
+    std::vector<int> counts(size, n);
+    std::vector<int> displs(size);
+    for (int r = 0; r < size; r++) displs[r] = r * n;
+    ppc::coll::gatherv(comm, in_values, n, out_values, counts, displs, root);
+    return;
+  }
+  if (algorithm != Algorithm::BINOMIAL) detail::unavailable(algorithm, "gather");
+  // subtree of rank relative to root is stored in order of relative ranks
+  const int relative = (rank - root + size) % size;
+  int subtree = 1;
+  while (subtree < size && (relative & subtree) == 0) subtree <<= 1;
+  std::vector<T> tmp(static_cast<size_t>(std::min(subtree, size - relative)) * count);
+  std::copy(in_values, in_values + count, tmp.begin());
+  for (int mask = 1; mask < size; mask <<= 1) {
+    if ((relative & mask) != 0) {
+      detail::send(comm, tmp.data(), tmp.size(), (rank - mask + size) % size, tag);
+      return;
+    }
+    if (relative + mask < size) {
+      auto child = static_cast<size_t>(std::min(mask, size - relative - mask));
+      detail::recv(comm, tmp.data() + mask * count, child * count, (rank + mask) % size, tag);
+    }
+  }
+  for (int r = 0; r < size; r++) {
+    std::copy_n(tmp.begin() + static_cast<std::ptrdiff_t>(r * count), count, out_values + ((r + root) % size) * count);
+  }
+}
+
+// n values of r-th rank are taken at r * n of in_values of root, in_values are used on root only
+template <typename T>
+void scatter(const boost::mpi::communicator &comm, const T *in_values, T *out_values, int n, int root,
+             Algorithm algorithm = Algorithm::AUTO) {
+  static_assert(std::is_trivially_copyable_v<T>, "Collectives transfer bytes of contiguous values");
+  const auto count = static_cast<size_t>(n);
+  const int size = comm.size();
+  const int rank = comm.rank();
+  if (algorithm == Algorithm::AUTO) {
+    algorithm = select_algorithm(Collective::SCATTER, count * sizeof(T) * size, count, size);
+  }
+  const int tag = detail::tag_of(Collective::SCATTER);
+  if (algorithm == Algorithm::LINEAR) {
+    std::vector<int> counts(size, n);
+    std::vector<int> displs(size);
+    for (int r = 0; r < size; r++) displs[r] = r * n;
+    ppc::coll::scatterv(comm, in_values, counts, displs, out_values, n, root);
+    return;
+  }
+  if (algorithm != Algorithm::BINOMIAL) detail::unavailable(algorithm, "scatter");
+  // blocks of subtree of rank relative to root in order of relative ranks
+  const int relative = (rank - root + size) % size;
+  std::vector<T> tmp;
+  int mask = 1;
+  if (rank == root) {
+    tmp.resize(count * size);
+    for (int r = 0; r < size; r++) {
+      std::copy_n(in_values + ((r + root) % size) * count, count, tmp.begin() + static_cast<std::ptrdiff_t>(r * count));
+    }
+    while (mask < size) mask <<= 1;
+  } else {
+    while ((relative & mask) == 0) mask <<= 1;
+    tmp.resize(static_cast<size_t>(std::min(mask, size - relative)) * count);
+    detail::recv(comm, tmp.data(), tmp.size(), (rank - mask + size) % size, tag);
+  }
+  for (mask >>= 1; mask > 0; mask >>= 1) {
+    if (relative + mask < size) {
+      auto child = static_cast<size_t>(std::min(mask, size - relative - mask));
+      detail::send(comm, tmp.data() + mask * count, child * count, (rank + mask) % size, tag);
+    }
+  }
+  std::copy_n(tmp.begin(), count, out_values);
+}
+
+// n values of every rank are stored in out_values of all ranks in order of ranks
+template <typename T>
+void all_gather(const boost::mpi::communicator &comm, const T *in_values, int n, T *out_values,
+                Algorithm algorithm = Algorithm::AUTO) {
+  static_assert(std::is_trivially_copyable_v<T>, "Collectives transfer bytes of contiguous values");
+  const auto count = static_cast<size_t>(n);
+  const int size = comm.size();
+  const int rank = comm.rank();
+  if (out_values + rank * count != in_values) std::copy_n(in_values, count, out_values + rank * count);
+  if (size == 1 || count == 0) return;
+  if (algorithm == Algorithm::AUTO) {
+    algorithm = select_algorithm(Collective::ALLGATHER, count * sizeof(T) * size, count, size);
+  }
+  const int tag = detail::tag_of(Collective::ALLGATHER);
+  if (algorithm == Algorithm::RECURSIVE_DOUBLING && detail::floor_pow2(size) == size) {
+    for (int mask = 1; mask < size; mask <<= 1) {
+      const int partner = rank ^ mask;
+      detail::sendrecv(comm, out_values + (rank / mask) * mask * count, mask * count, partner,
+                       out_values + (partner / mask) * mask * count, mask * count, partner, tag);
+    }
+    return;
+  }
+  if (algorithm != Algorithm::RING && algorithm != Algorithm::RECURSIVE_DOUBLING) {
+    detail::unavailable(algorithm, "all_gather");
+  }
+  const int left = (rank - 1 + size) % size;
+  const int right = (rank + 1) % size;
+  for (int step = 0; step < size - 1; step++) {
+    const int send_block = (rank - step + size) % size;
+    const int recv_block = (rank - step - 1 + size) % size;
+    detail::sendrecv(comm, out_values + send_block * count, count, right, out_values + recv_block * count, count, left,
+                     tag);
+  }
+}
+
+}  // namespace ppc::coll
+
+#endif  // MODULES_CORE_INCLUDE_COLL_MPI_HPP_
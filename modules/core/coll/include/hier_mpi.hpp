@@ -0,0 +1,231 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_HIER_MPI_HPP_
+#define MODULES_CORE_INCLUDE_HIER_MPI_HPP_
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <boost/mpi/collectives.hpp>
+#include <boost/mpi/communicator.hpp>
+#include <cstddef>
+#include <cstring>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "core/backend/include/backend.hpp"
+#include "core/coll/include/coll_mpi.hpp"
+#include "core/coll/include/reduce_ops.hpp"
+#include "core/hybrid/include/hybrid_mpi.hpp"
+
+// Two-level node-aware collectives. Ranks of one node exchange values through MPI-3 shared memory window,
+// only one leader per node takes part in inter-node phase by ppc::coll algorithm, then results are read from
+// shared memory by all ranks of node. Inter-node traffic drops by count of ranks per node.
+namespace ppc::coll {
+
+class NodeHierarchy {
+ public:
+  // Construction is collective over comm, node is communicator of ranks of comm sharing memory
+  explicit NodeHierarchy(const boost::mpi::communicator &comm)
+      : NodeHierarchy(comm, ppc::core::node_communicator(comm)) {}
+  // Node may be any split of comm into groups of ranks which can share memory
+  NodeHierarchy(boost::mpi::communicator comm, boost::mpi::communicator node)
+      : comm_(std::move(comm)), node_(std::move(node)) {
+    MPI_Comm leaders;
+    MPI_Comm_split(comm_, is_leader() ? 0 : MPI_UNDEFINED, comm_.rank(), &leaders);
+    if (leaders != MPI_COMM_NULL) leaders_ = boost::mpi::communicator(leaders, boost::mpi::comm_take_ownership);
+    int node_index = is_leader() ? leaders_.rank() : 0;
+    MPI_Bcast(&node_index, 1, MPI_INT, 0, node_);
+    boost::mpi::all_gather(comm_, node_index, node_of_);
+    boost::mpi::all_gather(node_, comm_.rank(), node_ranks_);
+  }
+  NodeHierarchy(const NodeHierarchy &) = delete;
+  NodeHierarchy &operator=(const NodeHierarchy &) = delete;
+  // Frees shared window, so destruction is collective over node
+  ~NodeHierarchy() { release(); }
+
+  [[nodiscard]] const boost::mpi::communicator &comm() const { return comm_; }
+  [[nodiscard]] const boost::mpi::communicator &node() const { return node_; }
+  // Communicator of leaders, valid on leaders only
+  [[nodiscard]] const boost::mpi::communicator &leaders() const { return leaders_; }
+  [[nodiscard]] bool is_leader() const { return node_.rank() == 0; }
+  [[nodiscard]] int node_of(int rank) const { return node_of_[rank]; }
+
+  template <typename T>
+  void broadcast(T *values, int n, int root) {
+    static_assert(std::is_trivially_copyable_v<T>, "Collectives transfer bytes of contiguous values");
+    const size_t bytes = static_cast<size_t>(n) * sizeof(T);
+    if (n == 0) return;
+    reserve(bytes, bytes);
+    if (comm_.rank() == root) std::memcpy(slot(node_.rank()), values, bytes);
+    sync();
+    if (node_of_[root] == node_of_[comm_.rank()] && is_leader()) {
+      std::memcpy(result(), slot(local_rank_of(root)), bytes);
+    }
+    if (is_leader() && leaders_.size() > 1) ppc::coll::broadcast(leaders_, shared<T>(result()), n, node_of_[root]);
+    sync();
+    if (comm_.rank() != root) std::memcpy(values, result(), bytes);
+  }
+
+  // out_values are used on root only
+  template <typename T, typename Op>
+  void reduce(const T *in_values, int n, T *out_values, Op op, int root) {
+    // values of node are combined in order of node ranks, so order of comm ranks can't be kept
+    if constexpr (!reduction_traits<Op>::commutative) {
+      ppc::coll::reduce(comm_, in_values, n, out_values, op, root);
+    } else {
+      if (n == 0) return;
+      node_reduce(in_values, static_cast<size_t>(n), op);
+      if (is_leader() && leaders_.size() > 1) {
+        ppc::coll::reduce(leaders_, shared<T>(result()), n, shared<T>(result()), op, node_of_[root]);
+      }
+      sync();
+      if (comm_.rank() == root) std::memcpy(out_values, result(), n * sizeof(T));
+    }
+  }
+
+  template <typename T, typename Op>
+  void all_reduce(const T *in_values, int n, T *out_values, Op op) {
+    if constexpr (!reduction_traits<Op>::commutative) {
+      ppc::coll::all_reduce(comm_, in_values, n, out_values, op);
+    } else {
+      if (n == 0) return;
+      node_reduce(in_values, static_cast<size_t>(n), op);
+      if (is_leader() && leaders_.size() > 1) {
+        ppc::coll::all_reduce(leaders_, shared<T>(result()), n, shared<T>(result()), op);
+      }
+      sync();
+      std::memcpy(out_values, result(), n * sizeof(T));
+    }
+  }
+
+  // n values of every rank are stored in out_values of root in order of ranks, out_values are used on root only
+  template <typename T>
+  void gather(const T *in_values, int n, T *out_values, int root) {
+    static_assert(std::is_trivially_copyable_v<T>, "Collectives transfer bytes of contiguous values");
+    const auto count = static_cast<size_t>(n);
+    if (n == 0) return;
+    const bool root_node = node_of_[root] == node_of_[comm_.rank()];
+    reserve(count * sizeof(T), root_node ? comm_.size() * count * sizeof(T) : 0);
+    std::memcpy(slot(node_.rank()), in_values, count * sizeof(T));
+    sync();
+    if (is_leader()) leader_gather(count, shared<T>(result()), root);
+    sync();
+    if (comm_.rank() == root) std::memcpy(out_values, result(), comm_.size() * count * sizeof(T));
+  }
+
+ private:
+  static constexpr size_t ALIGNMENT = 64;
+
+  template <typename T>
+  static T *shared(std::byte *bytes) {
+    return reinterpret_cast<T *>(bytes);
+  }
+
+  // Every rank of node combines its block of elements over slots of all ranks of node into shared result
+  template <typename T, typename Op>
+  void node_reduce(const T *in_values, size_t count, Op &op) {
+    static_assert(std::is_trivially_copyable_v<T>, "Collectives transfer bytes of contiguous values");
+    reserve(count * sizeof(T), count * sizeof(T));
+    std::memcpy(slot(node_.rank()), in_values, count * sizeof(T));
+    sync();
+    const auto size = static_cast<size_t>(node_.size());
+    auto [first, last] = ppc::core::block_range(0, count, size, static_cast<size_t>(node_.rank()));
+    T *acc = shared<T>(result()) + first;
+    std::copy(shared<T>(slot(0)) + first, shared<T>(slot(0)) + last, acc);
+    for (int r = 1; r < node_.size(); r++) detail::combine(acc, shared<T>(slot(r)) + first, last - first, op, false);
+    sync();
+  }
+
+  // Leaders gather blocks of their nodes ordered by rank, leader of root's node puts values in order of ranks
+  template <typename T>
+  void leader_gather(size_t count, T *ordered, int root) {
+    // ranks of node in order of comm ranks
+    std::vector<int> local(node_.size());
+    std::iota(local.begin(), local.end(), 0);
+    std::sort(local.begin(), local.end(), [&](int a, int b) { return node_ranks_[a] < node_ranks_[b]; });
+    std::vector<T> block(local.size() * count);
+    for (size_t i = 0; i < local.size(); i++) {
+      std::memcpy(block.data() + i * count, slot(local[i]), count * sizeof(T));
+    }
+    const int leaders_root = node_of_[root];
+    // ranks of comm ordered by node, then by rank, as blocks come in gather
+    std::vector<int> order(comm_.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return node_of_[a] < node_of_[b]; });
+    if (leaders_.rank() != leaders_root) {
+      ppc::coll::gatherv(leaders_, block.data(), static_cast<int>(block.size()), static_cast<T *>(nullptr), {}, {},
+                         leaders_root);
+      return;
+    }
+    std::vector<int> sizes(leaders_.size(), 0);
+    for (int rank = 0; rank < comm_.size(); rank++) sizes[node_of_[rank]] += static_cast<int>(count);
+    std::vector<int> displs(leaders_.size(), 0);
+    std::partial_sum(sizes.begin(), sizes.end() - 1, displs.begin() + 1);
+    std::vector<T> gathered(comm_.size() * count);
+    ppc::coll::gatherv(leaders_, block.data(), static_cast<int>(block.size()), gathered.data(), sizes, displs,
+                       leaders_root);
+    for (size_t i = 0; i < order.size(); i++) {
+      std::memcpy(ordered + order[i] * count, gathered.data() + i * count, count * sizeof(T));
+    }
+  }
+
+  // Window holds slot of slot_bytes for every rank of node and shared result of result_bytes, it's reallocated
+  // only when it grows, so all ranks of node have to reserve the same sizes
+  void reserve(size_t slot_bytes, size_t result_bytes) {
+    slot_bytes = (slot_bytes + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+    if (win_ != MPI_WIN_NULL && slot_bytes <= slot_bytes_ && result_bytes <= result_bytes_) return;
+    release();
+    slot_bytes_ = std::max(slot_bytes, slot_bytes_);
+    result_bytes_ = std::max(result_bytes, result_bytes_);
+    // whole window is allocated by leader, so it's contiguous
+    const auto size = static_cast<MPI_Aint>(is_leader() ? slot_bytes_ * node_.size() + result_bytes_ : 0);
+    void *local = nullptr;
+    MPI_Win_allocate_shared(size, 1, MPI_INFO_NULL, node_, &local, &win_);
+    MPI_Aint segment = 0;
+    int disp_unit = 0;
+    void *base = nullptr;
+    MPI_Win_shared_query(win_, 0, &segment, &disp_unit, &base);
+    base_ = static_cast<std::byte *>(base);
+    MPI_Win_lock_all(MPI_MODE_NOCHECK, win_);
+  }
+
+  void release() {
+    if (win_ == MPI_WIN_NULL) return;
+    MPI_Win_unlock_all(win_);
+    MPI_Win_free(&win_);
+    base_ = nullptr;
+  }
+
+  // Stores of node ranks to window before sync are visible to all of them after it
+  void sync() {
+    MPI_Win_sync(win_);
+    MPI_Barrier(node_);
+    MPI_Win_sync(win_);
+  }
+
+  std::byte *slot(int node_rank) { return base_ + node_rank * slot_bytes_; }
+  std::byte *result() { return base_ + node_.size() * slot_bytes_; }
+
+  int local_rank_of(int rank) const {
+    return static_cast<int>(std::find(node_ranks_.begin(), node_ranks_.end(), rank) - node_ranks_.begin());
+  }
+
+  boost::mpi::communicator comm_;
+  boost::mpi::communicator node_;
+  boost::mpi::communicator leaders_{MPI_COMM_NULL, boost::mpi::comm_attach};
+  // index of node of every rank of comm, equal to rank of its leader in leaders
+  std::vector<int> node_of_;
+  // rank of comm of every rank of node
+  std::vector<int> node_ranks_;
+  MPI_Win win_ = MPI_WIN_NULL;
+  std::byte *base_ = nullptr;
+  size_t slot_bytes_ = 0;
+  size_t result_bytes_ = 0;
+};
+
+}  // namespace ppc::coll
+
+#endif  // MODULES_CORE_INCLUDE_HIER_MPI_HPP_
@@ -0,0 +1,185 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_ICOLL_MPI_HPP_
+#define MODULES_CORE_INCLUDE_ICOLL_MPI_HPP_
+
+#include <mpi.h>
+
+#include <boost/mpi/communicator.hpp>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "core/coll/include/reduce_ops.hpp"
+
+// Non-blocking reduce and all_reduce of trivially copyable T. They start MPI-3 MPI_Ireduce / MPI_Iallreduce with
+// MPI operation made of Op, so reduction progresses inside MPI while rank computes, and return request to
+// complete it. Op is default constructed by MPI operation, so it can't hold state, and MPI keeps order of ranks
+// if its reduction_traits say it isn't commutative.
+// Buffers have to stay valid and input unchanged until request is completed.
+namespace ppc::coll {
+
+namespace detail {
+
+// Contiguous datatype of sizeof(T) bytes, so MPI never splits value when it applies operation to part of buffer
+template <typename T>
+MPI_Datatype value_type() {
+  static const MPI_Datatype type = [] {
+    MPI_Datatype contiguous;
+    MPI_Type_contiguous(static_cast<int>(sizeof(T)), MPI_BYTE, &contiguous);
+    MPI_Type_commit(&contiguous);
+    return contiguous;
+  }();
+  return type;
+}
+
+// inout[i] = op(in[i], inout[i]), in holds values of lower ranks
+template <typename T, typename Op>
+void apply_op(void *in, void *inout, int *len, MPI_Datatype * /*type*/) {
+  Op op;
+  const auto *in_values = static_cast<const T *>(in);
+  auto *inout_values = static_cast<T *>(inout);
+  for (int i = 0; i < *len; i++) inout_values[i] = op(in_values[i], inout_values[i]);
+}
+
+template <typename T, typename Op>
+MPI_Op op_of() {
+  static_assert(std::is_default_constructible_v<Op>, "MPI operation constructs Op, so it can't capture state");
+  static const MPI_Op op = [] {
+    MPI_Op created;
+    MPI_Op_create(&apply_op<T, Op>, reduction_traits<Op>::commutative ? 1 : 0, &created);
+    return created;
+  }();
+  return op;
+}
+
+}  // namespace detail
+
+// Pending non-blocking collective, destructor waits for completion so buffers are never written after it
+class Request {
+ public:
+  Request() = default;
+  explicit Request(MPI_Request request) : request_(request) {}
+  Request(const Request &) = delete;
+  Request &operator=(const Request &) = delete;
+  Request(Request &&other) noexcept : request_(std::exchange(other.request_, MPI_REQUEST_NULL)) {}
+  Request &operator=(Request &&other) noexcept {
+    if (this != &other) {
+      wait();
+      request_ = std::exchange(other.request_, MPI_REQUEST_NULL);
+    }
+    return *this;
+  }
+  ~Request() { wait(); }
+
+  bool active() const { return request_ != MPI_REQUEST_NULL; }
+  // Progresses collective, true if it's completed
+  bool test() {
+    if (!active()) return true;
+    int flag = 0;
+    MPI_Test(&request_, &flag, MPI_STATUS_IGNORE);
+    return flag != 0;
+  }
+  void wait() {
+    if (active()) MPI_Wait(&request_, MPI_STATUS_IGNORE);
+  }
+
+ private:
+  MPI_Request request_ = MPI_REQUEST_NULL;
+};
+
+// Non-blocking reduction of single value, owns its buffers so it can be moved while pending
+template <typename T>
+class Future {
+ public:
+  template <typename Start>
+  Future(const T &value, Start start) : values_(std::make_unique<Values>(Values{value, value})) {
+    request_ = start(&values_->in, &values_->out);
+  }
+  Future(Future &&) noexcept = default;
+  Future &operator=(Future &&) = delete;
+
+  bool test() { return request_.test(); }
+  // Waits for completion, result is defined on every rank for all_reduce and on root for reduce
+  const T &get() {
+    request_.wait();
+    return values_->out;
+  }
+
+ private:
+  struct Values {
+    T in;
+    T out;
+  };
+  std::unique_ptr<Values> values_;
+  // declared after values_, so it's completed before they're freed
+  Request request_;
+};
+
+// out_values are used on root only
+template <typename T, typename Op>
+Request ireduce(const boost::mpi::communicator &comm, const T *in_values, int n, T *out_values, Op /*op*/,
+                int root) {
+  static_assert(std::is_trivially_copyable_v<T>, "Collectives transfer bytes of contiguous values");
+  if (n < 0) throw std::invalid_argument("Count of ireduce is negative");
+  MPI_Request request;
+  MPI_Ireduce(in_values, out_values, n, detail::value_type<T>(), detail::op_of<T, Op>(), root, comm, &request);
+  return Request(request);
+}
+
+template <typename T, typename Op>
+Request iall_reduce(const boost::mpi::communicator &comm, const T *in_values, int n, T *out_values, Op /*op*/) {
+  static_assert(std::is_trivially_copyable_v<T>, "Collectives transfer bytes of contiguous values");
+  if (n < 0) throw std::invalid_argument("Count of iall_reduce is negative");
+  MPI_Request request;
+  MPI_Iallreduce(in_values, out_values, n, detail::value_type<T>(), detail::op_of<T, Op>(), comm, &request);
+  return Request(request);
+}
+
+template <typename T, typename Op>
+Future<T> ireduce(const boost::mpi::communicator &comm, const T &in_value, Op op, int root) {
+  return Future<T>(in_value, [&](const T *in, T *out) { return ireduce(comm, in, 1, out, op, root); });
+}
+
+template <typename T, typename Op>
+Future<T> iall_reduce(const boost::mpi::communicator &comm, const T &in_value, Op op) {
+  return Future<T>(in_value, [&](const T *in, T *out) { return iall_reduce(comm, in, 1, out, op); });
+}
+
+// Convergence check of iterative solver, which hides latency of all_reduce of residual: residual of every
+// check_every-th iteration is reduced while next iteration is computed, so decision comes one iteration late,
+// but it's taken by all ranks on the same iteration
+template <typename T, typename Op>
+class ConvergenceCheck {
+ public:
+  explicit ConvergenceCheck(const boost::mpi::communicator &comm, int check_every = 1, Op op = Op())
+      : comm_(comm), check_every_(check_every), op_(op) {
+    if (check_every < 1) throw std::invalid_argument("Convergence has to be checked at least every iteration");
+  }
+
+  // Called by all ranks once per iteration with local residual, returns reduced residual of earlier iteration
+  // if its reduction is completed by this call
+  std::optional<T> update(const T &local_residual) {
+    std::optional<T> residual;
+    if (pending_) {
+      residual = pending_->get();
+      pending_.reset();
+    }
+    if (iteration_ % check_every_ == 0) pending_.emplace(iall_reduce(comm_, local_residual, op_));
+    iteration_++;
+    return residual;
+  }
+
+ private:
+  boost::mpi::communicator comm_;
+  int check_every_;
+  Op op_;
+  int iteration_ = 0;
+  std::optional<Future<T>> pending_;
+};
+
+}  // namespace ppc::coll
+
+#endif  // MODULES_CORE_INCLUDE_ICOLL_MPI_HPP_
@@ -0,0 +1,199 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_REDUCE_OPS_HPP_
+#define MODULES_CORE_INCLUDE_REDUCE_OPS_HPP_
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+// Typed reduction operators. Operator is functor type over value_type with traits
+//   static value_type identity()         op(identity(), x) == x
+//   static constexpr bool commutative    op(a, b) == op(b, a)
+//   static constexpr bool associative    op(op(a, b), c) == op(a, op(b, c))
+// Calls of functor are inlined, so element-wise combines of arrays compile to plain (vectorizable) loops.
+// Functors without traits, like std::plus or lambdas, are taken as commutative and associative.
+namespace ppc::coll {
+
+template <typename Op, typename = void>
+struct reduction_traits {
+  static constexpr bool has_identity = false;
+  static constexpr bool commutative = true;
+  static constexpr bool associative = true;
+};
+
+template <typename Op>
+struct reduction_traits<Op,
+                        std::void_t<decltype(Op::identity()), decltype(Op::commutative), decltype(Op::associative)>> {
+  static constexpr bool has_identity = true;
+  static constexpr bool commutative = Op::commutative;
+  static constexpr bool associative = Op::associative;
+};
+
+template <typename T>
+struct Sum {
+  using value_type = T;
+  static constexpr bool commutative = true;
+  static constexpr bool associative = true;
+  static constexpr T identity() { return T(0); }
+  constexpr T operator()(const T &a, const T &b) const { return a + b; }
+};
+
+template <typename T>
+struct Prod {
+  using value_type = T;
+  static constexpr bool commutative = true;
+  static constexpr bool associative = true;
+  static constexpr T identity() { return T(1); }
+  constexpr T operator()(const T &a, const T &b) const { return a * b; }
+};
+
+template <typename T>
+struct Min {
+  using value_type = T;
+  static constexpr bool commutative = true;
+  static constexpr bool associative = true;
+  static constexpr T identity() {
+    if constexpr (std::numeric_limits<T>::has_infinity) return std::numeric_limits<T>::infinity();
+    return std::numeric_limits<T>::max();
+  }
+  constexpr T operator()(const T &a, const T &b) const { return b < a ? b : a; }
+};
+
+template <typename T>
+struct Max {
+  using value_type = T;
+  static constexpr bool commutative = true;
+  static constexpr bool associative = true;
+  static constexpr T identity() {
+    if constexpr (std::numeric_limits<T>::has_infinity) return -std::numeric_limits<T>::infinity();
+    return std::numeric_limits<T>::lowest();
+  }
+  constexpr T operator()(const T &a, const T &b) const { return a < b ? b : a; }
+};
+
+template <typename T>
+struct LogicalAnd {
+  using value_type = T;
+  static constexpr bool commutative = true;
+  static constexpr bool associative = true;
+  static constexpr T identity() { return T(1); }
+  constexpr T operator()(const T &a, const T &b) const { return static_cast<T>(a && b); }
+};
+
+template <typename T>
+struct LogicalOr {
+  using value_type = T;
+  static constexpr bool commutative = true;
+  static constexpr bool associative = true;
+  static constexpr T identity() { return T(0); }
+  constexpr T operator()(const T &a, const T &b) const { return static_cast<T>(a || b); }
+};
+
+template <typename T>
+struct LogicalXor {
+  using value_type = T;
+  static constexpr bool commutative = true;
+  static constexpr bool associative = true;
+  static constexpr T identity() { return T(0); }
+  constexpr T operator()(const T &a, const T &b) const { return static_cast<T>(!a != !b); }
+};
+
+template <typename T>
+struct BitAnd {
+  using value_type = T;
+  static constexpr bool commutative = true;
+  static constexpr bool associative = true;
+  static constexpr T identity() { return static_cast<T>(~T(0)); }
+  constexpr T operator()(const T &a, const T &b) const { return a & b; }
+};
+
+template <typename T>
+struct BitOr {
+  using value_type = T;
+  static constexpr bool commutative = true;
+  static constexpr bool associative = true;
+  static constexpr T identity() { return T(0); }
+  constexpr T operator()(const T &a, const T &b) const { return a | b; }
+};
+
+template <typename T>
+struct BitXor {
+  using value_type = T;
+  static constexpr bool commutative = true;
+  static constexpr bool associative = true;
+  static constexpr T identity() { return T(0); }
+  constexpr T operator()(const T &a, const T &b) const { return a ^ b; }
+};
+
+template <typename T, typename Index = int>
+struct IndexedValue {
+  T value;
+  Index index;
+};
+
+// Ties go to lower index, so result doesn't depend on order of combines
+template <typename T, typename Index = int>
+struct ArgMin {
+  using value_type = IndexedValue<T, Index>;
+  static constexpr bool commutative = true;
+  static constexpr bool associative = true;
+  static constexpr value_type identity() { return {Min<T>::identity(), std::numeric_limits<Index>::max()}; }
+  constexpr value_type operator()(const value_type &a, const value_type &b) const {
+    return (b.value < a.value || (!(a.value < b.value) && b.index < a.index)) ? b : a;
+  }
+};
+
+template <typename T, typename Index = int>
+struct ArgMax {
+  using value_type = IndexedValue<T, Index>;
+  static constexpr bool commutative = true;
+  static constexpr bool associative = true;
+  static constexpr value_type identity() { return {Max<T>::identity(), std::numeric_limits<Index>::max()}; }
+  constexpr value_type operator()(const value_type &a, const value_type &b) const {
+    return (a.value < b.value || (!(b.value < a.value) && b.index < a.index)) ? b : a;
+  }
+};
+
+template <typename T>
+struct CompensatedValue {
+  T sum;
+  // low-order bits lost by sum
+  T compensation;
+};
+
+// Kahan-Babuska (Neumaier) sum, error of rounding is accumulated separately and added to result at the end.
+// It's commutative and associative up to rounding, the same as Sum of floating point values.
+template <typename T>
+struct KahanSum {
+  using value_type = CompensatedValue<T>;
+  static constexpr bool commutative = true;
+  static constexpr bool associative = true;
+  static constexpr value_type identity() { return {T(0), T(0)}; }
+  // adds single value
+  value_type operator()(const value_type &a, const T &x) const {
+    T sum = a.sum + x;
+    T error = std::abs(a.sum) >= std::abs(x) ? (a.sum - sum) + x : (x - sum) + a.sum;
+    return {sum, a.compensation + error};
+  }
+  // combines partial sums
+  value_type operator()(const value_type &a, const value_type &b) const {
+    value_type sum = (*this)(a, b.sum);
+    return {sum.sum, sum.compensation + b.compensation};
+  }
+  static T result(const value_type &value) { return value.sum + value.compensation; }
+};
+
+// Reduction of n values by op starting from identity, values may be of value_type of op or of what it adds
+template <typename Op, typename T>
+typename Op::value_type fold(const T *values, size_t n, Op op = Op()) {
+  static_assert(reduction_traits<Op>::has_identity, "Fold starts from identity of reduction op");
+  auto acc = Op::identity();
+  for (size_t i = 0; i < n; i++) acc = op(acc, values[i]);
+  return acc;
+}
+
+}  // namespace ppc::coll
+
+#endif  // MODULES_CORE_INCLUDE_REDUCE_OPS_HPP_
@@ -0,0 +1,76 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/coll/include/coll.hpp"
+
+#include <algorithm>
+
+namespace {
+
+int floor_pow2(int n) {
+  int pof2 = 1;
+  while (pof2 * 2 <= n) pof2 *= 2;
+  return pof2;
+}
+
+}  // namespace
+
+ppc::coll::Thresholds &ppc::coll::thresholds() {
+  static Thresholds values;
+  return values;
+}
+
+ppc::coll::Algorithm ppc::coll::select_algorithm(Collective collective, size_t bytes, size_t count, int comm_size) {
+  const auto &limits = thresholds();
+  const auto pof2 = static_cast<size_t>(floor_pow2(comm_size));
+  const bool pow2 = pof2 == static_cast<size_t>(comm_size);
+  switch (collective) {
+    case Collective::BCAST:
+      if (bytes >= limits.bcast_pipeline_bytes) {
+        // chain takes p - 1 + segments steps, binary tree about 2 * (log(p) + segments)
+        auto segments = (bytes + limits.bcast_segment_bytes - 1) / std::max<size_t>(limits.bcast_segment_bytes, 1);
+        return segments >= static_cast<size_t>(comm_size) ? Algorithm::PIPELINED_CHAIN : Algorithm::PIPELINED_BINARY;
+      }
+      if (bytes < limits.bcast_short_bytes || comm_size < limits.bcast_min_procs) return Algorithm::BINOMIAL;
+      return Algorithm::SCATTER_ALLGATHER;
+    case Collective::REDUCE:
+      // blocks of reduce-scatter need at least one element per rank
+      if (bytes <= limits.reduce_short_bytes || count < pof2) return Algorithm::BINOMIAL;
+      return Algorithm::RABENSEIFNER;
+    case Collective::ALLREDUCE:
+      if (bytes <= limits.reduce_short_bytes || count < pof2) return Algorithm::RECURSIVE_DOUBLING;
+      // folding of extra ranks costs two more whole messages, ring doesn't need it
+      if (!pow2 && bytes >= limits.allreduce_long_bytes && count >= static_cast<size_t>(comm_size)) {
+        return Algorithm::RING;
+      }
+      return Algorithm::RABENSEIFNER;
+    case Collective::SCATTER:
+    case Collective::GATHER:
+      return bytes <= limits.gather_long_bytes ? Algorithm::BINOMIAL : Algorithm::LINEAR;
+    case Collective::ALLGATHER:
+      return pow2 && bytes < limits.allgather_short_bytes ? Algorithm::RECURSIVE_DOUBLING : Algorithm::RING;
+  }
+  return Algorithm::LINEAR;
+}
+
+const char *ppc::coll::algorithm_name(Algorithm algorithm) {
+  switch (algorithm) {
+    case Algorithm::AUTO:
+      return "auto";
+    case Algorithm::LINEAR:
+      return "linear";
+    case Algorithm::BINOMIAL:
+      return "binomial";
+    case Algorithm::RECURSIVE_DOUBLING:
+      return "recursive_doubling";
+    case Algorithm::RABENSEIFNER:
+      return "rabenseifner";
+    case Algorithm::RING:
+      return "ring";
+    case Algorithm::SCATTER_ALLGATHER:
+      return "scatter_allgather";
+    case Algorithm::PIPELINED_CHAIN:
+      return "pipelined_chain";
+    case Algorithm::PIPELINED_BINARY:
+      return "pipelined_binary";
+  }
+  return "unknown";
+}
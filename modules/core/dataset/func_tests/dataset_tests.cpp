@@ -0,0 +1,157 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "core/dataset/include/dataset.hpp"
+#include "core/gen/include/generators.hpp"
+
+namespace {
+
+std::filesystem::path test_directory(const std::string &name) {
+  auto dir = std::filesystem::temp_directory_path() / ("ppc_dataset_tests_" + name);
+  std::filesystem::remove_all(dir);
+  return dir;
+}
+
+}  // namespace
+
+TEST(dataset_tests, check_write_and_map) {
+  auto dir = test_directory("map");
+  auto path = (dir / "matrix.ppcd").string();
+  std::vector<double> matrix(30 * 7);
+  std::iota(matrix.begin(), matrix.end(), 0.5);
+  ppc::core::write_dataset(path, ppc::core::DType::FLOAT64, {30, 7}, matrix.data());
+
+  auto dataset = ppc::core::MappedDataset::open(path);
+  EXPECT_EQ(dataset.header().dims(), std::vector<uint64_t>({30, 7}));
+  EXPECT_TRUE(dataset.verify());
+  auto values = dataset.as<double>();
+  EXPECT_EQ(std::vector<double>(values.begin(), values.end()), matrix);
+  EXPECT_THROW((void)dataset.as<float>(), std::invalid_argument);
+
+  // slice starts inside of page
+  auto rows = ppc::core::MappedDataset::open_slice(path, 11 * 7, 5 * 7);
+  auto slice = rows.as<double>();
+  EXPECT_EQ(std::vector<double>(slice.begin(), slice.end()),
+            std::vector<double>(matrix.begin() + 11 * 7, matrix.begin() + 16 * 7));
+  EXPECT_FALSE(rows.verify());
+  EXPECT_THROW(ppc::core::MappedDataset::open_slice(path, 200, 20), std::invalid_argument);
+
+  // private mapping may be modified by task without changing file
+  ppc::core::TaskData taskData;
+  ppc::core::attach_input(taskData, dataset);
+  ASSERT_EQ(taskData.inputs_count[0], matrix.size());
+  reinterpret_cast<double *>(taskData.inputs[0])[0] = -1.0;
+  EXPECT_TRUE(ppc::core::MappedDataset::open(path).verify());
+  std::filesystem::remove_all(dir);
+}
+
+TEST(dataset_tests, check_broken_files) {
+  auto dir = test_directory("broken");
+  std::filesystem::create_directories(dir);
+  auto path = (dir / "broken.ppcd").string();
+  EXPECT_THROW(ppc::core::MappedDataset::open(path), std::invalid_argument);
+  std::ofstream(path) << "not a dataset";
+  EXPECT_THROW(ppc::core::MappedDataset::open(path), std::invalid_argument);
+
+  std::vector<int32_t> data(1000, 7);
+  ppc::core::write_dataset(path, ppc::core::DType::INT32, {1000}, data.data());
+  std::filesystem::resize_file(path, std::filesystem::file_size(path) - 4);
+  EXPECT_THROW(ppc::core::MappedDataset::open(path), std::invalid_argument);
+  std::filesystem::remove_all(dir);
+}
+
+TEST(dataset_tests, check_cache_generates_once) {
+  auto dir = test_directory("cache");
+  ppc::core::DatasetCache cache(dir.string());
+  int calls = 0;
+  auto fill = [&calls](std::span<int32_t> out) {
+    calls++;
+    ppc::core::fill_uniform(out, 0, 100, 42);
+  };
+  auto first = cache.get<int32_t>("vector", 42, {5000}, fill);
+  auto second = cache.get<int32_t>("vector", 42, {5000}, fill);
+  EXPECT_EQ(first.size(), second.size());
+  EXPECT_EQ(calls, 1);
+  EXPECT_EQ(cache.generated(), 1U);
+  auto expected = ppc::core::random_vector<int32_t>(5000, 0, 100, 42);
+  auto values = second.as<int32_t>();
+  EXPECT_EQ(std::vector<int32_t>(values.begin(), values.end()), expected);
+
+  // other seed or shape is other dataset
+  EXPECT_NE(cache.path("vector", 42, ppc::core::DType::INT32, {5000}),
+            cache.path("vector", 43, ppc::core::DType::INT32, {5000}));
+  (void)cache.get<int32_t>("vector", 42, {50, 100}, fill);
+  EXPECT_EQ(calls, 2);
+
+  // broken file is generated again
+  auto path = cache.path("vector", 42, ppc::core::DType::INT32, {5000});
+  std::filesystem::resize_file(path, 100);
+  EXPECT_TRUE(cache.get<int32_t>("vector", 42, {5000}, fill).verify());
+  EXPECT_EQ(calls, 3);
+  std::filesystem::remove_all(dir);
+}
+
+TEST(dataset_tests, check_cache_regenerates_corrupted_data) {
+  auto dir = test_directory("cache_checksum");
+  ppc::core::DatasetCache cache(dir.string());
+  int calls = 0;
+  auto fill = [&calls](std::span<int32_t> out) {
+    calls++;
+    ppc::core::fill_uniform(out, 0, 100, 7);
+  };
+  // valid header, but element is changed after checksum was written
+  auto path = cache.path("vector", 7, ppc::core::DType::INT32, {1000});
+  std::filesystem::create_directories(dir);
+  auto expected = ppc::core::random_vector<int32_t>(1000, 0, 100, 7);
+  ppc::core::write_dataset(path, ppc::core::DType::INT32, {1000}, expected.data());
+  {
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(ppc::core::DatasetHeader::DATA_OFFSET);
+    const int32_t wrong = -1;
+    file.write(reinterpret_cast<const char *>(&wrong), sizeof(wrong));
+  }
+  auto dataset = cache.get<int32_t>("vector", 7, {1000}, fill);
+  EXPECT_EQ(calls, 1);
+  EXPECT_TRUE(dataset.verify());
+  auto values = dataset.as<int32_t>();
+  EXPECT_EQ(std::vector<int32_t>(values.begin(), values.end()), expected);
+  std::filesystem::remove_all(dir);
+}
+
+TEST(dataset_tests, check_cache_key_has_generator_parameters) {
+  auto dir = test_directory("cache_key");
+  ppc::core::DatasetCache cache(dir.string());
+  auto fill = [](int32_t lo, int32_t hi) {
+    return [lo, hi](std::span<int32_t> out) { ppc::core::fill_uniform(out, lo, hi, 42); };
+  };
+  EXPECT_EQ(ppc::core::generator_key("uniform", -100, 100), "uniform(-100,100)");
+  auto narrow = cache.get<int32_t>(ppc::core::generator_key("uniform", -100, 100), 42, {1000}, fill(-100, 100));
+  auto wide = cache.get<int32_t>(ppc::core::generator_key("uniform", 100, 1000), 42, {1000}, fill(100, 1000));
+  EXPECT_EQ(cache.generated(), 2U);
+  auto values = wide.as<int32_t>();
+  EXPECT_EQ(std::vector<int32_t>(values.begin(), values.end()),
+            ppc::core::random_vector<int32_t>(1000, 100, 1000, 42));
+  EXPECT_NE(cache.path(ppc::core::generator_key("uniform", -100, 100), 42, ppc::core::DType::INT32, {1000}),
+            cache.path(ppc::core::generator_key("uniform", 100, 100), 42, ppc::core::DType::INT32, {1000}));
+  std::filesystem::remove_all(dir);
+}
+
+TEST(dataset_tests, check_cache_rejects_shape_before_generating) {
+  auto dir = test_directory("cache_shape");
+  ppc::core::DatasetCache cache(dir.string());
+  int calls = 0;
+  auto fill = [&calls](std::span<int32_t> /*out*/) { calls++; };
+  EXPECT_THROW((void)cache.ensure<int32_t>("vector", 1, {2, 2, 2, 2, 2}, fill), std::invalid_argument);
+  EXPECT_THROW((void)cache.ensure<int32_t>("vector", 1, {}, fill), std::invalid_argument);
+  EXPECT_EQ(calls, 0);
+  std::filesystem::remove_all(dir);
+}
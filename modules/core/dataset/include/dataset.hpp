@@ -0,0 +1,167 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_DATASET_HPP_
+#define MODULES_CORE_INCLUDE_DATASET_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "core/task/include/task.hpp"
+
+namespace ppc::core {
+
+enum class DType : uint32_t { INT8 = 1, UINT8, INT32, UINT32, INT64, UINT64, FLOAT32, FLOAT64 };
+
+size_t dtype_size(DType dtype);
+
+template <typename T>
+constexpr DType dtype_of() {
+  if constexpr (std::is_same_v<T, int8_t>) {
+    return DType::INT8;
+  } else if constexpr (std::is_same_v<T, uint8_t>) {
+    return DType::UINT8;
+  } else if constexpr (std::is_same_v<T, int32_t>) {
+    return DType::INT32;
+  } else if constexpr (std::is_same_v<T, uint32_t>) {
+    return DType::UINT32;
+  } else if constexpr (std::is_same_v<T, int64_t>) {
+    return DType::INT64;
+  } else if constexpr (std::is_same_v<T, uint64_t>) {
+    return DType::UINT64;
+  } else if constexpr (std::is_same_v<T, float>) {
+    return DType::FLOAT32;
+  } else if constexpr (std::is_same_v<T, double>) {
+    return DType::FLOAT64;
+  } else {
+    static_assert(sizeof(T) == 0, "Type is not supported by datasets");
+  }
+}
+
+// Header of dataset file, elements follow at DATA_OFFSET (page aligned, so slices are mapped directly)
+struct DatasetHeader {
+  static constexpr std::array<char, 8> MAGIC = {'P', 'P', 'C', 'D', 'A', 'T', 'A', '1'};
+  static constexpr size_t MAX_DIMS = 4;
+  static constexpr uint64_t DATA_OFFSET = 4096;
+
+  std::array<char, 8> magic = MAGIC;
+  DType dtype = DType::UINT8;
+  uint32_t num_dims = 0;
+  std::array<uint64_t, MAX_DIMS> shape = {};
+  // FNV-1a over 8-byte words of elements
+  uint64_t checksum = 0;
+
+  [[nodiscard]] uint64_t num_elements() const;
+  [[nodiscard]] uint64_t data_bytes() const { return num_elements() * dtype_size(dtype); }
+  [[nodiscard]] std::vector<uint64_t> dims() const { return {shape.begin(), shape.begin() + num_dims}; }
+};
+
+uint64_t dataset_checksum(const void *data, size_t bytes);
+
+// Write elements to dataset file, file appears atomically (written to temporary file and renamed)
+void write_dataset(const std::string &path, DType dtype, const std::vector<uint64_t> &shape, const void *data);
+
+// Read-only view of dataset file mapped to memory (private copy-on-write mapping, so task may modify it);
+// pages are read on first access only. Slice maps elements [first, first + count) only.
+// Throws std::invalid_argument for missing file, wrong header, size or type
+class MappedDataset {
+ public:
+  static MappedDataset open(const std::string &path);
+  static MappedDataset open_slice(const std::string &path, uint64_t first, uint64_t count);
+
+  MappedDataset() = default;
+  MappedDataset(const MappedDataset &) = delete;
+  MappedDataset &operator=(const MappedDataset &) = delete;
+  MappedDataset(MappedDataset &&other) noexcept;
+  MappedDataset &operator=(MappedDataset &&other) noexcept;
+  ~MappedDataset();
+
+  [[nodiscard]] const DatasetHeader &header() const { return info; }
+  [[nodiscard]] uint8_t *data() const { return begin; }
+  [[nodiscard]] uint64_t size() const { return count; }
+  [[nodiscard]] uint64_t first_element() const { return first; }
+
+  template <typename T>
+  [[nodiscard]] std::span<T> as() const {
+    if (dtype_of<T>() != info.dtype) throw std::invalid_argument("Type doesn't match dtype of dataset");
+    return {reinterpret_cast<T *>(begin), count};
+  }
+  // Checksum of elements matches header, whole dataset only
+  [[nodiscard]] bool verify() const;
+
+ private:
+  void unmap();
+
+  DatasetHeader info;
+  void *mapping = nullptr;
+  size_t mapping_bytes = 0;
+  // fallback storage where files can't be mapped
+  std::vector<uint8_t> buffer;
+  uint8_t *begin = nullptr;
+  uint64_t first = 0;
+  uint64_t count = 0;
+};
+
+// Append mapped elements to inputs of taskData, throws std::invalid_argument for more than UINT32_MAX elements
+void attach_input(TaskData &taskData, const MappedDataset &dataset);
+
+// Key of generator with its parameters, e.g. generator_key("uniform", -100, 100) is "uniform(-100,100)"
+template <typename... Params>
+std::string generator_key(const std::string &name, const Params &...params) {
+  std::ostringstream key;
+  key << name << '(';
+  size_t i = 0;
+  ((key << (i++ > 0 ? "," : "") << params), ...);
+  key << ')';
+  return key.str();
+}
+
+// Directory of datasets keyed by generator, seed and shape (default PPC_DATASET_CACHE or
+// <temp>/ppc_datasets). Generator has to name all parameters of data besides seed and shape (see
+// generator_key), otherwise datasets of other parameters are taken from cache. Dataset is generated and
+// written once, later runs only map the file; checksum of cached file is checked once per process. Default directory is local to node, so MPI runs on several
+// nodes generate dataset on every node (see ensure_on_nodes) unless PPC_DATASET_CACHE is on shared storage.
+class DatasetCache {
+ public:
+  explicit DatasetCache(std::string directory = {});
+
+  [[nodiscard]] const std::string &directory() const { return dir; }
+  [[nodiscard]] std::string path(const std::string &generator, uint64_t seed, DType dtype,
+                                 const std::vector<uint64_t> &shape) const;
+
+  // Create dataset with fill if it's missing or invalid, returns path of dataset.
+  // Throws std::invalid_argument for shape of 0 or more than MAX_DIMS dimensions
+  template <typename T>
+  std::string ensure(const std::string &generator, uint64_t seed, const std::vector<uint64_t> &shape,
+                     const std::function<void(std::span<T>)> &fill) {
+    return ensure_bytes(generator, seed, dtype_of<T>(), shape, [&fill](void *data, uint64_t num_elements) {
+      fill(std::span<T>(static_cast<T *>(data), num_elements));
+    });
+  }
+  template <typename T>
+  MappedDataset get(const std::string &generator, uint64_t seed, const std::vector<uint64_t> &shape,
+                    const std::function<void(std::span<T>)> &fill) {
+    return MappedDataset::open(ensure(generator, seed, shape, fill));
+  }
+
+  // count of datasets generated by this cache
+  [[nodiscard]] uint64_t generated() const { return num_generated; }
+
+ private:
+  std::string ensure_bytes(const std::string &generator, uint64_t seed, DType dtype,
+                           const std::vector<uint64_t> &shape, const std::function<void(void *, uint64_t)> &fill);
+
+  std::string dir;
+  uint64_t num_generated = 0;
+};
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_DATASET_HPP_
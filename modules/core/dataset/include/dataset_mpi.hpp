@@ -0,0 +1,63 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_DATASET_MPI_HPP_
+#define MODULES_CORE_INCLUDE_DATASET_MPI_HPP_
+
+#include <boost/mpi/collectives.hpp>
+#include <boost/mpi/communicator.hpp>
+#include <cstdint>
+#include <functional>
+#include <exception>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "core/backend/include/backend.hpp"
+#include "core/dataset/include/dataset.hpp"
+#include "core/hybrid/include/hybrid_mpi.hpp"
+
+namespace ppc::core {
+
+// Leader of every node creates dataset if it's missing in its cache directory, which is usually local to
+// node. Other ranks wait for their leader, so all ranks of world may open returned path. Leaders write the
+// file atomically, so they may share directory. Collective over world.
+template <typename T>
+std::string ensure_on_nodes(const boost::mpi::communicator &world, DatasetCache &cache, const std::string &generator,
+                            uint64_t seed, const std::vector<uint64_t> &shape,
+                            const std::function<void(std::span<T>)> &fill) {
+  auto node = node_communicator(world);
+  std::string path;
+  // error of any leader is thrown on all ranks, so none of them waits for others forever
+  std::string error;
+  if (node.rank() == 0) {
+    try {
+      path = cache.ensure<T>(generator, seed, shape, fill);
+    } catch (const std::exception &e) {
+      error = e.what();
+    }
+  }
+  boost::mpi::broadcast(node, path, 0);
+  boost::mpi::broadcast(node, error, 0);
+  const bool failed = boost::mpi::all_reduce(world, !error.empty(), std::logical_or<>());
+  if (!error.empty()) throw std::invalid_argument(error);
+  if (failed) throw std::invalid_argument("Dataset " + path + " can't be created on other node");
+  return path;
+}
+
+// Dataset is ensured on every node, then every rank maps nearly equal block of rows (first dimension) of
+// dataset, so inputs are neither generated on every rank nor scattered
+template <typename T>
+MappedDataset map_rank_rows(const boost::mpi::communicator &world, DatasetCache &cache, const std::string &generator,
+                            uint64_t seed, const std::vector<uint64_t> &shape,
+                            const std::function<void(std::span<T>)> &fill) {
+  auto path = ensure_on_nodes<T>(world, cache, generator, seed, shape, fill);
+  uint64_t row_elements = 1;
+  for (size_t i = 1; i < shape.size(); i++) row_elements *= shape[i];
+  auto [lo, hi] = block_range(0, shape.at(0), world.size(), world.rank());
+  return MappedDataset::open_slice(path, lo * row_elements, (hi - lo) * row_elements);
+}
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_DATASET_MPI_HPP_
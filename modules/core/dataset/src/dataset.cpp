@@ -0,0 +1,322 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/dataset/include/dataset.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+constexpr uint64_t FNV_OFFSET = 14695981039346656037ULL;
+constexpr uint64_t FNV_PRIME = 1099511628211ULL;
+
+std::string get_env(const char *name) {
+#ifdef _MSC_VER
+  char *buf = nullptr;
+  size_t len = 0;
+  if (_dupenv_s(&buf, &len, name) != 0 || buf == nullptr) return {};
+  std::string value(buf);
+  free(buf);
+  return value;
+#else
+  const char *value = std::getenv(name);
+  return value != nullptr ? value : "";
+#endif
+}
+
+const char *dtype_name(ppc::core::DType dtype) {
+  switch (dtype) {
+    case ppc::core::DType::INT8:
+      return "i8";
+    case ppc::core::DType::UINT8:
+      return "u8";
+    case ppc::core::DType::INT32:
+      return "i32";
+    case ppc::core::DType::UINT32:
+      return "u32";
+    case ppc::core::DType::INT64:
+      return "i64";
+    case ppc::core::DType::UINT64:
+      return "u64";
+    case ppc::core::DType::FLOAT32:
+      return "f32";
+    case ppc::core::DType::FLOAT64:
+      return "f64";
+  }
+  return "unknown";
+}
+
+bool valid_dtype(ppc::core::DType dtype) {
+  return static_cast<uint32_t>(dtype) >= static_cast<uint32_t>(ppc::core::DType::INT8) &&
+         static_cast<uint32_t>(dtype) <= static_cast<uint32_t>(ppc::core::DType::FLOAT64);
+}
+
+// Header of existing valid dataset, throws std::invalid_argument otherwise
+ppc::core::DatasetHeader read_header(const std::string &path) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file.is_open()) throw std::invalid_argument("Can't open dataset " + path);
+  ppc::core::DatasetHeader header;
+  file.read(reinterpret_cast<char *>(&header), sizeof(header));
+  if (!file || header.magic != ppc::core::DatasetHeader::MAGIC || !valid_dtype(header.dtype) ||
+      header.num_dims > ppc::core::DatasetHeader::MAX_DIMS) {
+    throw std::invalid_argument("Invalid header of dataset " + path);
+  }
+  if (std::filesystem::file_size(path) < ppc::core::DatasetHeader::DATA_OFFSET + header.data_bytes()) {
+    throw std::invalid_argument("Truncated dataset " + path);
+  }
+  return header;
+}
+
+void check_shape(const std::vector<uint64_t> &shape) {
+  if (shape.empty() || shape.size() > ppc::core::DatasetHeader::MAX_DIMS) {
+    throw std::invalid_argument("Dataset must have from 1 to " + std::to_string(ppc::core::DatasetHeader::MAX_DIMS) +
+                                " dimensions");
+  }
+}
+
+// Paths of datasets checked or written by this process, checksum of cached file is checked on its first reuse
+class VerifiedPaths {
+ public:
+  bool contains(const std::string &path) {
+    std::lock_guard<std::mutex> lock(mutex);
+    return paths.count(path) > 0;
+  }
+  void insert(const std::string &path) {
+    std::lock_guard<std::mutex> lock(mutex);
+    paths.insert(path);
+  }
+
+ private:
+  std::mutex mutex;
+  std::set<std::string> paths;
+};
+
+VerifiedPaths verified_paths;
+
+}  // namespace
+
+size_t ppc::core::dtype_size(DType dtype) {
+  switch (dtype) {
+    case DType::INT8:
+    case DType::UINT8:
+      return 1;
+    case DType::INT32:
+    case DType::UINT32:
+    case DType::FLOAT32:
+      return 4;
+    case DType::INT64:
+    case DType::UINT64:
+    case DType::FLOAT64:
+      return 8;
+  }
+  throw std::invalid_argument("Unknown dtype");
+}
+
+uint64_t ppc::core::DatasetHeader::num_elements() const {
+  uint64_t elements = num_dims > 0 ? 1 : 0;
+  for (uint32_t i = 0; i < num_dims; i++) elements *= shape[i];
+  return elements;
+}
+
+uint64_t ppc::core::dataset_checksum(const void *data, size_t bytes) {
+  const auto *ptr = static_cast<const uint8_t *>(data);
+  uint64_t hash = FNV_OFFSET;
+  size_t i = 0;
+  for (; i + 8 <= bytes; i += 8) {
+    uint64_t word = 0;
+    std::memcpy(&word, ptr + i, 8);
+    hash = (hash ^ word) * FNV_PRIME;
+  }
+  for (; i < bytes; i++) hash = (hash ^ ptr[i]) * FNV_PRIME;
+  return hash;
+}
+
+void ppc::core::write_dataset(const std::string &path, DType dtype, const std::vector<uint64_t> &shape,
+                              const void *data) {
+  check_shape(shape);
+  DatasetHeader header;
+  header.dtype = dtype;
+  header.num_dims = static_cast<uint32_t>(shape.size());
+  std::copy(shape.begin(), shape.end(), header.shape.begin());
+  header.checksum = dataset_checksum(data, header.data_bytes());
+
+  namespace fs = std::filesystem;
+  fs::path target(path);
+  if (target.has_parent_path()) fs::create_directories(target.parent_path());
+  // several processes may create the same dataset, each one writes its own file and rename is atomic
+  auto tmp = target;
+  tmp += ".tmp" + std::to_string(std::random_device()());
+  {
+    std::ofstream file(tmp, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) throw std::invalid_argument("Can't write dataset " + path);
+    std::vector<char> header_block(DatasetHeader::DATA_OFFSET, 0);
+    std::memcpy(header_block.data(), &header, sizeof(header));
+    file.write(header_block.data(), static_cast<std::streamsize>(header_block.size()));
+    file.write(static_cast<const char *>(data), static_cast<std::streamsize>(header.data_bytes()));
+    if (!file) throw std::invalid_argument("Can't write dataset " + path);
+  }
+  fs::rename(tmp, target);
+}
+
+ppc::core::MappedDataset ppc::core::MappedDataset::open(const std::string &path) {
+  auto header = read_header(path);
+  auto dataset = open_slice(path, 0, header.num_elements());
+  return dataset;
+}
+
+ppc::core::MappedDataset ppc::core::MappedDataset::open_slice(const std::string &path, uint64_t first,
+                                                              uint64_t count) {
+  MappedDataset dataset;
+  dataset.info = read_header(path);
+  if (first > dataset.info.num_elements() || count > dataset.info.num_elements() - first) {
+    throw std::invalid_argument("Slice is out of dataset " + path);
+  }
+  dataset.first = first;
+  dataset.count = count;
+  if (count == 0) return dataset;
+  const auto element_size = dtype_size(dataset.info.dtype);
+  const uint64_t offset = DatasetHeader::DATA_OFFSET + first * element_size;
+  const uint64_t bytes = count * element_size;
+#ifndef _WIN32
+  const auto page = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+  const uint64_t map_offset = offset / page * page;
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd >= 0) {
+    auto map_bytes = static_cast<size_t>(offset - map_offset + bytes);
+    void *ptr = mmap(nullptr, map_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, static_cast<off_t>(map_offset));
+    ::close(fd);
+    if (ptr != MAP_FAILED) {
+      dataset.mapping = ptr;
+      dataset.mapping_bytes = map_bytes;
+      dataset.begin = static_cast<uint8_t *>(ptr) + (offset - map_offset);
+      return dataset;
+    }
+  }
+#endif
+  std::ifstream file(path, std::ios::binary);
+  dataset.buffer.resize(bytes);
+  file.seekg(static_cast<std::streamoff>(offset));
+  file.read(reinterpret_cast<char *>(dataset.buffer.data()), static_cast<std::streamsize>(bytes));
+  if (!file) throw std::invalid_argument("Can't read dataset " + path);
+  dataset.begin = dataset.buffer.data();
+  return dataset;
+}
+
+ppc::core::MappedDataset::MappedDataset(MappedDataset &&other) noexcept { *this = std::move(other); }
+
+ppc::core::MappedDataset &ppc::core::MappedDataset::operator=(MappedDataset &&other) noexcept {
+  if (this != &other) {
+    unmap();
+    info = other.info;
+    mapping = std::exchange(other.mapping, nullptr);
+    mapping_bytes = std::exchange(other.mapping_bytes, 0);
+    // moved vector keeps its storage, so begin stays valid
+    buffer = std::move(other.buffer);
+    begin = std::exchange(other.begin, nullptr);
+    first = std::exchange(other.first, 0);
+    count = std::exchange(other.count, 0);
+  }
+  return *this;
+}
+
+ppc::core::MappedDataset::~MappedDataset() { unmap(); }
+
+void ppc::core::MappedDataset::unmap() {
+#ifndef _WIN32
+  if (mapping != nullptr) munmap(mapping, mapping_bytes);
+#endif
+  mapping = nullptr;
+  mapping_bytes = 0;
+  buffer.clear();
+  begin = nullptr;
+}
+
+bool ppc::core::MappedDataset::verify() const {
+  if (first != 0 || count != info.num_elements()) return false;
+  return dataset_checksum(begin, info.data_bytes()) == info.checksum;
+}
+
+void ppc::core::attach_input(TaskData &taskData, const MappedDataset &dataset) {
+  if (dataset.size() > UINT32_MAX) {
+    throw std::invalid_argument("Dataset of " + std::to_string(dataset.size()) +
+                                " elements doesn't fit count of task inputs");
+  }
+  taskData.inputs.emplace_back(dataset.data());
+  taskData.inputs_count.emplace_back(static_cast<uint32_t>(dataset.size()));
+}
+
+ppc::core::DatasetCache::DatasetCache(std::string directory) : dir(std::move(directory)) {
+  if (dir.empty()) dir = get_env("PPC_DATASET_CACHE");
+  if (dir.empty()) dir = (std::filesystem::temp_directory_path() / "ppc_datasets").string();
+}
+
+std::string ppc::core::DatasetCache::path(const std::string &generator, uint64_t seed, DType dtype,
+                                          const std::vector<uint64_t> &shape) const {
+  std::string name = generator;
+  std::replace_if(
+      name.begin(), name.end(), [](char c) { return !std::isalnum(static_cast<unsigned char>(c)) && c != '_'; }, '_');
+  // parameters like "(-100,100)" and "(100,100)" may become the same name, so hash of whole key tells them apart
+  if (name != generator) {
+    std::ostringstream hash;
+    hash << std::hex << std::setw(16) << std::setfill('0') << dataset_checksum(generator.data(), generator.size());
+    name += "_h";
+    name += hash.str();
+  }
+  name += "_s";
+  name += std::to_string(seed);
+  name += '_';
+  for (size_t i = 0; i < shape.size(); i++) {
+    if (i > 0) name += 'x';
+    name += std::to_string(shape[i]);
+  }
+  name += '_';
+  name += dtype_name(dtype);
+  name += ".ppcd";
+  return (std::filesystem::path(dir) / name).string();
+}
+
+std::string ppc::core::DatasetCache::ensure_bytes(const std::string &generator, uint64_t seed, DType dtype,
+                                                  const std::vector<uint64_t> &shape,
+                                                  const std::function<void(void *, uint64_t)> &fill) {
+  check_shape(shape);
+  auto file = path(generator, seed, dtype, shape);
+  try {
+    auto header = read_header(file);
+    if (header.dtype == dtype && header.dims() == shape &&
+        (verified_paths.contains(file) || MappedDataset::open(file).verify())) {
+      verified_paths.insert(file);
+      return file;
+    }
+  } catch (const std::invalid_argument &) {
+    // missing or broken file is generated again
+  }
+  DatasetHeader header;
+  header.dtype = dtype;
+  header.num_dims = static_cast<uint32_t>(shape.size());
+  std::copy(shape.begin(), shape.end(), header.shape.begin());
+  // 8-byte words keep elements of every dtype aligned
+  std::vector<uint64_t> data((header.data_bytes() + 7) / 8);
+  fill(data.data(), header.num_elements());
+  write_dataset(file, dtype, shape, data.data());
+  verified_paths.insert(file);
+  num_generated++;
+  return file;
+}
@@ -0,0 +1,88 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "core/backend/include/backend.hpp"
+#include "core/gen/include/generators.hpp"
+#include "core/gen/include/philox.hpp"
+
+TEST(gen_tests, check_philox_known_answers) {
+  // Known answer tests of Random123 for philox4x32_10
+  EXPECT_EQ(ppc::core::Philox4x32(0)({0, 0, 0, 0}),
+            ppc::core::Philox4x32::Block({0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}));
+  EXPECT_EQ(ppc::core::Philox4x32(0xffffffffffffffff)({0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}),
+            ppc::core::Philox4x32::Block({0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}));
+}
+
+TEST(gen_tests, check_uniform_ranges) {
+  const ppc::core::CounterRng rng(42);
+  bool seen_lo = false;
+  bool seen_hi = false;
+  for (uint64_t i = 0; i < 10000; i++) {
+    auto value = rng.uniform(i, -3, 3);
+    ASSERT_GE(value, -3);
+    ASSERT_LE(value, 3);
+    seen_lo = seen_lo || value == -3;
+    seen_hi = seen_hi || value == 3;
+    auto real = rng.uniform(i, 1.5, 2.5);
+    ASSERT_GE(real, 1.5);
+    ASSERT_LT(real, 2.5);
+  }
+  EXPECT_TRUE(seen_lo && seen_hi);
+  EXPECT_NE(ppc::core::CounterRng(42, 1).bits(0), rng.bits(0));
+  EXPECT_NE(ppc::core::CounterRng(43).bits(0), rng.bits(0));
+}
+
+TEST(gen_tests, check_slices_match_whole_input) {
+  auto whole = ppc::core::random_vector<int>(1000, 1, 100, 7);
+  EXPECT_EQ(whole, ppc::core::random_vector<int>(1000, 1, 100, 7, 0, ppc::core::SeqExecutor()));
+  EXPECT_EQ(whole, ppc::core::random_vector<int>(1000, 1, 100, 7, 0, ppc::core::StlExecutor(5)));
+  EXPECT_NE(whole, ppc::core::random_vector<int>(1000, 1, 100, 8));
+  auto slice = ppc::core::random_vector<int>(300, 1, 100, 7, 500);
+  EXPECT_TRUE(std::equal(slice.begin(), slice.end(), whole.begin() + 500));
+
+  auto matrix = ppc::core::random_matrix<double>(20, 30, 0.0, 1.0, 7);
+  auto rows = ppc::core::random_matrix<double>(5, 30, 0.0, 1.0, 7, 10);
+  EXPECT_TRUE(std::equal(rows.begin(), rows.end(), matrix.begin() + 10 * 30));
+
+  auto points = ppc::core::random_points<float>(100, 3, -1.0F, 1.0F, 7);
+  auto tail = ppc::core::random_points<float>(10, 3, -1.0F, 1.0F, 7, 90);
+  EXPECT_TRUE(std::equal(tail.begin(), tail.end(), points.begin() + 90 * 3));
+
+  auto image = ppc::core::random_image(64, 48, 3, 7);
+  auto band = ppc::core::random_image(64, 48, 3, 7, 20, 8);
+  ASSERT_EQ(image.size(), 64U * 48U * 3U);
+  EXPECT_TRUE(std::equal(band.begin(), band.end(), image.begin() + 20 * 64 * 3));
+  EXPECT_NE(*std::min_element(image.begin(), image.end()), *std::max_element(image.begin(), image.end()));
+
+  auto text = ppc::core::random_text(1000, 7);
+  EXPECT_EQ(text.substr(400, 100), ppc::core::random_text(100, 7, 400));
+  EXPECT_EQ(text.find("  "), std::string::npos);
+  EXPECT_NE(text.find(' '), std::string::npos);
+  EXPECT_NE(text[0], ' ');
+}
+
+TEST(gen_tests, check_slae_is_diagonally_dominant) {
+  const size_t n = 50;
+  auto slae = ppc::core::random_slae<double>(n, 3);
+  ASSERT_EQ(slae.a.size(), n * n);
+  for (size_t i = 0; i < n; i++) {
+    double off_diagonal = 0.0;
+    double product = 0.0;
+    for (size_t j = 0; j < n; j++) {
+      if (j != i) off_diagonal += std::abs(slae.a[i * n + j]);
+      product += slae.a[i * n + j] * slae.x[j];
+    }
+    EXPECT_GT(std::abs(slae.a[i * n + i]), off_diagonal);
+    EXPECT_NEAR(product, slae.b[i], 1e-9);
+  }
+  auto rows = ppc::core::random_slae<double>(n, 3, 45);
+  ASSERT_EQ(rows.b.size(), 5U);
+  EXPECT_TRUE(std::equal(rows.a.begin(), rows.a.end(), slae.a.begin() + 45 * n));
+  EXPECT_TRUE(std::equal(rows.b.begin(), rows.b.end(), slae.b.begin() + 45));
+}
@@ -0,0 +1,103 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_GENERATORS_HPP_
+#define MODULES_CORE_INCLUDE_GENERATORS_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "core/backend/include/backend.hpp"
+#include "core/gen/include/philox.hpp"
+
+namespace ppc::core {
+
+// Deterministic parallel generation of task inputs. Every element is a function of seed and its global
+// index, so result doesn't depend on count of threads, and process can generate only its slice
+// (first element or row and count) which equals the same slice of whole input - no scatter is needed.
+
+// Streams keep different kinds of inputs generated from one seed uncorrelated
+enum class GenStream : uint64_t { VECTOR = 1, MATRIX, SLAE_MATRIX, SLAE_SOLUTION, POINTS, IMAGE, TEXT };
+
+// out[k] is element first + k of uniform sequence in [lo, hi] ([lo, hi) for floating point types)
+template <typename T, Executor Exec = StlExecutor>
+void fill_uniform(std::span<T> out, T lo, T hi, uint64_t seed, uint64_t first = 0,
+                  GenStream stream = GenStream::VECTOR, const Exec &exec = Exec()) {
+  const CounterRng rng(seed, static_cast<uint64_t>(stream));
+  exec.parallel_for(size_t{0}, out.size(), [&](size_t k) { out[k] = rng.uniform(first + k, lo, hi); });
+}
+
+// Elements [first, first + count) of random vector
+template <typename T, Executor Exec = StlExecutor>
+std::vector<T> random_vector(size_t count, T lo, T hi, uint64_t seed, uint64_t first = 0, const Exec &exec = Exec()) {
+  std::vector<T> vec(count);
+  fill_uniform(std::span<T>(vec), lo, hi, seed, first, GenStream::VECTOR, exec);
+  return vec;
+}
+
+// Rows [first_row, first_row + num_rows) of row-major random matrix with cols columns
+template <typename T, Executor Exec = StlExecutor>
+std::vector<T> random_matrix(size_t num_rows, size_t cols, T lo, T hi, uint64_t seed, uint64_t first_row = 0,
+                             const Exec &exec = Exec()) {
+  std::vector<T> matrix(num_rows * cols);
+  fill_uniform(std::span<T>(matrix), lo, hi, seed, first_row * cols, GenStream::MATRIX, exec);
+  return matrix;
+}
+
+// Rows [first_row, first_row + num_rows) of system a * x = b of size n with strictly diagonally dominant a
+// (convergent for Jacobi and Gauss-Seidel methods) and known solution x (whole, n values)
+template <typename T>
+struct Slae {
+  std::vector<T> a;
+  std::vector<T> b;
+  std::vector<T> x;
+};
+
+template <typename T, Executor Exec = StlExecutor>
+Slae<T> random_slae(size_t n, uint64_t seed, uint64_t first_row = 0, size_t num_rows = SIZE_MAX,
+                    const Exec &exec = Exec()) {
+  num_rows = std::min<size_t>(num_rows, n - std::min<size_t>(first_row, n));
+  Slae<T> slae{std::vector<T>(num_rows * n), std::vector<T>(num_rows), std::vector<T>(n)};
+  const CounterRng matrix_rng(seed, static_cast<uint64_t>(GenStream::SLAE_MATRIX));
+  fill_uniform(std::span<T>(slae.x), T(-10), T(10), seed, 0, GenStream::SLAE_SOLUTION, exec);
+  exec.parallel_for(size_t{0}, num_rows, [&](size_t k) {
+    auto row = first_row + k;
+    T *a = slae.a.data() + k * n;
+    T off_diagonal{};
+    for (size_t j = 0; j < n; j++) {
+      a[j] = matrix_rng.uniform(row * n + j, T(-1), T(1));
+      if (j != row) off_diagonal += std::abs(a[j]);
+    }
+    a[row] = off_diagonal + T(1) + std::abs(a[row]);
+    T b{};
+    for (size_t j = 0; j < n; j++) b += a[j] * slae.x[j];
+    slae.b[k] = b;
+  });
+  return slae;
+}
+
+// Points [first, first + count) of cloud with dim coordinates uniform in [lo, hi), point after point
+template <typename T, Executor Exec = StlExecutor>
+std::vector<T> random_points(size_t count, size_t dim, T lo, T hi, uint64_t seed, uint64_t first = 0,
+                             const Exec &exec = Exec()) {
+  std::vector<T> points(count * dim);
+  fill_uniform(std::span<T>(points), lo, hi, seed, first * dim, GenStream::POINTS, exec);
+  return points;
+}
+
+// Rows [first_row, first_row + num_rows) of 8-bit width x height image with interleaved channels:
+// gradient with random bright blobs and noise, so filters and segmentation get non-trivial content
+std::vector<uint8_t> random_image(size_t width, size_t height, size_t channels, uint64_t seed, uint64_t first_row = 0,
+                                  size_t num_rows = SIZE_MAX);
+
+// Characters [first, first + count) of text of words from alphabet separated by single spaces
+std::string random_text(size_t count, uint64_t seed, uint64_t first = 0,
+                        const std::string &alphabet = "abcdefghijklmnopqrstuvwxyz");
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_GENERATORS_HPP_
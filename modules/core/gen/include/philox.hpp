@@ -0,0 +1,92 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_PHILOX_HPP_
+#define MODULES_CORE_INCLUDE_PHILOX_HPP_
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace ppc::core {
+
+// Philox4x32-10 counter-based generator (Salmon et al., "Parallel random numbers: as easy as 1, 2, 3"):
+// 128 random bits are a pure function of key and 128-bit counter, so any element of random sequence
+// is computed directly without state and in any order
+class Philox4x32 {
+ public:
+  using Block = std::array<uint32_t, 4>;
+
+  constexpr explicit Philox4x32(uint64_t key)
+      : key0(static_cast<uint32_t>(key)), key1(static_cast<uint32_t>(key >> 32)) {}
+
+  [[nodiscard]] constexpr Block operator()(Block counter) const {
+    uint32_t k0 = key0;
+    uint32_t k1 = key1;
+    for (int round = 0; round < ROUNDS; round++) {
+      auto product0 = static_cast<uint64_t>(M0) * counter[0];
+      auto product1 = static_cast<uint64_t>(M1) * counter[2];
+      counter = {static_cast<uint32_t>(product1 >> 32) ^ counter[1] ^ k0, static_cast<uint32_t>(product1),
+                 static_cast<uint32_t>(product0 >> 32) ^ counter[3] ^ k1, static_cast<uint32_t>(product0)};
+      k0 += W0;
+      k1 += W1;
+    }
+    return counter;
+  }
+
+ private:
+  static constexpr int ROUNDS = 10;
+  static constexpr uint32_t M0 = 0xD2511F53;
+  static constexpr uint32_t M1 = 0xCD9E8D57;
+  static constexpr uint32_t W0 = 0x9E3779B9;
+  static constexpr uint32_t W1 = 0xBB67AE85;
+  uint32_t key0;
+  uint32_t key1;
+};
+
+// Random values indexed by position: value of index depends on seed, stream and index only,
+// so slices of one sequence generated by different threads or processes are the same as whole sequence
+class CounterRng {
+ public:
+  constexpr explicit CounterRng(uint64_t seed, uint64_t stream = 0) : philox(seed), stream(stream) {}
+
+  [[nodiscard]] constexpr Philox4x32::Block block(uint64_t index) const {
+    return philox({static_cast<uint32_t>(index), static_cast<uint32_t>(index >> 32), static_cast<uint32_t>(stream),
+                   static_cast<uint32_t>(stream >> 32)});
+  }
+  [[nodiscard]] constexpr uint64_t bits(uint64_t index) const {
+    auto words = block(index);
+    return (static_cast<uint64_t>(words[1]) << 32) | words[0];
+  }
+  // [0, 1) with 53 random bits
+  [[nodiscard]] constexpr double uniform01(uint64_t index) const {
+    return static_cast<double>(bits(index) >> 11) * 0x1.0p-53;
+  }
+  // [lo, hi] for integral types, [lo, hi) for floating point types
+  template <typename T>
+  [[nodiscard]] constexpr T uniform(uint64_t index, T lo, T hi) const {
+    if constexpr (std::is_floating_point_v<T>) {
+      return static_cast<T>(lo + (hi - lo) * uniform01(index));
+    } else {
+      auto range = static_cast<uint64_t>(hi) - static_cast<uint64_t>(lo);
+      if (range == std::numeric_limits<uint64_t>::max()) return static_cast<T>(bits(index));
+      range++;
+      uint64_t offset = 0;
+      if (range <= (uint64_t{1} << 32)) {
+        // multiply-shift maps 32 random bits to range without division
+        offset = (static_cast<uint64_t>(block(index)[0]) * range) >> 32;
+      } else {
+        offset = bits(index) % range;
+      }
+      return static_cast<T>(static_cast<uint64_t>(lo) + offset);
+    }
+  }
+
+ private:
+  Philox4x32 philox;
+  uint64_t stream;
+};
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_PHILOX_HPP_
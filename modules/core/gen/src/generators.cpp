@@ -0,0 +1,68 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/gen/include/generators.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Blob {
+  double x;
+  double y;
+  double radius;
+  double brightness;
+};
+
+constexpr size_t NUM_BLOBS = 8;
+constexpr double SPACE_PROBABILITY = 1.0 / 6.0;
+
+}  // namespace
+
+std::vector<uint8_t> ppc::core::random_image(size_t width, size_t height, size_t channels, uint64_t seed,
+                                             uint64_t first_row, size_t num_rows) {
+  num_rows = std::min<size_t>(num_rows, height - std::min<size_t>(first_row, height));
+  std::vector<uint8_t> image(width * num_rows * channels);
+  const CounterRng rng(seed, static_cast<uint64_t>(GenStream::IMAGE));
+  // Blobs come first in the stream and are the same for every slice, noise is indexed after them
+  std::vector<Blob> blobs(NUM_BLOBS);
+  for (size_t i = 0; i < NUM_BLOBS; i++) {
+    auto scale = static_cast<double>(std::max(width, height));
+    blobs[i] = {rng.uniform(4 * i, 0.0, static_cast<double>(width)),
+                rng.uniform(4 * i + 1, 0.0, static_cast<double>(height)),
+                rng.uniform(4 * i + 2, 0.02 * scale, 0.15 * scale), rng.uniform(4 * i + 3, 60.0, 160.0)};
+  }
+  const uint64_t noise_offset = 4 * NUM_BLOBS;
+  StlExecutor().parallel_for(size_t{0}, num_rows, [&](size_t k) {
+    auto y = static_cast<double>(first_row + k);
+    for (size_t x = 0; x < width; x++) {
+      double value = 64.0 * static_cast<double>(x) / static_cast<double>(std::max<size_t>(width, 1));
+      for (const auto &blob : blobs) {
+        auto dx = static_cast<double>(x) - blob.x;
+        auto dy = y - blob.y;
+        value += blob.brightness * std::exp(-(dx * dx + dy * dy) / (2.0 * blob.radius * blob.radius));
+      }
+      for (size_t c = 0; c < channels; c++) {
+        auto index = ((first_row + k) * width + x) * channels + c;
+        auto noisy = value + rng.uniform(noise_offset + index, -16.0, 16.0);
+        image[(k * width + x) * channels + c] = static_cast<uint8_t>(std::clamp(noisy, 0.0, 255.0));
+      }
+    }
+  });
+  return image;
+}
+
+std::string ppc::core::random_text(size_t count, uint64_t seed, uint64_t first, const std::string &alphabet) {
+  std::string text(count, ' ');
+  if (alphabet.empty()) return text;
+  const CounterRng rng(seed, static_cast<uint64_t>(GenStream::TEXT));
+  // Position is a space if it is a space candidate and previous one is not, so words never are empty
+  auto candidate = [&](uint64_t position) { return position > 0 && rng.uniform01(position) < SPACE_PROBABILITY; };
+  StlExecutor().parallel_for(size_t{0}, count, [&](size_t k) {
+    auto position = first + k;
+    if (candidate(position) && !candidate(position - 1)) return;
+    text[k] = alphabet[rng.block(position)[2] % alphabet.size()];
+  });
+  return text;
+}
@@ -0,0 +1,64 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "core/backend/include/backend.hpp"
+#include "core/hybrid/include/hybrid.hpp"
+
+TEST(hybrid_tests, check_single_rank_takes_all_cpus) {
+  std::vector<int> all;
+  for (const auto &info : ppc::core::cpu_topology()) all.push_back(info.cpu);
+  std::sort(all.begin(), all.end());
+
+  auto layout = ppc::core::hybrid_layout(0, 1);
+  EXPECT_EQ(layout.placement.affinity, ppc::core::AffinityPolicy::EXPLICIT);
+  EXPECT_EQ(layout.placement.cpus, all);
+  EXPECT_EQ(layout.threads, ppc::core::default_num_threads(static_cast<int>(all.size())));
+  EXPECT_EQ(layout.describe().rfind("rank 0/1 of node: domain ", 0), 0U);
+}
+
+TEST(hybrid_tests, check_ranks_split_cpus_of_node) {
+  const auto &topology = ppc::core::cpu_topology();
+  const bool bound = std::thread::hardware_concurrency() > topology.size();
+  for (int node_size = 1; node_size <= 4; node_size++) {
+    std::vector<int> taken;
+    for (int node_rank = 0; node_rank < node_size; node_rank++) {
+      auto layout = ppc::core::hybrid_layout(node_rank, node_size);
+      ASSERT_FALSE(layout.placement.cpus.empty());
+      EXPECT_GE(layout.threads, 1);
+      for (int cpu : layout.placement.cpus) {
+        auto info = std::find_if(topology.begin(), topology.end(), [cpu](const auto &c) { return c.cpu == cpu; });
+        ASSERT_NE(info, topology.end());
+        EXPECT_EQ(info->node, layout.domain);
+      }
+      taken.insert(taken.end(), layout.placement.cpus.begin(), layout.placement.cpus.end());
+    }
+    if (!bound && static_cast<size_t>(node_size) <= topology.size()) {
+      std::sort(taken.begin(), taken.end());
+      EXPECT_EQ(std::adjacent_find(taken.begin(), taken.end()), taken.end());
+      EXPECT_EQ(taken.size(), topology.size());
+    }
+  }
+  EXPECT_THROW(ppc::core::hybrid_layout(2, 2), std::invalid_argument);
+  EXPECT_THROW(ppc::core::hybrid_layout(0, 0), std::invalid_argument);
+  EXPECT_THROW(ppc::core::hybrid_layout(0, 2, 2, 2), std::invalid_argument);
+  EXPECT_THROW(ppc::core::hybrid_layout(0, 1, 0, 2), std::invalid_argument);
+}
+
+TEST(hybrid_tests, check_ranks_sharing_mask_split_it) {
+  const auto num_cpus = static_cast<int>(ppc::core::cpu_topology().size());
+  for (int node_size = 1; node_size <= std::min(num_cpus, 4); node_size++) {
+    std::vector<int> taken;
+    for (int node_rank = 0; node_rank < node_size; node_rank++) {
+      // all ranks of node are bound to the same mask or not bound at all
+      auto layout = ppc::core::hybrid_layout(node_rank, node_size, node_rank, node_size);
+      taken.insert(taken.end(), layout.placement.cpus.begin(), layout.placement.cpus.end());
+    }
+    std::sort(taken.begin(), taken.end());
+    EXPECT_EQ(std::adjacent_find(taken.begin(), taken.end()), taken.end());
+  }
+}
@@ -0,0 +1,36 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_HYBRID_HPP_
+#define MODULES_CORE_INCLUDE_HYBRID_HPP_
+
+#include <string>
+
+#include "core/affinity/include/affinity.hpp"
+
+namespace ppc::core {
+
+// Part of node taken by one rank in hybrid MPI + threads mode, see hybrid_mpi.hpp
+struct HybridLayout {
+  // rank among ranks sharing the node and their count
+  int node_rank = 0;
+  int node_size = 1;
+  // NUMA node of rank
+  int domain = 0;
+  // size of thread pool of rank
+  int threads = 1;
+  // CPUs of rank's workers, memory policy is kept from PPC_MEMORY_POLICY
+  Placement placement;
+
+  // e.g. "rank 1/2 of node: domain 1, 8 threads"
+  [[nodiscard]] std::string describe() const;
+};
+
+// Ranks of node take NUMA domains round-robin (one rank per domain is the intended launch) and ranks sharing
+// a domain split its CPUs. Process bound by launcher (mpirun --map-by numa --bind-to numa) keeps CPUs of its
+// mask, split among mask_size ranks of node bound to the same mask (mask_rank is index of rank among them).
+// Threads count is PPC_NUM_THREADS or OMP_NUM_THREADS if set, count of rank's CPUs otherwise.
+HybridLayout hybrid_layout(int node_rank, int node_size, int mask_rank = 0, int mask_size = 1);
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_HYBRID_HPP_
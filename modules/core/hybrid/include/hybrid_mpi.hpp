@@ -0,0 +1,94 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_HYBRID_MPI_HPP_
+#define MODULES_CORE_INCLUDE_HYBRID_MPI_HPP_
+
+#include <mpi.h>
+
+#include <boost/mpi/collectives.hpp>
+#include <boost/mpi/communicator.hpp>
+#include <boost/mpi/environment.hpp>
+#include <boost/serialization/vector.hpp>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "core/backend/include/backend.hpp"
+#include "core/backend/include/backend_mpi.hpp"
+#include "core/hybrid/include/hybrid.hpp"
+
+namespace ppc::core {
+
+// Thread support MPI has to be initialized with for hybrid mode: workers of a rank compute, only the thread
+// that initialized MPI communicates, e.g. boost::mpi::environment env(argc, argv, HYBRID_THREADING);
+constexpr auto HYBRID_THREADING = boost::mpi::threading::funneled;
+
+// Ranks of world sharing memory of the node with this rank
+inline boost::mpi::communicator node_communicator(const boost::mpi::communicator &world) {
+  MPI_Comm node;
+  MPI_Comm_split_type(world, MPI_COMM_TYPE_SHARED, world.rank(), MPI_INFO_NULL, &node);
+  return {node, boost::mpi::comm_take_ownership};
+}
+
+// Layout of rank among ranks of node, ranks bound by launcher to the same affinity mask split it
+inline HybridLayout node_layout(const boost::mpi::communicator &node) {
+  std::vector<int> mask;
+  for (const auto &info : cpu_topology()) mask.push_back(info.cpu);
+  std::vector<std::vector<int>> masks;
+  boost::mpi::all_gather(node, mask, masks);
+  int mask_rank = 0;
+  int mask_size = 0;
+  for (int rank = 0; rank < node.size(); rank++) {
+    if (masks[rank] != mask) continue;
+    if (rank < node.rank()) mask_rank++;
+    mask_size++;
+  }
+  return hybrid_layout(node.rank(), node.size(), mask_rank, mask_size);
+}
+
+// Hybrid MPI + threads mode: one rank per NUMA domain with persistent thread pool over CPUs of the domain, so
+// data replicated over ranks (like broadcast vectors) is stored once per domain and messages inside node are
+// replaced by shared memory. Construction is collective over world, so tasks create context lazily (e.g. in
+// pre_processing) once MPI is initialized with HYBRID_THREADING.
+class HybridContext {
+ public:
+  explicit HybridContext(boost::mpi::communicator world_ = {})
+      : world_comm(std::move(world_)),
+        node_comm(node_communicator(world_comm)),
+        rank_layout(node_layout(node_comm)),
+        pool(rank_layout.threads) {
+    if (rank_layout.threads > 1 && boost::mpi::environment::thread_level() < HYBRID_THREADING) {
+      throw std::invalid_argument("MPI is initialized without thread support, hybrid mode needs funneled level");
+    }
+  }
+  HybridContext(const HybridContext &) = delete;
+  HybridContext &operator=(const HybridContext &) = delete;
+
+  [[nodiscard]] const boost::mpi::communicator &world() const { return world_comm; }
+  [[nodiscard]] const boost::mpi::communicator &node() const { return node_comm; }
+  [[nodiscard]] const HybridLayout &layout() const { return rank_layout; }
+
+  // Makes layout current placement and pins calling thread and workers of pool to CPUs of the rank, previous
+  // placement and affinity of calling thread are restored when context is destroyed
+  void apply() {
+    if (applied) return;
+    applied.emplace(rank_layout.placement);
+    pool.for_blocks(static_cast<size_t>(pool.concurrency()), [](size_t part) { pin_worker(static_cast<int>(part)); });
+  }
+  // Thread pool of rank's own rows, threads are kept between calls
+  [[nodiscard]] const PoolExecutor &local_executor() const { return pool; }
+  // Blocks of ranks processed by their thread pools
+  [[nodiscard]] MpiExecutor<PoolExecutor> executor() const { return MpiExecutor<PoolExecutor>(world_comm, pool); }
+
+ private:
+  boost::mpi::communicator world_comm;
+  boost::mpi::communicator node_comm;
+  HybridLayout rank_layout;
+  PoolExecutor pool;
+  std::optional<PlacementScope> applied;
+};
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_HYBRID_MPI_HPP_
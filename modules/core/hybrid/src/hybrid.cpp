@@ -0,0 +1,80 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/hybrid/include/hybrid.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/backend/include/backend.hpp"
+
+std::string ppc::core::HybridLayout::describe() const {
+  return "rank " + std::to_string(node_rank) + "/" + std::to_string(node_size) + " of node: domain " +
+         std::to_string(domain) + ", " + std::to_string(threads) + " threads";
+}
+
+namespace {
+
+// share-th of sharing nearly equal parts of cpus, single CPU if there are more parts than CPUs (oversubscribed)
+std::vector<int> share_of(const std::vector<int> &cpus, size_t sharing, size_t share) {
+  auto [lo, hi] = ppc::core::block_range(0, cpus.size(), sharing, share);
+  if (lo == hi) {
+    lo = share % cpus.size();
+    hi = lo + 1;
+  }
+  return {cpus.begin() + static_cast<std::ptrdiff_t>(lo), cpus.begin() + static_cast<std::ptrdiff_t>(hi)};
+}
+
+}  // namespace
+
+ppc::core::HybridLayout ppc::core::hybrid_layout(int node_rank, int node_size, int mask_rank, int mask_size) {
+  if (node_size < 1 || node_rank < 0 || node_rank >= node_size) {
+    throw std::invalid_argument("Rank " + std::to_string(node_rank) + " is out of node of " +
+                                std::to_string(node_size) + " ranks");
+  }
+  if (mask_size < 1 || mask_size > node_size || mask_rank < 0 || mask_rank >= mask_size) {
+    throw std::invalid_argument("Rank " + std::to_string(mask_rank) + " is out of " + std::to_string(mask_size) +
+                                " ranks sharing affinity mask");
+  }
+  HybridLayout layout;
+  layout.node_rank = node_rank;
+  layout.node_size = node_size;
+
+  const auto &topology = cpu_topology();
+  std::set<int> domains;
+  for (const auto &info : topology) domains.insert(info.node);
+  const auto hardware = static_cast<size_t>(std::thread::hardware_concurrency());
+  const bool bound = hardware > topology.size();
+
+  std::vector<int> cpus;
+  if (bound || node_size == 1) {
+    // ranks bound to the same mask (e.g. --bind-to package with several ranks per package) split it
+    std::vector<int> mask;
+    for (const auto &info : topology) mask.push_back(info.cpu);
+    std::sort(mask.begin(), mask.end());
+    cpus = share_of(mask, static_cast<size_t>(mask_size), static_cast<size_t>(mask_rank));
+    auto first = std::find_if(topology.begin(), topology.end(), [&](const auto &info) { return info.cpu == cpus[0]; });
+    layout.domain = first->node;
+  } else {
+    const auto num_domains = static_cast<int>(domains.size());
+    layout.domain = *std::next(domains.begin(), node_rank % num_domains);
+    std::vector<int> domain_cpus;
+    for (const auto &info : topology) {
+      if (info.node == layout.domain) domain_cpus.push_back(info.cpu);
+    }
+    // ranks sharing the domain: node_rank % num_domains, node_rank % num_domains + num_domains, ...
+    auto sharing = static_cast<size_t>((node_size - 1 - node_rank % num_domains) / num_domains + 1);
+    auto share = static_cast<size_t>(node_rank / num_domains);
+    cpus = share_of(domain_cpus, sharing, share);
+  }
+  std::sort(cpus.begin(), cpus.end());
+
+  layout.threads = default_num_threads(static_cast<int>(cpus.size()));
+  layout.placement = current_placement();
+  layout.placement.affinity = AffinityPolicy::EXPLICIT;
+  layout.placement.cpus = cpus;
+  return layout;
+}
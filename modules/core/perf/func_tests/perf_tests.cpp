@@ -1,10 +1,17 @@
 // Copyright 2023 Nesterov Alexander
 #include <gtest/gtest.h>
 
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
 #include <vector>
 
+#include "core/arena/include/arena.hpp"
 #include "core/perf/func_tests/test_task.hpp"
 #include "core/perf/include/perf.hpp"
+#include "core/perf/include/scaling.hpp"
 
 TEST(perf_tests, check_perf_pipeline) {
   // Create data
@@ -155,3 +162,646 @@ TEST(perf_tests, check_perf_task_float) {
   ASSERT_LE(perfResults->time_sec, 10.0);
   EXPECT_EQ(out[0], in.size());
 }
+
+TEST(perf_tests, check_perf_statistics) {
+  // Create data
+  std::vector<uint32_t> in(2000, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create TaskData
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  auto testTask = std::make_shared<ppc::test::TestTask<uint32_t>>(taskData);
+
+  // Create Perf attributes with fake timer: every run takes 1, 2, ..., 10 secs
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 10;
+  int timer_calls = 0;
+  double current_time = 0.0;
+  perfAttr->current_timer = [&] {
+    if (timer_calls++ % 2 == 1) current_time += (timer_calls / 2);
+    return current_time;
+  };
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  ppc::core::Perf perfAnalyzer(testTask);
+  perfAnalyzer.pipeline_run(perfAttr, perfResults);
+
+  ASSERT_EQ(perfResults->iteration_times.size(), 10U);
+  EXPECT_DOUBLE_EQ(perfResults->time_sec, 55.0);
+  EXPECT_DOUBLE_EQ(perfResults->min_sec, 1.0);
+  EXPECT_DOUBLE_EQ(perfResults->median_sec, 5.5);
+  EXPECT_DOUBLE_EQ(perfResults->mean_sec, 5.5);
+  EXPECT_NEAR(perfResults->p90_sec, 9.1, 1e-9);
+  EXPECT_NEAR(perfResults->stddev_sec, 3.0276503540974917, 1e-9);
+  EXPECT_LE(perfResults->ci_lower_sec, perfResults->mean_sec);
+  EXPECT_GE(perfResults->ci_upper_sec, perfResults->mean_sec);
+  EXPECT_EQ(out[0], in.size());
+}
+
+TEST(perf_tests, check_perf_warmup) {
+  // Create data
+  std::vector<uint32_t> in(2000, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create TaskData
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  auto testTask = std::make_shared<ppc::test::TestTask<uint32_t>>(taskData);
+
+  // Create Perf attributes
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 10;
+  perfAttr->num_warmup = 3;
+  int timer_calls = 0;
+  perfAttr->current_timer = [&] { return static_cast<double>(timer_calls++); };
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  ppc::core::Perf perfAnalyzer(testTask);
+  perfAnalyzer.task_run(perfAttr, perfResults);
+
+  EXPECT_EQ(timer_calls, 20);
+  ASSERT_EQ(perfResults->iteration_times.size(), 10U);
+  EXPECT_EQ(out[0], in.size());
+}
+
+TEST(perf_tests, check_perf_early_stop) {
+  // Create data
+  std::vector<uint32_t> in(2000, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create TaskData
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  auto testTask = std::make_shared<ppc::test::TestTask<uint32_t>>(taskData);
+
+  // Create Perf attributes with stable fake timer
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 1000;
+  perfAttr->target_rel_error = 0.01;
+  perfAttr->min_running = 7;
+  double current_time = 0.0;
+  perfAttr->current_timer = [&] { return current_time += 0.5; };
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  ppc::core::Perf perfAnalyzer(testTask);
+  perfAnalyzer.pipeline_run(perfAttr, perfResults);
+
+  EXPECT_EQ(perfResults->iteration_times.size(), 7U);
+  EXPECT_NEAR(perfResults->rel_error, 0.0, 1e-9);
+  EXPECT_EQ(out[0], in.size());
+}
+
+TEST(perf_tests, check_perf_early_stop_needs_reduced_time_with_barrier) {
+  std::vector<uint32_t> in(20, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create TaskData
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  auto testTask = std::make_shared<ppc::test::TestTask<uint32_t>>(taskData);
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 10;
+  perfAttr->target_rel_error = 0.01;
+  int barriers = 0;
+  perfAttr->barrier = [&] { barriers++; };
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+  ppc::core::Perf perfAnalyzer(testTask);
+  EXPECT_THROW(perfAnalyzer.pipeline_run(perfAttr, perfResults), std::invalid_argument);
+  EXPECT_THROW(perfAnalyzer.task_run(perfAttr, perfResults), std::invalid_argument);
+  EXPECT_EQ(barriers, 0);
+
+  // reduced time is the same on all ranks
+  perfAttr->reduce_times = [](double sec) { return ppc::core::RankTimes{sec, sec, sec}; };
+  perfAnalyzer.pipeline_run(perfAttr, perfResults);
+  EXPECT_GT(barriers, 0);
+}
+
+TEST(perf_tests, check_perf_record_csv) {
+  // Create data
+  std::vector<uint32_t> in(2000, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create TaskData
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  auto testTask = std::make_shared<ppc::test::TestTask<uint32_t>>(taskData);
+
+  // Create Perf attributes
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 10;
+  perfAttr->num_processes = 4;
+  perfAttr->num_threads = 2;
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  ppc::core::Perf perfAnalyzer(testTask);
+  perfAnalyzer.pipeline_run(perfAttr, perfResults);
+  EXPECT_EQ(perfResults->input_size, in.size());
+
+  auto output = std::filesystem::temp_directory_path() / "ppc_perf_tests_record.csv";
+  std::filesystem::remove(output);
+  ppc::core::Perf::write_perf_record(output.string(), "tasks/seq/example", perfResults);
+  ppc::core::Perf::write_perf_record(output.string(), "tasks/seq/example", perfResults);
+
+  std::ifstream file(output);
+  std::string header;
+  std::string record;
+  std::getline(file, header);
+  std::getline(file, record);
+  EXPECT_EQ(header.rfind("task,backend,type_of_running,num_processes,num_threads,input_size,num_iterations", 0), 0U);
+  EXPECT_EQ(record.rfind("tasks/seq/example,seq,pipeline,4,2,2000,10,", 0), 0U);
+  EXPECT_TRUE(std::getline(file, record));
+  EXPECT_FALSE(std::getline(file, record));
+  file.close();
+  std::filesystem::remove(output);
+
+  // fields with separator or quotes are quoted, so record keeps count of fields of header
+  perfResults->placement = "affinity=\"compact\",cpus=0,1";
+  ppc::core::Perf::write_perf_record(output.string(), "tasks/seq/my,task", perfResults);
+  file.open(output);
+  std::getline(file, header);
+  std::getline(file, record);
+  EXPECT_EQ(record.rfind("\"tasks/seq/my,task\",seq,pipeline,", 0), 0U);
+  EXPECT_NE(record.find(",\"affinity=\"\"compact\"\",cpus=0,1\","), std::string::npos);
+  auto count_fields = [](const std::string &line) {
+    size_t fields = 1;
+    bool quoted = false;
+    for (auto c : line) {
+      if (c == '"') quoted = !quoted;
+      if (c == ',' && !quoted) fields++;
+    }
+    return fields;
+  };
+  EXPECT_EQ(count_fields(record), count_fields(header));
+  file.close();
+  std::filesystem::remove(output);
+}
+
+TEST(perf_tests, check_perf_record_json_dir) {
+  // Create data
+  std::vector<uint32_t> in(2000, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create TaskData
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  auto testTask = std::make_shared<ppc::test::TestTask<uint32_t>>(taskData);
+
+  // Create Perf attributes
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 10;
+  auto previous_placement = ppc::core::current_placement().describe();
+  perfAttr->placement = ppc::core::Placement::parse("none", "interleave");
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  ppc::core::Perf perfAnalyzer(testTask);
+  perfAnalyzer.task_run(perfAttr, perfResults);
+  EXPECT_EQ(perfResults->placement, "none/interleave");
+  // placement of measurement isn't kept after it
+  EXPECT_EQ(ppc::core::current_placement().describe(), previous_placement);
+
+  auto output = std::filesystem::temp_directory_path() / "ppc_perf_tests_records";
+  std::filesystem::remove_all(output);
+  ppc::core::Perf::write_perf_record(output.string() + "/", "tasks/mpi/example", perfResults);
+
+  std::ifstream file(output / "tasks_mpi_example_task_run.json");
+  std::string record;
+  ASSERT_TRUE(std::getline(file, record));
+  EXPECT_NE(record.find("\"backend\": \"mpi\""), std::string::npos);
+  EXPECT_NE(record.find("\"type_of_running\": \"task_run\""), std::string::npos);
+  EXPECT_NE(record.find("\"num_iterations\": 10"), std::string::npos);
+  EXPECT_NE(record.find("\"placement\": \"none/interleave\""), std::string::npos);
+  file.close();
+  std::filesystem::remove_all(output);
+}
+
+TEST(perf_tests, check_perf_hw_counters) {
+  // Create data
+  std::vector<uint32_t> in(2000, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create TaskData
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  auto testTask = std::make_shared<ppc::test::TestTask<uint32_t>>(taskData);
+
+  // Create Perf attributes
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 10;
+  perfAttr->use_hw_counters = true;
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  ppc::core::Perf perfAnalyzer(testTask);
+  perfAnalyzer.pipeline_run(perfAttr, perfResults);
+
+  // Counters may be forbidden on the machine, then Perf has to fall back to time only
+  if (ppc::core::HwCounterSampler().available()) {
+    ASSERT_EQ(perfResults->iteration_counters.size(), 10U);
+  } else {
+    EXPECT_TRUE(perfResults->iteration_counters.empty());
+    EXPECT_EQ(perfResults->mean_counters.instructions, -1);
+    EXPECT_EQ(perfResults->mean_counters.ipc(), 0.0);
+  }
+  EXPECT_EQ(out[0], in.size());
+}
+
+TEST(perf_tests, check_perf_stage_times) {
+  // Create data
+  std::vector<uint32_t> in(2000, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create TaskData
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  auto testTask = std::make_shared<ppc::test::TestTask<uint32_t>>(taskData);
+
+  // Create Perf attributes
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 10;
+  perfAttr->num_warmup = 2;
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  ppc::core::Perf perfAnalyzer(testTask);
+  perfAnalyzer.pipeline_run(perfAttr, perfResults);
+
+  ASSERT_EQ(perfResults->iteration_stage_times.size(), 10U);
+  for (const auto &times : perfResults->iteration_stage_times) {
+    EXPECT_GE(times.validation, 0.0);
+    EXPECT_GE(times.pre_processing, 0.0);
+    EXPECT_GE(times.run, 0.0);
+    EXPECT_GE(times.post_processing, 0.0);
+  }
+  EXPECT_GT(perfResults->mean_stage_times.run, 0.0);
+
+  perfAnalyzer.task_run(perfAttr, perfResults);
+  EXPECT_TRUE(perfResults->iteration_stage_times.empty());
+  EXPECT_EQ(out[0], in.size());
+}
+
+TEST(perf_tests, check_perf_async_pipeline) {
+  // Create stream of inputs
+  const size_t count_inputs = 8;
+  std::vector<std::vector<uint32_t>> in(count_inputs, std::vector<uint32_t>(2000, 1));
+  std::vector<std::vector<uint32_t>> out(count_inputs, std::vector<uint32_t>(1, 0));
+  std::vector<std::shared_ptr<ppc::core::TaskData>> stream;
+  for (size_t i = 0; i < count_inputs; i++) {
+    auto taskData = std::make_shared<ppc::core::TaskData>();
+    taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in[i].data()));
+    taskData->inputs_count.emplace_back(in[i].size());
+    taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out[i].data()));
+    taskData->outputs_count.emplace_back(out[i].size());
+    stream.push_back(taskData);
+  }
+
+  // Create executor
+  ppc::core::PipelineExecutor executor([](std::shared_ptr<ppc::core::TaskData> taskData) {
+    return std::make_shared<ppc::test::TestTask<uint32_t>>(taskData);
+  });
+
+  // Create Perf attributes
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 10;
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  ppc::core::Perf::async_pipeline_run(executor, stream, perfAttr, perfResults);
+
+  ASSERT_LE(perfResults->time_sec, 10.0);
+  EXPECT_EQ(perfResults->type_of_running, ppc::core::PerfResults::TypeOfRunning::ASYNC_PIPELINE);
+  EXPECT_EQ(perfResults->iteration_times.size(), 10U);
+  EXPECT_EQ(perfResults->input_size, count_inputs * 2000);
+  for (size_t i = 0; i < count_inputs; i++) {
+    EXPECT_EQ(out[i][0], in[i].size());
+    EXPECT_EQ(stream[i]->state_of_testing, ppc::core::TaskData::StateOfTesting::PERF);
+  }
+}
+
+TEST(perf_tests, check_perf_async_pipeline_rejects_collective_measurement) {
+  std::vector<uint32_t> in(10, 1);
+  std::vector<uint32_t> out(1, 0);
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  ppc::core::PipelineExecutor executor([](std::shared_ptr<ppc::core::TaskData> taskData) {
+    return std::make_shared<ppc::test::TestTask<uint32_t>>(taskData);
+  });
+  // barrier is set by MPI-aware timing of perf_mpi.hpp
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->barrier = [] {};
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+  EXPECT_THROW(ppc::core::Perf::async_pipeline_run(executor, {taskData}, perfAttr, perfResults), std::invalid_argument);
+}
+
+TEST(perf_tests, check_scaling_strong_and_weak) {
+  // Fake timer models Amdahl's law: T(p) = size * (0.1 + 0.9 / p) secs per run
+  int current_workers = 1;
+  uint64_t current_size = 1;
+  int timer_calls = 0;
+  double current_time = 0.0;
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 3;
+  perfAttr->current_timer = [&] {
+    if (timer_calls++ % 2 == 1) current_time += static_cast<double>(current_size) * (0.1 + 0.9 / current_workers);
+    return current_time;
+  };
+
+  auto builder = [&](uint64_t input_size, int workers) {
+    current_size = input_size;
+    current_workers = workers;
+    auto in = std::make_shared<std::vector<uint32_t>>(input_size, 1);
+    auto out = std::make_shared<std::vector<uint32_t>>(1, 0);
+    auto taskData = std::make_shared<ppc::core::TaskData>();
+    taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in->data()));
+    taskData->inputs_count.emplace_back(in->size());
+    taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out->data()));
+    taskData->outputs_count.emplace_back(out->size());
+    ppc::core::ScalingCase scalingCase;
+    scalingCase.task = std::make_shared<ppc::test::TestTask<uint32_t>>(taskData);
+    scalingCase.storage = std::make_shared<std::pair<decltype(in), decltype(out)>>(in, out);
+    return scalingCase;
+  };
+
+  ppc::core::ScalingHarness harness(builder, perfAttr);
+  auto strong = harness.strong_scaling(10, {1, 2, 4});
+  ASSERT_EQ(strong.size(), 3U);
+  EXPECT_DOUBLE_EQ(strong[0].speedup, 1.0);
+  EXPECT_NEAR(strong[2].time_sec, 3.25, 1e-9);
+  EXPECT_NEAR(strong[2].speedup, 10.0 / 3.25, 1e-9);
+  EXPECT_NEAR(strong[2].efficiency, 10.0 / 3.25 / 4, 1e-9);
+  EXPECT_NEAR(strong[1].serial_fraction, 0.1, 1e-9);
+  EXPECT_NEAR(strong[2].serial_fraction, 0.1, 1e-9);
+
+  auto weak = harness.weak_scaling(10, {1, 2});
+  ASSERT_EQ(weak.size(), 2U);
+  EXPECT_EQ(weak[1].input_size, 20U);
+  EXPECT_NEAR(weak[1].time_sec, 11.0, 1e-9);
+  EXPECT_NEAR(weak[1].efficiency, 10.0 / 11.0, 1e-9);
+
+  auto path = (std::filesystem::temp_directory_path() / "ppc_scaling_test.csv").string();
+  std::filesystem::remove(path);
+  ppc::core::ScalingHarness::write_csv(path, "test_task", "strong", strong);
+  std::ifstream file(path);
+  std::string line;
+  int lines = 0;
+  while (std::getline(file, line)) lines++;
+  EXPECT_EQ(lines, 4);
+  std::filesystem::remove(path);
+}
+
+TEST(perf_tests, check_perf_rank_times) {
+  // Create data
+  std::vector<uint32_t> in(100, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create TaskData
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  auto testTask = std::make_shared<ppc::test::TestTask<uint32_t>>(taskData);
+
+  // Fake reduction over two ranks: local run takes 0.5 sec, other rank is 3 times slower
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 4;
+  double current_time = 0.0;
+  perfAttr->current_timer = [&] { return current_time += 0.5; };
+  int barriers = 0;
+  perfAttr->barrier = [&] { barriers++; };
+  perfAttr->reduce_times = [](double local_sec) {
+    ppc::core::RankTimes times;
+    times.min_sec = local_sec;
+    times.max_sec = 3.0 * local_sec;
+    times.mean_sec = 2.0 * local_sec;
+    return times;
+  };
+
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+  ppc::core::Perf perfAnalyzer(testTask);
+  perfAnalyzer.task_run(perfAttr, perfResults);
+
+  EXPECT_EQ(barriers, 4);
+  ASSERT_EQ(perfResults->iteration_rank_times.size(), 4U);
+  EXPECT_DOUBLE_EQ(perfResults->time_sec, 4.0 * 1.5);
+  EXPECT_DOUBLE_EQ(perfResults->mean_rank_times.min_sec, 0.5);
+  EXPECT_DOUBLE_EQ(perfResults->mean_rank_times.max_sec, 1.5);
+  EXPECT_DOUBLE_EQ(perfResults->mean_rank_times.mean_sec, 1.0);
+  EXPECT_DOUBLE_EQ(perfResults->imbalance, 1.5);
+}
+
+namespace {
+
+// Pretends that every timed run sends 100 bytes from rank 0 to rank 1 for 0.25 secs
+class FakeCommProfiler : public ppc::core::CommProfiler {
+ public:
+  void start() override { runs++; }
+  void stop() override {}
+  ppc::core::CommProfile collect() override {
+    ppc::core::CommProfile profile;
+    profile.num_ranks = 2;
+    profile.calls.push_back({"send", static_cast<uint64_t>(runs), 100U * runs, 0.25 * runs});
+    profile.traffic_bytes = {0, 100U * runs, 0, 0};
+    profile.traffic_messages = {0, static_cast<uint64_t>(runs), 0, 0};
+    profile.comm_time_sec = 0.25 * runs;
+    runs = 0;
+    return profile;
+  }
+
+  int runs = 0;
+};
+
+}  // namespace
+
+TEST(perf_tests, check_perf_comm_profile) {
+  // Create data
+  std::vector<uint32_t> in(100, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create TaskData
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  auto testTask = std::make_shared<ppc::test::TestTask<uint32_t>>(taskData);
+
+  // Every timed run takes 0.5 sec, a half of it is communication
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 4;
+  perfAttr->num_warmup = 2;
+  double current_time = 0.0;
+  perfAttr->current_timer = [&] { return current_time += 0.5; };
+  auto profiler = std::make_shared<FakeCommProfiler>();
+  perfAttr->comm_profiler = profiler;
+
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+  ppc::core::Perf perfAnalyzer(testTask);
+  perfAnalyzer.pipeline_run(perfAttr, perfResults);
+
+  const auto &comm = perfResults->comm_profile;
+  ASSERT_EQ(comm.num_ranks, 2);
+  EXPECT_EQ(comm.total_bytes(), 400U);
+  EXPECT_EQ(comm.total_messages(), 4U);
+  EXPECT_DOUBLE_EQ(comm.comm_time_sec, 1.0);
+  EXPECT_DOUBLE_EQ(perfResults->comm_ratio, 1.0);
+
+  auto path = (std::filesystem::temp_directory_path() / "ppc_perf_comm_test.json").string();
+  std::filesystem::remove(path);
+  ppc::core::Perf::write_perf_record(path, "tasks/mpi/example", perfResults);
+  std::ifstream file(path);
+  std::string line;
+  std::getline(file, line);
+  EXPECT_NE(line.find("\"comm_bytes\": 100"), std::string::npos);
+  EXPECT_NE(line.find("\"traffic_bytes\": [[0, 100], [0, 0]]"), std::string::npos);
+  EXPECT_NE(line.find("\"send\": {\"calls\": 1, \"bytes\": 100"), std::string::npos);
+  std::filesystem::remove(path);
+}
+
+namespace {
+
+// Keeps extra copy of input like many tasks do
+class CopyingTask : public ppc::test::TestTask<uint32_t> {
+ public:
+  using TestTask::TestTask;
+  bool pre_processing() override {
+    auto *input = reinterpret_cast<uint32_t *>(taskData->inputs[0]);
+    copy_ = std::vector<uint32_t>(input, input + taskData->inputs_count[0]);
+    return TestTask::pre_processing();
+  }
+
+ private:
+  std::vector<uint32_t> copy_;
+};
+
+std::vector<char> *volatile heap_sink = nullptr;
+
+}  // namespace
+
+TEST(perf_tests, check_memory_tracker) {
+  ppc::core::MemoryTracker tracker;
+  tracker.start();
+  // published through volatile pointer, so optimizer can't elide new / delete pair
+  heap_sink = new std::vector<char>(1 << 20);
+  delete heap_sink;
+  heap_sink = nullptr;
+  auto stats = tracker.stop();
+  if (!ppc::core::MemoryTracker::heap_available()) {
+    GTEST_SKIP() << "operator new is not replaced in this build";
+  }
+  EXPECT_GE(stats.peak_heap_bytes, 1 << 20);
+  EXPECT_GE(stats.allocations, 2);
+  EXPECT_GE(stats.allocated_bytes, 1 << 20);
+}
+
+TEST(perf_tests, check_memory_tracker_counts_arena_buffers) {
+  ppc::core::BufferArena arena;
+  ppc::core::MemoryTracker tracker;
+  tracker.start();
+  arena.get<double>("buffer", 1 << 17);
+  arena.get<double>("buffer", 1 << 16);
+  auto stats = tracker.stop();
+  if (!ppc::core::MemoryTracker::heap_available()) {
+    GTEST_SKIP() << "operator new is not replaced in this build";
+  }
+  EXPECT_GE(stats.peak_heap_bytes, static_cast<int64_t>((1 << 17) * sizeof(double)));
+  EXPECT_GE(stats.allocated_bytes, static_cast<int64_t>((1 << 17) * sizeof(double)));
+  EXPECT_GE(stats.allocations, 1);
+}
+
+TEST(perf_tests, check_perf_memory_stages) {
+  // Create data
+  std::vector<uint32_t> in(1 << 18, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create TaskData
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  auto testTask = std::make_shared<CopyingTask>(taskData);
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 3;
+  perfAttr->track_memory = true;
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+  ppc::core::Perf perfAnalyzer(testTask);
+  perfAnalyzer.pipeline_run(perfAttr, perfResults);
+  EXPECT_EQ(out[0], in.size());
+
+  if (!ppc::core::MemoryTracker::heap_available()) {
+    GTEST_SKIP() << "operator new is not replaced in this build";
+  }
+  const auto &stages = perfResults->stage_memory;
+  EXPECT_GE(stages.pre_processing.peak_heap_bytes, static_cast<int64_t>(in.size() * sizeof(uint32_t)));
+  EXPECT_EQ(stages.run.allocations, 0);
+  EXPECT_EQ(perfResults->memory.peak_heap_bytes, stages.pre_processing.peak_heap_bytes);
+}
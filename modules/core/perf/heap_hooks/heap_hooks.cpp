@@ -0,0 +1,105 @@
+// Copyright 2024 Nesterov Alexander
+// Replaced global operator new and delete counted by MemoryTracker. This file isn't part of core library,
+// it's built as core_heap_hooks object library which perf tests and bench executables link.
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+#include "core/perf/include/mem_tracker.hpp"
+
+#if defined(__has_feature)
+#if __has_feature(address_sanitizer) || __has_feature(thread_sanitizer) || __has_feature(memory_sanitizer)
+#define PPC_SANITIZER_BUILD
+#endif
+#endif
+#if defined(__SANITIZE_ADDRESS__) || defined(__SANITIZE_THREAD__)
+#define PPC_SANITIZER_BUILD
+#endif
+
+#if (defined(__linux__) || defined(__APPLE__)) && !defined(PPC_SANITIZER_BUILD)
+#define PPC_TRACK_HEAP
+#ifdef __APPLE__
+#include <malloc/malloc.h>
+#else
+#include <malloc.h>
+#endif
+#endif
+
+#ifdef PPC_TRACK_HEAP
+
+namespace {
+
+size_t usable_size(void* ptr) {
+#ifdef __APPLE__
+  return malloc_size(ptr);
+#else
+  return malloc_usable_size(ptr);
+#endif
+}
+
+void on_allocate(void* ptr) {
+  if (ptr == nullptr || !ppc::core::MemoryTracker::active()) return;
+  ppc::core::MemoryTracker::on_buffer_allocate(usable_size(ptr));
+}
+
+void on_free(void* ptr) {
+  if (ptr == nullptr || !ppc::core::MemoryTracker::active()) return;
+  ppc::core::MemoryTracker::on_buffer_free(usable_size(ptr));
+}
+
+void* allocate(size_t size) {
+  void* ptr = std::malloc(size > 0 ? size : 1);
+  if (ptr == nullptr) throw std::bad_alloc();
+  on_allocate(ptr);
+  return ptr;
+}
+
+void* allocate_aligned(size_t size, std::align_val_t alignment) {
+  void* ptr = nullptr;
+  auto align = std::max(static_cast<size_t>(alignment), sizeof(void*));
+  if (posix_memalign(&ptr, align, size > 0 ? size : 1) != 0) throw std::bad_alloc();
+  on_allocate(ptr);
+  return ptr;
+}
+
+void deallocate(void* ptr) noexcept {
+  on_free(ptr);
+  std::free(ptr);
+}
+
+// heap counters of tracker are reported once hooks are linked into executable
+const bool hooks_enabled = (ppc::core::MemoryTracker::enable_heap(), true);
+
+}  // namespace
+
+void* operator new(size_t size) { return allocate(size); }
+void* operator new[](size_t size) { return allocate(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+  try {
+    return allocate(size);
+  } catch (const std::bad_alloc&) {
+    return nullptr;
+  }
+}
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+  try {
+    return allocate(size);
+  } catch (const std::bad_alloc&) {
+    return nullptr;
+  }
+}
+void* operator new(size_t size, std::align_val_t alignment) { return allocate_aligned(size, alignment); }
+void* operator new[](size_t size, std::align_val_t alignment) { return allocate_aligned(size, alignment); }
+
+void operator delete(void* ptr) noexcept { deallocate(ptr); }
+void operator delete[](void* ptr) noexcept { deallocate(ptr); }
+void operator delete(void* ptr, size_t) noexcept { deallocate(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { deallocate(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { deallocate(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { deallocate(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { deallocate(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { deallocate(ptr); }
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept { deallocate(ptr); }
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept { deallocate(ptr); }
+
+#endif
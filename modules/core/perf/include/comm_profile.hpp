@@ -0,0 +1,58 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_COMM_PROFILE_HPP_
+#define MODULES_CORE_INCLUDE_COMM_PROFILE_HPP_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ppc {
+namespace core {
+
+// Count of calls, bytes sent (received for receives) and time of one type of MPI calls
+struct CommCallStats {
+  std::string name;
+  uint64_t calls = 0;
+  uint64_t bytes = 0;
+  double time_sec = 0.0;
+};
+
+// Communication of timed runs of one rank, or summed over ranks of measurement (see reduce_comm_profile
+// of perf_mpi.hpp), ranks of traffic matrix are ranks of MPI_COMM_WORLD
+struct CommProfile {
+  int num_ranks = 0;
+  std::vector<CommCallStats> calls;
+  // bytes and messages sent from rank i to rank j are stored at i * num_ranks + j,
+  // collectives are counted as logical data movement independent of their algorithm
+  std::vector<uint64_t> traffic_bytes;
+  std::vector<uint64_t> traffic_messages;
+  // time spent in MPI calls, averaged over ranks once profile is reduced (in seconds)
+  double comm_time_sec = 0.0;
+
+  [[nodiscard]] uint64_t total_bytes() const;
+  [[nodiscard]] uint64_t total_messages() const;
+};
+
+// Profiles communication of timed runs, implemented with PMPI interposition by commprof module
+class CommProfiler {
+ public:
+  virtual ~CommProfiler() = default;
+  // count MPI calls of this rank until stop()
+  virtual void start() = 0;
+  virtual void stop() = 0;
+  // Local profile of this rank of all runs since previous collect(), resets counters. Calls of every type are
+  // listed (zero if unused) in the same order on all ranks, so profiles can be reduced element-wise
+  virtual CommProfile collect() = 0;
+};
+
+// Profiler used by PerfAttr by default, registered by linked profiling library;
+// it is enabled only when PPC_COMM_PROFILE environment variable is set
+void register_comm_profiler(std::shared_ptr<CommProfiler> profiler);
+std::shared_ptr<CommProfiler> default_comm_profiler();
+
+}  // namespace core
+}  // namespace ppc
+
+#endif  // MODULES_CORE_INCLUDE_COMM_PROFILE_HPP_
@@ -0,0 +1,50 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_MEM_TRACKER_HPP_
+#define MODULES_CORE_INCLUDE_MEM_TRACKER_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ppc {
+namespace core {
+
+// Memory used by one stage of task, -1 if value is not available
+struct MemoryStats {
+  // peak resident set size of process during stage (in bytes)
+  int64_t peak_rss_bytes = -1;
+  // high-water mark of heap allocated with operator new and BufferArena above its size at start of stage (in bytes)
+  int64_t peak_heap_bytes = -1;
+  // count and total size of operator new calls and BufferArena buffers allocated during stage
+  int64_t allocations = -1;
+  int64_t allocated_bytes = -1;
+};
+
+// Tracks heap through replaced global operator new and delete and through buffers of BufferArena
+// (aligned_alloc or mmap of huge pages), which count only while tracker is started, and peak RSS through VmHWM
+// of Linux (reset via clear_refs). Direct malloc / mmap calls, e.g. by C code, MPI or TBB scalable allocator,
+// aren't counted in heap, they are seen in peak RSS only.
+// Replacement of operator new isn't part of core library, it's core_heap_hooks object library
+// (perf/heap_hooks) linked by perf tests and bench executables only, heap isn't reported without it.
+// Allocations of all threads are counted, trackers can't be nested.
+class MemoryTracker {
+ public:
+  // true if core_heap_hooks is linked and replaces operator new on this platform (not with sanitizers)
+  static bool heap_available();
+  // called by core_heap_hooks at static initialization
+  static void enable_heap();
+  // true while some tracker is started
+  static bool active();
+  // heap blocks of replaced operator new and buffers of BufferArena report themselves here
+  static void on_buffer_allocate(size_t bytes);
+  static void on_buffer_free(size_t bytes);
+  // reset counters and peaks, start counting
+  void start();
+  // stop counting and return values since start()
+  MemoryStats stop();
+};
+
+}  // namespace core
+}  // namespace ppc
+
+#endif  // MODULES_CORE_INCLUDE_MEM_TRACKER_HPP_
@@ -6,23 +6,119 @@
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <string>
 #include <vector>
 
+#include "core/affinity/include/affinity.hpp"
+#include "core/perf/include/comm_profile.hpp"
+#include "core/perf/include/mem_tracker.hpp"
+#include "core/perf/include/perf_counters.hpp"
+#include "core/pipeline/include/pipeline.hpp"
 #include "core/task/include/task.hpp"
 
 namespace ppc {
 namespace core {
 
+// Time of one run reduced over ranks of MPI task (in seconds)
+struct RankTimes {
+  double min_sec = 0.0;
+  double max_sec = 0.0;
+  double mean_sec = 0.0;
+};
+
 struct PerfAttr {
-  // count of task's running
+  // count of task's running (upper bound when early stop is enabled)
   uint64_t num_running;
+  // count of untimed runs before measurement
+  uint64_t num_warmup = 0;
+  // stop measurement once relative error of mean time is below this value (0 - disabled),
+  // collective measurement (with barrier) needs reduce_times, so all ranks stop on the same run
+  double target_rel_error = 0.0;
+  // minimal count of timed runs before early stop
+  uint64_t min_running = 5;
+  // count of resamples and confidence level for bootstrap interval of mean time
+  uint64_t num_bootstrap = 1000;
+  double confidence_level = 0.95;
+  // count of processes and threads used by task (0 - detect from environment)
+  int num_processes = 0;
+  int num_threads = 0;
+  // collect hardware counters for every timed run (Linux perf_event_open)
+  bool use_hw_counters = false;
+  // profile memory of every stage in one extra untimed pipeline run (also enabled by PPC_TRACK_MEMORY)
+  bool track_memory = false;
   std::function<double(void)> current_timer = [&] { return 0.0; };
+  // MPI-aware timing (see perf_mpi.hpp): collective barrier before every timed run and
+  // collective reduction of time of run over ranks, timed run takes time of the slowest rank
+  std::function<void(void)> barrier;
+  std::function<RankTimes(double)> reduce_times;
+  // profiler of MPI communication of timed runs, collected on every rank after measurement and reduced over
+  // ranks of measurement by reduce_comm_profile (see perf_mpi.hpp), profile of this rank without it
+  std::shared_ptr<CommProfiler> comm_profiler = default_comm_profiler();
+  std::function<CommProfile(const CommProfile&)> reduce_comm_profile;
+  // thread affinity and memory placement honoured by tasks, main thread is pinned as worker 0 during
+  // measurement only (default from PPC_AFFINITY and PPC_MEMORY_POLICY)
+  Placement placement = current_placement();
+};
+
+struct StageTimes {
+  // time of every stage of task's pipeline (in seconds)
+  double validation = 0.0;
+  double pre_processing = 0.0;
+  double run = 0.0;
+  double post_processing = 0.0;
+};
+
+struct StageMemory {
+  // memory used by every stage of task's pipeline
+  MemoryStats validation;
+  MemoryStats pre_processing;
+  MemoryStats run;
+  MemoryStats post_processing;
 };
 
 struct PerfResults {
   // measurement of task's time (in seconds)
   double time_sec = 0.0;
-  enum TypeOfRunning { PIPELINE, TASK_RUN, NONE } type_of_running = NONE;
+  // measurement of every timed run (in seconds)
+  std::vector<double> iteration_times;
+  // statistics of iteration_times (in seconds)
+  double min_sec = 0.0;
+  double median_sec = 0.0;
+  double p90_sec = 0.0;
+  double p99_sec = 0.0;
+  double mean_sec = 0.0;
+  double stddev_sec = 0.0;
+  // bootstrap confidence interval of mean time (in seconds) and its relative half-width
+  double ci_lower_sec = 0.0;
+  double ci_upper_sec = 0.0;
+  double rel_error = 0.0;
+  // context of measurement: elements count of task's inputs, processes and threads count
+  uint64_t input_size = 0;
+  int num_processes = 1;
+  int num_threads = 1;
+  // thread affinity and memory placement of measurement, see Placement::describe()
+  std::string placement;
+  // hardware counters of every timed run, empty if counters are disabled or not permitted
+  std::vector<HwCounters> iteration_counters;
+  // mean of iteration_counters (-1 for unavailable counters)
+  HwCounters mean_counters;
+  // time of every timed run on fastest, slowest and average rank, filled with reduce_times only
+  std::vector<RankTimes> iteration_rank_times;
+  RankTimes mean_rank_times;
+  // load imbalance over ranks: mean of max / mean time of timed runs (1 - perfectly balanced)
+  double imbalance = 1.0;
+  // memory of every stage and of whole pipeline (max of peaks, sum of allocations),
+  // filled with track_memory only
+  StageMemory stage_memory;
+  MemoryStats memory;
+  // communication of all timed runs and ratio of communication to computation time,
+  // filled with comm_profiler only
+  CommProfile comm_profile;
+  double comm_ratio = 0.0;
+  // breakdown of every timed pipeline run by stages and its mean, filled by pipeline_run only
+  std::vector<StageTimes> iteration_stage_times;
+  StageTimes mean_stage_times;
+  enum TypeOfRunning { PIPELINE, TASK_RUN, ASYNC_PIPELINE, NONE } type_of_running = NONE;
   constexpr const static double MAX_TIME = 10.0;
 };
 
@@ -34,18 +130,36 @@ class Perf {
   // analysis c
   void set_task(std::shared_ptr<Task> task_);
   // Check performance of full task's pipeline:  pre_processing() ->
-  // validation() -> run() -> post_processing()
+  // validation() -> run() -> post_processing(), also breaks time down by stages
   void pipeline_run(const std::shared_ptr<PerfAttr>& perfAttr,
                     const std::shared_ptr<ppc::core::PerfResults>& perfResults);
   // Check performance of task's run() function
   void task_run(const std::shared_ptr<PerfAttr>& perfAttr, const std::shared_ptr<ppc::core::PerfResults>& perfResults);
-  // Pint results for automation checkers
+  // Check performance of whole stream of inputs processed with overlapped stages,
+  // one timed run is one pass of stream, compare it with stream.size() pipeline runs.
+  // MPI-aware timing is rejected, PipelineExecutor doesn't run MPI tasks
+  static void async_pipeline_run(const PipelineExecutor& executor,
+                                 const std::vector<std::shared_ptr<TaskData>>& stream,
+                                 const std::shared_ptr<PerfAttr>& perfAttr,
+                                 const std::shared_ptr<ppc::core::PerfResults>& perfResults);
+  // Pint results for automation checkers, also writes structured record when
+  // PPC_PERF_OUTPUT is set (.csv or .json file, or directory for one .json file per test)
   static void print_perf_statistic(const std::shared_ptr<PerfResults>& perfResults);
+  // Same for task located at relative_path ("tasks/<backend>/<task>"), usable outside of gtest
+  static void print_perf_statistic(const std::string& relative_path, const std::shared_ptr<PerfResults>& perfResults);
+  // Append one record of results of task located at task_path ("tasks/<backend>/<task>") to output
+  static void write_perf_record(const std::string& output, const std::string& task_path,
+                                const std::shared_ptr<PerfResults>& perfResults);
 
  private:
   std::shared_ptr<Task> task;
+  void profile_memory(const std::shared_ptr<ppc::core::PerfResults>& perfResults);
+  static void fill_context(uint64_t total_input_size, const std::shared_ptr<PerfAttr>& perfAttr,
+                           const std::shared_ptr<ppc::core::PerfResults>& perfResults);
   static void common_run(const std::shared_ptr<PerfAttr>& perfAttr, const std::function<void()>& pipeline,
                          const std::shared_ptr<ppc::core::PerfResults>& perfResults);
+  static void compute_statistics(const std::shared_ptr<PerfAttr>& perfAttr,
+                                 const std::shared_ptr<ppc::core::PerfResults>& perfResults);
 };
 
 }  // namespace core
@@ -0,0 +1,58 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_PERF_COUNTERS_HPP_
+#define MODULES_CORE_INCLUDE_PERF_COUNTERS_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ppc {
+namespace core {
+
+// Values of hardware counters for one task's running, -1 if counter is not available
+struct HwCounters {
+  int64_t cycles = -1;
+  int64_t instructions = -1;
+  int64_t llc_misses = -1;
+  int64_t branch_misses = -1;
+  int64_t dtlb_misses = -1;
+
+  // instructions per cycle, 0 if it can't be computed
+  [[nodiscard]] double ipc() const;
+};
+
+// Counts user-space events of current process via Linux perf_event_open. Events are opened as one group per
+// thread existing at construction (so threads of OpenMP/TBB pools started earlier are counted too) and are
+// inherited by threads created later. Group is scheduled on PMU as a whole, values are scaled by
+// time_enabled / time_running when PMU is multiplexed. Counters that can't be opened, e.g. because of
+// perf_event_paranoid or missing PMU, stay unavailable; on other systems all of them are.
+class HwCounterSampler {
+ public:
+  HwCounterSampler();
+  HwCounterSampler(const HwCounterSampler&) = delete;
+  HwCounterSampler& operator=(const HwCounterSampler&) = delete;
+  ~HwCounterSampler();
+
+  // true if at least one counter is opened
+  [[nodiscard]] bool available() const;
+  // reset and enable counters
+  void start();
+  // disable counters and read values accumulated since start()
+  HwCounters stop();
+
+ private:
+  static constexpr size_t NUM_COUNTERS = 5;
+  // events of one thread, read by leader (fds[0]) in one call
+  struct Group {
+    std::vector<int> fds;
+    // index of counter of every event of group
+    std::vector<size_t> counters;
+  };
+  std::vector<Group> groups;
+};
+
+}  // namespace core
+}  // namespace ppc
+
+#endif  // MODULES_CORE_INCLUDE_PERF_COUNTERS_HPP_
@@ -0,0 +1,81 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_PERF_MPI_HPP_
+#define MODULES_CORE_INCLUDE_PERF_MPI_HPP_
+
+#include <mpi.h>
+
+#include <boost/mpi/collectives.hpp>
+#include <boost/mpi/communicator.hpp>
+#include <boost/mpi/operations.hpp>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "core/perf/include/perf.hpp"
+
+namespace ppc::core {
+
+// Sum of local profiles (see CommProfiler::collect) over ranks of comm, collective over comm only, so
+// measurement may run on any communicator. Time in MPI calls is averaged over its ranks.
+inline CommProfile reduce_comm_profile(MPI_Comm comm, const CommProfile &local) {
+  const auto num_calls = local.calls.size();
+  std::vector<uint64_t> counts(2 * num_calls);
+  std::vector<double> times(num_calls);
+  for (size_t i = 0; i < num_calls; i++) {
+    counts[i] = local.calls[i].calls;
+    counts[num_calls + i] = local.calls[i].bytes;
+    times[i] = local.calls[i].time_sec;
+  }
+  counts.insert(counts.end(), local.traffic_bytes.begin(), local.traffic_bytes.end());
+  counts.insert(counts.end(), local.traffic_messages.begin(), local.traffic_messages.end());
+  std::vector<uint64_t> total_counts(counts.size());
+  std::vector<double> total_times(num_calls);
+  MPI_Allreduce(counts.data(), total_counts.data(), static_cast<int>(counts.size()), MPI_UINT64_T, MPI_SUM, comm);
+  MPI_Allreduce(times.data(), total_times.data(), static_cast<int>(num_calls), MPI_DOUBLE, MPI_SUM, comm);
+
+  CommProfile profile;
+  profile.num_ranks = local.num_ranks;
+  profile.calls = local.calls;
+  for (size_t i = 0; i < num_calls; i++) {
+    profile.calls[i].calls = total_counts[i];
+    profile.calls[i].bytes = total_counts[num_calls + i];
+    profile.calls[i].time_sec = total_times[i];
+    profile.comm_time_sec += total_times[i];
+  }
+  int size = 1;
+  MPI_Comm_size(comm, &size);
+  profile.comm_time_sec /= size;
+  auto matrix = total_counts.begin() + static_cast<std::ptrdiff_t>(2 * num_calls);
+  auto matrix_size = static_cast<std::ptrdiff_t>(local.traffic_bytes.size());
+  profile.traffic_bytes.assign(matrix, matrix + matrix_size);
+  profile.traffic_messages.assign(matrix + matrix_size, total_counts.end());
+  return profile;
+}
+
+// Switches perfAttr to MPI-aware timing over ranks of world: MPI_Wtime timer, barrier before
+// every timed run and min/max/mean of time over ranks, so timed run takes time of the slowest rank, profile of
+// communication is reduced over world. Perf has to be run on all ranks of world, results are the same on every rank.
+inline void set_mpi_timing(const boost::mpi::communicator &world, PerfAttr &perfAttr) {
+  perfAttr.num_processes = world.size();
+  perfAttr.current_timer = [] { return MPI_Wtime(); };
+  perfAttr.barrier = [world] { world.barrier(); };
+  perfAttr.reduce_times = [world](double local_sec) {
+    // minimum is found as negated maximum to reduce both in one call
+    double local[2] = {-local_sec, local_sec};
+    double global[2];
+    boost::mpi::all_reduce(world, local, 2, global, boost::mpi::maximum<double>());
+    double sum = 0.0;
+    boost::mpi::all_reduce(world, local_sec, sum, std::plus<double>());
+    RankTimes times;
+    times.min_sec = -global[0];
+    times.max_sec = global[1];
+    times.mean_sec = sum / world.size();
+    return times;
+  };
+  perfAttr.reduce_comm_profile = [world](const CommProfile &local) { return reduce_comm_profile(world, local); };
+}
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_PERF_MPI_HPP_
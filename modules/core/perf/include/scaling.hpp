@@ -0,0 +1,66 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_SCALING_HPP_
+#define MODULES_CORE_INCLUDE_SCALING_HPP_
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/perf/include/perf.hpp"
+
+namespace ppc {
+namespace core {
+
+// Task prepared for one point of sweep, storage keeps its input and output memory alive
+struct ScalingCase {
+  std::shared_ptr<Task> task;
+  std::shared_ptr<void> storage;
+};
+
+struct ScalingPoint {
+  uint64_t input_size = 0;
+  int workers = 1;
+  // median time of one run (in seconds)
+  double time_sec = 0.0;
+  // speedup and efficiency relative to the first point; for weak scaling speedup is scaled one
+  double speedup = 1.0;
+  double efficiency = 1.0;
+  // Karp-Flatt experimentally determined serial fraction, 0 for one worker
+  double serial_fraction = 0.0;
+};
+
+// Sweeps input size and count of workers (threads or processes) for one task and
+// computes strong or weak scaling curves with Perf measurements at every point
+class ScalingHarness {
+ public:
+  // builder prepares task for given input size and workers count, e.g. sets count of threads
+  using CaseBuilder = std::function<ScalingCase(uint64_t input_size, int workers)>;
+
+  ScalingHarness(CaseBuilder builder_, std::shared_ptr<PerfAttr> perfAttr_, bool pipeline_ = true);
+
+  // Fixed input size, growing count of workers
+  std::vector<ScalingPoint> strong_scaling(uint64_t input_size, const std::vector<int>& workers);
+  // Input size grows with count of workers: size_per_worker * workers
+  std::vector<ScalingPoint> weak_scaling(uint64_t size_per_worker, const std::vector<int>& workers);
+
+  // Fill speedup, efficiency and serial fraction relative to the first point
+  static void compute_metrics(std::vector<ScalingPoint>& points, bool weak);
+  // Append points as CSV rows (with header for new file) labeled by task name and kind of scaling
+  static void write_csv(const std::string& path, const std::string& task_name, const std::string& kind,
+                        const std::vector<ScalingPoint>& points);
+
+ private:
+  ScalingPoint measure(uint64_t input_size, int workers);
+
+  CaseBuilder builder;
+  std::shared_ptr<PerfAttr> perfAttr;
+  bool pipeline;
+};
+
+}  // namespace core
+}  // namespace ppc
+
+#endif  // MODULES_CORE_INCLUDE_SCALING_HPP_
@@ -0,0 +1,12 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/perf/include/comm_profile.hpp"
+
+#include <numeric>
+
+uint64_t ppc::core::CommProfile::total_bytes() const {
+  return std::accumulate(traffic_bytes.begin(), traffic_bytes.end(), uint64_t{0});
+}
+
+uint64_t ppc::core::CommProfile::total_messages() const {
+  return std::accumulate(traffic_messages.begin(), traffic_messages.end(), uint64_t{0});
+}
@@ -0,0 +1,84 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/perf/include/mem_tracker.hpp"
+
+#include <atomic>
+#include <fstream>
+#include <string>
+
+namespace {
+
+std::atomic<bool> tracking{false};
+std::atomic<bool> heap_hooks{false};
+std::atomic<int64_t> live_bytes{0};
+std::atomic<int64_t> peak_bytes{0};
+std::atomic<int64_t> allocations{0};
+std::atomic<int64_t> allocated_bytes{0};
+
+void count_allocation(int64_t size) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+  auto live = live_bytes.fetch_add(size, std::memory_order_relaxed) + size;
+  auto peak = peak_bytes.load(std::memory_order_relaxed);
+  while (live > peak && !peak_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+  }
+}
+
+// Linux only: peak RSS since last reset, -1 if it can't be read
+int64_t read_peak_rss() {
+#ifdef __linux__
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while (std::getline(status, line)) {
+    if (line.rfind("VmHWM:", 0) == 0) {
+      return std::stoll(line.substr(6)) * 1024;
+    }
+  }
+#endif
+  return -1;
+}
+
+void reset_peak_rss() {
+#ifdef __linux__
+  std::ofstream clear_refs("/proc/self/clear_refs");
+  if (clear_refs.is_open()) clear_refs << "5";
+#endif
+}
+
+}  // namespace
+
+bool ppc::core::MemoryTracker::heap_available() { return heap_hooks.load(std::memory_order_relaxed); }
+
+void ppc::core::MemoryTracker::enable_heap() { heap_hooks.store(true, std::memory_order_relaxed); }
+
+bool ppc::core::MemoryTracker::active() { return tracking.load(std::memory_order_relaxed); }
+
+void ppc::core::MemoryTracker::on_buffer_allocate(size_t bytes) {
+  if (!tracking.load(std::memory_order_relaxed)) return;
+  count_allocation(static_cast<int64_t>(bytes));
+}
+
+void ppc::core::MemoryTracker::on_buffer_free(size_t bytes) {
+  if (!tracking.load(std::memory_order_relaxed)) return;
+  live_bytes.fetch_sub(static_cast<int64_t>(bytes), std::memory_order_relaxed);
+}
+
+void ppc::core::MemoryTracker::start() {
+  reset_peak_rss();
+  live_bytes.store(0, std::memory_order_relaxed);
+  peak_bytes.store(0, std::memory_order_relaxed);
+  allocations.store(0, std::memory_order_relaxed);
+  allocated_bytes.store(0, std::memory_order_relaxed);
+  tracking.store(true, std::memory_order_seq_cst);
+}
+
+ppc::core::MemoryStats ppc::core::MemoryTracker::stop() {
+  tracking.store(false, std::memory_order_seq_cst);
+  MemoryStats stats;
+  stats.peak_rss_bytes = read_peak_rss();
+  if (heap_available()) {
+    stats.peak_heap_bytes = peak_bytes.load(std::memory_order_relaxed);
+    stats.allocations = allocations.load(std::memory_order_relaxed);
+    stats.allocated_bytes = allocated_bytes.load(std::memory_order_relaxed);
+  }
+  return stats;
+}
@@ -3,11 +3,154 @@
 
 #include <gtest/gtest.h>
 
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <numeric>
+#include <random>
 #include <sstream>
+#include <stdexcept>
+#include <thread>
 #include <utility>
 
+#include "core/trace/include/trace.hpp"
+
+namespace {
+
+// Linear interpolation between closest ranks of sorted sample
+double percentile(const std::vector<double>& sorted, double p) {
+  if (sorted.empty()) return 0.0;
+  auto pos = p * static_cast<double>(sorted.size() - 1);
+  auto lo = static_cast<size_t>(std::floor(pos));
+  auto hi = std::min(lo + 1, sorted.size() - 1);
+  return sorted[lo] + (pos - static_cast<double>(lo)) * (sorted[hi] - sorted[lo]);
+}
+
+// Two-sided quantile of standard normal distribution for given confidence level
+double normal_quantile(double confidence_level) {
+  const double target = 0.5 * (1.0 + confidence_level);
+  double lo = 0.0;
+  double hi = 10.0;
+  for (int i = 0; i < 64; i++) {
+    double mid = 0.5 * (lo + hi);
+    if (0.5 * std::erfc(-mid / std::sqrt(2.0)) < target) {
+      lo = mid;
+    } else {
+      hi = mid;
+    }
+  }
+  return 0.5 * (lo + hi);
+}
+
+std::string get_env(const char* name) {
+#ifdef _MSC_VER
+  char* buf = nullptr;
+  size_t len = 0;
+  if (_dupenv_s(&buf, &len, name) != 0 || buf == nullptr) return {};
+  std::string value(buf);
+  free(buf);
+  return value;
+#else
+  const char* value = std::getenv(name);
+  return value != nullptr ? value : "";
+#endif
+}
+
+int get_env_int(const std::vector<const char*>& names, int default_value) {
+  for (const auto* name : names) {
+    auto value = get_env(name);
+    if (!value.empty()) {
+      try {
+        return std::stoi(value);
+      } catch (const std::exception&) {
+        continue;
+      }
+    }
+  }
+  return default_value;
+}
+
+bool memory_tracking(const ppc::core::PerfAttr& perfAttr) {
+  return perfAttr.track_memory || !get_env("PPC_TRACK_MEMORY").empty();
+}
+
+std::string get_host_name() {
+#ifdef _WIN32
+  return get_env("COMPUTERNAME");
+#else
+  char buf[256] = {};
+  if (gethostname(buf, sizeof(buf) - 1) != 0) return {};
+  return buf;
+#endif
+}
+
+std::string type_of_running_name(ppc::core::PerfResults::TypeOfRunning type_of_running) {
+  switch (type_of_running) {
+    case ppc::core::PerfResults::TypeOfRunning::PIPELINE:
+      return "pipeline";
+    case ppc::core::PerfResults::TypeOfRunning::TASK_RUN:
+      return "task_run";
+    case ppc::core::PerfResults::TypeOfRunning::ASYNC_PIPELINE:
+      return "async_pipeline";
+    default:
+      return "none";
+  }
+}
+
+uint64_t input_size(const std::shared_ptr<ppc::core::TaskData>& taskData) {
+  return std::accumulate(taskData->inputs_count.begin(), taskData->inputs_count.end(), uint64_t{0});
+}
+
+std::string json_escape(const std::string& str) {
+  std::string res;
+  for (auto c : str) {
+    if (c == '"' || c == '\\') res += '\\';
+    res += c;
+  }
+  return res;
+}
+
+// Field of CSV record (RFC 4180): quoted if it holds separator, quote or line break, quotes are doubled
+std::string csv_escape(const std::string& str) {
+  if (str.find_first_of(",\"\r\n") == std::string::npos) return str;
+  std::string res = "\"";
+  for (auto c : str) {
+    if (c == '"') res += '"';
+    res += c;
+  }
+  return res + "\"";
+}
+
+}  // namespace
+
+namespace {
+
+std::shared_ptr<ppc::core::CommProfiler>& registered_comm_profiler() {
+  static std::shared_ptr<ppc::core::CommProfiler> profiler;
+  return profiler;
+}
+
+}  // namespace
+
+void ppc::core::register_comm_profiler(std::shared_ptr<CommProfiler> profiler) {
+  registered_comm_profiler() = std::move(profiler);
+}
+
+std::shared_ptr<ppc::core::CommProfiler> ppc::core::default_comm_profiler() {
+  auto enabled = get_env("PPC_COMM_PROFILE");
+  if (enabled.empty() || enabled == "0") return nullptr;
+  return registered_comm_profiler();
+}
+
 ppc::core::Perf::Perf(std::shared_ptr<Task> task_) { set_task(std::move(task_)); }
 
 void ppc::core::Perf::set_task(std::shared_ptr<Task> task_) {
@@ -18,65 +161,319 @@ void ppc::core::Perf::set_task(std::shared_ptr<Task> task_) {
 void ppc::core::Perf::pipeline_run(const std::shared_ptr<PerfAttr>& perfAttr,
                                    const std::shared_ptr<ppc::core::PerfResults>& perfResults) {
   perfResults->type_of_running = PerfResults::TypeOfRunning::PIPELINE;
+  const PlacementScope placement(perfAttr->placement);
+  fill_context(input_size(task->get_data()), perfAttr, perfResults);
 
+  std::vector<StageTimes> stage_times;
+  stage_times.reserve(perfAttr->num_warmup + perfAttr->num_running);
   common_run(
-      std::move(perfAttr),
+      perfAttr,
       [&]() {
-        task->validation();
-        task->pre_processing();
-        task->run();
-        task->post_processing();
+        run_stage(*task, &Task::validation);
+        run_stage(*task, &Task::pre_processing);
+        run_stage(*task, &Task::run);
+        run_stage(*task, &Task::post_processing);
+        auto end = std::chrono::high_resolution_clock::now();
+        const auto& points = task->get_stage_time_points();
+        auto seconds = [](auto duration) { return std::chrono::duration<double>(duration).count(); };
+        stage_times.push_back({seconds(points[1] - points[0]), seconds(points[2] - points[1]),
+                               seconds(points[3] - points[2]), seconds(end - points[3])});
       },
-      std::move(perfResults));
+      perfResults);
+
+  // Drop warmup runs
+  auto num_timed = std::min(stage_times.size(), perfResults->iteration_times.size());
+  perfResults->iteration_stage_times.assign(stage_times.end() - static_cast<std::ptrdiff_t>(num_timed),
+                                            stage_times.end());
+  perfResults->mean_stage_times = StageTimes();
+  if (num_timed > 0) {
+    auto& mean = perfResults->mean_stage_times;
+    for (const auto& times : perfResults->iteration_stage_times) {
+      mean.validation += times.validation;
+      mean.pre_processing += times.pre_processing;
+      mean.run += times.run;
+      mean.post_processing += times.post_processing;
+    }
+    auto n = static_cast<double>(num_timed);
+    mean.validation /= n;
+    mean.pre_processing /= n;
+    mean.run /= n;
+    mean.post_processing /= n;
+  }
+
+  if (memory_tracking(*perfAttr)) {
+    profile_memory(perfResults);
+  }
 }
 
 void ppc::core::Perf::task_run(const std::shared_ptr<PerfAttr>& perfAttr,
                                const std::shared_ptr<ppc::core::PerfResults>& perfResults) {
   perfResults->type_of_running = PerfResults::TypeOfRunning::TASK_RUN;
+  const PlacementScope placement(perfAttr->placement);
+  fill_context(input_size(task->get_data()), perfAttr, perfResults);
+  perfResults->iteration_stage_times.clear();
+  perfResults->mean_stage_times = StageTimes();
+
+  run_stage(*task, &Task::validation);
+  run_stage(*task, &Task::pre_processing);
+  common_run(std::move(perfAttr), [&]() { run_stage(*task, &Task::run); }, std::move(perfResults));
+  run_stage(*task, &Task::post_processing);
+
+  if (memory_tracking(*perfAttr)) {
+    profile_memory(perfResults);
+  } else {
+    run_stage(*task, &Task::validation);
+    run_stage(*task, &Task::pre_processing);
+    run_stage(*task, &Task::run);
+    run_stage(*task, &Task::post_processing);
+  }
+}
+
+void ppc::core::Perf::profile_memory(const std::shared_ptr<ppc::core::PerfResults>& perfResults) {
+  MemoryTracker tracker;
+  auto measure = [&](MemoryStats& stats, const std::function<void()>& stage) {
+    tracker.start();
+    stage();
+    stats = tracker.stop();
+  };
+  auto& stages = perfResults->stage_memory;
+  measure(stages.validation, [&] { run_stage(*task, &Task::validation); });
+  measure(stages.pre_processing, [&] { run_stage(*task, &Task::pre_processing); });
+  measure(stages.run, [&] { run_stage(*task, &Task::run); });
+  measure(stages.post_processing, [&] { run_stage(*task, &Task::post_processing); });
+
+  auto& memory = perfResults->memory;
+  memory = MemoryStats();
+  for (const auto* stats : {&stages.validation, &stages.pre_processing, &stages.run, &stages.post_processing}) {
+    memory.peak_rss_bytes = std::max(memory.peak_rss_bytes, stats->peak_rss_bytes);
+    memory.peak_heap_bytes = std::max(memory.peak_heap_bytes, stats->peak_heap_bytes);
+    if (stats->allocations >= 0) {
+      memory.allocations = std::max<int64_t>(memory.allocations, 0) + stats->allocations;
+      memory.allocated_bytes = std::max<int64_t>(memory.allocated_bytes, 0) + stats->allocated_bytes;
+    }
+  }
+}
 
-  task->validation();
-  task->pre_processing();
-  common_run(std::move(perfAttr), [&]() { task->run(); }, std::move(perfResults));
-  task->post_processing();
+void ppc::core::Perf::async_pipeline_run(const PipelineExecutor& executor,
+                                         const std::vector<std::shared_ptr<TaskData>>& stream,
+                                         const std::shared_ptr<PerfAttr>& perfAttr,
+                                         const std::shared_ptr<ppc::core::PerfResults>& perfResults) {
+  // stages of MPI tasks would call collectives on one communicator from different threads at once
+  if (perfAttr->barrier || perfAttr->reduce_times) {
+    throw std::invalid_argument("Async pipeline doesn't run MPI tasks, measurement can't be collective");
+  }
+  perfResults->type_of_running = PerfResults::TypeOfRunning::ASYNC_PIPELINE;
+  const PlacementScope placement(perfAttr->placement);
+  uint64_t stream_size = 0;
+  for (const auto& taskData : stream) {
+    stream_size += input_size(taskData);
+  }
+  fill_context(stream_size, perfAttr, perfResults);
+  perfResults->iteration_stage_times.clear();
+  perfResults->mean_stage_times = StageTimes();
 
-  task->validation();
-  task->pre_processing();
-  task->run();
-  task->post_processing();
+  bool all_ok = true;
+  common_run(
+      perfAttr,
+      [&]() {
+        auto results = executor.run(stream, TaskData::StateOfTesting::PERF);
+        all_ok = all_ok && std::all_of(results.begin(), results.end(), [](bool ok) { return ok; });
+      },
+      perfResults);
+  if (!all_ok) {
+    std::cerr << "Some inputs of stream failed in async pipeline" << std::endl;
+  }
+}
+
+void ppc::core::Perf::fill_context(uint64_t total_input_size, const std::shared_ptr<PerfAttr>& perfAttr,
+                                   const std::shared_ptr<ppc::core::PerfResults>& perfResults) {
+  // ranks decide on early stop by their own times, without reduced time they stop on different runs and hang
+  // in barrier
+  if (perfAttr->target_rel_error > 0.0 && perfAttr->barrier && !perfAttr->reduce_times) {
+    throw std::invalid_argument("Early stop of collective measurement needs time reduced over ranks");
+  }
+  perfResults->input_size = total_input_size;
+  perfResults->stage_memory = StageMemory();
+  perfResults->memory = MemoryStats();
+  perfResults->num_processes = perfAttr->num_processes > 0
+                                   ? perfAttr->num_processes
+                                   : get_env_int({"OMPI_COMM_WORLD_SIZE", "PMI_SIZE", "MV2_COMM_WORLD_SIZE"}, 1);
+  auto hardware_threads = std::max(static_cast<int>(std::thread::hardware_concurrency()), 1);
+  perfResults->num_threads = perfAttr->num_threads > 0
+                                 ? perfAttr->num_threads
+                                 : get_env_int({"PPC_NUM_THREADS", "OMP_NUM_THREADS"}, hardware_threads);
+  perfResults->placement = perfAttr->placement.describe();
 }
 
 void ppc::core::Perf::common_run(const std::shared_ptr<PerfAttr>& perfAttr, const std::function<void()>& pipeline,
                                  const std::shared_ptr<ppc::core::PerfResults>& perfResults) {
-  auto begin = perfAttr->current_timer();
-  for (uint64_t i = 0; i < perfAttr->num_running; i++) {
+  for (uint64_t i = 0; i < perfAttr->num_warmup; i++) {
+    const TraceScope scope("warmup", "perf");
     pipeline();
   }
-  auto end = perfAttr->current_timer();
-  perfResults->time_sec = end - begin;
+
+  // Early stop decision is taken by every rank, it's the same on all of them as time is reduced over ranks
+  const double z = normal_quantile(perfAttr->confidence_level);
+  const uint64_t min_running = std::max<uint64_t>(perfAttr->min_running, 2);
+  auto& times = perfResults->iteration_times;
+  times.clear();
+  times.reserve(perfAttr->num_running);
+  std::unique_ptr<HwCounterSampler> sampler;
+  if (perfAttr->use_hw_counters) {
+    sampler = std::make_unique<HwCounterSampler>();
+    if (!sampler->available()) {
+      std::cerr << "Hardware counters are not available, measuring time only" << std::endl;
+      sampler.reset();
+    }
+  }
+  auto& counters = perfResults->iteration_counters;
+  counters.clear();
+  auto& rank_times = perfResults->iteration_rank_times;
+  rank_times.clear();
+  const auto& profiler = perfAttr->comm_profiler;
+  double mean = 0.0;
+  double m2 = 0.0;
+  for (uint64_t i = 0; i < perfAttr->num_running; i++) {
+    if (perfAttr->barrier) perfAttr->barrier();
+    if (sampler) sampler->start();
+    if (profiler) profiler->start();
+    auto begin = perfAttr->current_timer();
+    {
+      const TraceScope scope("timed_run", "perf");
+      pipeline();
+    }
+    auto end = perfAttr->current_timer();
+    if (profiler) profiler->stop();
+    if (sampler) counters.push_back(sampler->stop());
+    if (perfAttr->reduce_times) {
+      rank_times.push_back(perfAttr->reduce_times(end - begin));
+      times.push_back(rank_times.back().max_sec);
+    } else {
+      times.push_back(end - begin);
+    }
+
+    // Welford's update of running mean and variance
+    auto n = static_cast<double>(times.size());
+    auto delta = times.back() - mean;
+    mean += delta / n;
+    m2 += delta * (times.back() - mean);
+    if (perfAttr->target_rel_error > 0.0 && times.size() >= min_running && mean > 0.0) {
+      auto std_error = std::sqrt(m2 / (n - 1.0) / n);
+      if (z * std_error / mean < perfAttr->target_rel_error) break;
+    }
+  }
+  auto& comm_profile = perfResults->comm_profile;
+  comm_profile = profiler ? profiler->collect() : CommProfile();
+  if (profiler && perfAttr->reduce_comm_profile) comm_profile = perfAttr->reduce_comm_profile(comm_profile);
+  std::erase_if(comm_profile.calls, [](const CommCallStats& call) { return call.calls == 0; });
+  compute_statistics(perfAttr, perfResults);
+}
+
+void ppc::core::Perf::compute_statistics(const std::shared_ptr<PerfAttr>& perfAttr,
+                                         const std::shared_ptr<ppc::core::PerfResults>& perfResults) {
+  const auto& times = perfResults->iteration_times;
+  if (times.empty()) {
+    perfResults->time_sec = 0.0;
+    return;
+  }
+  std::vector<double> sorted(times);
+  std::sort(sorted.begin(), sorted.end());
+  auto n = static_cast<double>(sorted.size());
+
+  perfResults->mean_counters = HwCounters();
+  const auto& counters = perfResults->iteration_counters;
+  if (!counters.empty()) {
+    auto mean_of = [&](int64_t HwCounters::*field) -> int64_t {
+      int64_t sum = 0;
+      for (const auto& c : counters) {
+        if (c.*field < 0) return -1;
+        sum += c.*field;
+      }
+      return sum / static_cast<int64_t>(counters.size());
+    };
+    perfResults->mean_counters.cycles = mean_of(&HwCounters::cycles);
+    perfResults->mean_counters.instructions = mean_of(&HwCounters::instructions);
+    perfResults->mean_counters.llc_misses = mean_of(&HwCounters::llc_misses);
+    perfResults->mean_counters.branch_misses = mean_of(&HwCounters::branch_misses);
+    perfResults->mean_counters.dtlb_misses = mean_of(&HwCounters::dtlb_misses);
+  }
+
+  perfResults->mean_rank_times = RankTimes();
+  perfResults->imbalance = 1.0;
+  const auto& rank_times = perfResults->iteration_rank_times;
+  if (!rank_times.empty()) {
+    auto& mean = perfResults->mean_rank_times;
+    double imbalance_sum = 0.0;
+    for (const auto& t : rank_times) {
+      mean.min_sec += t.min_sec;
+      mean.max_sec += t.max_sec;
+      mean.mean_sec += t.mean_sec;
+      imbalance_sum += t.mean_sec > 0.0 ? t.max_sec / t.mean_sec : 1.0;
+    }
+    auto count = static_cast<double>(rank_times.size());
+    mean.min_sec /= count;
+    mean.max_sec /= count;
+    mean.mean_sec /= count;
+    perfResults->imbalance = imbalance_sum / count;
+  }
+
+  perfResults->time_sec = std::accumulate(sorted.begin(), sorted.end(), 0.0);
+  perfResults->min_sec = sorted.front();
+  perfResults->median_sec = percentile(sorted, 0.5);
+  perfResults->p90_sec = percentile(sorted, 0.9);
+  perfResults->p99_sec = percentile(sorted, 0.99);
+  perfResults->mean_sec = perfResults->time_sec / n;
+
+  double sq_sum = 0.0;
+  for (auto t : sorted) {
+    sq_sum += (t - perfResults->mean_sec) * (t - perfResults->mean_sec);
+  }
+  perfResults->stddev_sec = sorted.size() > 1 ? std::sqrt(sq_sum / (n - 1.0)) : 0.0;
+
+  // Percentile bootstrap of mean, fixed seed keeps reports reproducible
+  std::mt19937 gen(sorted.size());
+  std::uniform_int_distribution<size_t> dist(0, sorted.size() - 1);
+  std::vector<double> means(std::max<uint64_t>(perfAttr->num_bootstrap, 1));
+  for (auto& m : means) {
+    double sum = 0.0;
+    for (size_t i = 0; i < sorted.size(); i++) {
+      sum += sorted[dist(gen)];
+    }
+    m = sum / n;
+  }
+  std::sort(means.begin(), means.end());
+  auto alpha = 1.0 - perfAttr->confidence_level;
+  perfResults->ci_lower_sec = percentile(means, 0.5 * alpha);
+  perfResults->ci_upper_sec = percentile(means, 1.0 - 0.5 * alpha);
+  perfResults->rel_error = perfResults->mean_sec > 0.0
+                               ? 0.5 * (perfResults->ci_upper_sec - perfResults->ci_lower_sec) / perfResults->mean_sec
+                               : 0.0;
+
+  auto comp_time = perfResults->time_sec - perfResults->comm_profile.comm_time_sec;
+  perfResults->comm_ratio = comp_time > 0.0 ? perfResults->comm_profile.comm_time_sec / comp_time : 0.0;
 }
 
 void ppc::core::Perf::print_perf_statistic(const std::shared_ptr<PerfResults>& perfResults) {
   std::string relative_path(::testing::UnitTest::GetInstance()->current_test_info()->file());
   std::string ppc_regex_template("parallel_programming_course");
   std::string perf_regex_template("perf_tests");
-  std::string type_test_name;
-
   auto time_secs = perfResults->time_sec;
 
-  if (perfResults->type_of_running == PerfResults::TypeOfRunning::TASK_RUN) {
-    type_test_name = "task_run";
-  } else if (perfResults->type_of_running == PerfResults::TypeOfRunning::PIPELINE) {
-    type_test_name = "pipeline";
-  } else if (perfResults->type_of_running == PerfResults::TypeOfRunning::NONE) {
-    type_test_name = "none";
-  }
-
   auto first_found_position = relative_path.find(ppc_regex_template) + ppc_regex_template.length() + 1;
   relative_path.erase(0, first_found_position);
 
   auto last_found_position = relative_path.find(perf_regex_template) - 1;
   relative_path.erase(last_found_position, relative_path.length() - 1);
 
+  print_perf_statistic(relative_path, perfResults);
+  EXPECT_TRUE(time_secs < PerfResults::MAX_TIME);
+}
+
+void ppc::core::Perf::print_perf_statistic(const std::string& relative_path,
+                                           const std::shared_ptr<PerfResults>& perfResults) {
+  std::string type_test_name = type_of_running_name(perfResults->type_of_running);
+  auto time_secs = perfResults->time_sec;
+
   std::stringstream perf_res_str;
   if (time_secs < PerfResults::MAX_TIME) {
     perf_res_str << std::fixed << std::setprecision(10) << time_secs;
@@ -85,8 +482,140 @@ void ppc::core::Perf::print_perf_statistic(const std::shared_ptr<PerfResults>& p
     std::cerr << " time < " << PerfResults::MAX_TIME << " secs." << std::endl;
     std::cerr << "Original time in secs: " << time_secs;
     perf_res_str << std::fixed << std::setprecision(10) << -1.0;
-    EXPECT_TRUE(time_secs < PerfResults::MAX_TIME);
   }
 
   std::cout << relative_path << ":" << type_test_name << ":" << perf_res_str.str() << std::endl;
+
+  auto output = get_env("PPC_PERF_OUTPUT");
+  if (!output.empty()) {
+    write_perf_record(output, relative_path, perfResults);
+  }
+}
+
+void ppc::core::Perf::write_perf_record(const std::string& output, const std::string& task_path,
+                                        const std::shared_ptr<PerfResults>& perfResults) {
+  namespace fs = std::filesystem;
+  auto generic_path = fs::path(task_path).generic_string();
+  std::string backend;
+  if (generic_path.rfind("tasks/", 0) == 0) {
+    backend = generic_path.substr(6, generic_path.find('/', 6) - 6);
+  }
+  auto type_test_name = type_of_running_name(perfResults->type_of_running);
+  auto timestamp =
+      std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+
+  // communication is reported per timed run
+  const auto& comm = perfResults->comm_profile;
+  auto num_iterations = static_cast<double>(std::max<size_t>(perfResults->iteration_times.size(), 1));
+  auto per_run = [&](uint64_t value) { return static_cast<int64_t>(static_cast<double>(value) / num_iterations); };
+
+  std::vector<std::pair<std::string, double>> statistics = {
+      {"time_sec", perfResults->time_sec},         {"min_sec", perfResults->min_sec},
+      {"median_sec", perfResults->median_sec},     {"p90_sec", perfResults->p90_sec},
+      {"p99_sec", perfResults->p99_sec},           {"mean_sec", perfResults->mean_sec},
+      {"stddev_sec", perfResults->stddev_sec},     {"ci_lower_sec", perfResults->ci_lower_sec},
+      {"ci_upper_sec", perfResults->ci_upper_sec}, {"rel_error", perfResults->rel_error},
+      {"validation_sec", perfResults->mean_stage_times.validation},
+      {"pre_processing_sec", perfResults->mean_stage_times.pre_processing},
+      {"run_sec", perfResults->mean_stage_times.run},
+      {"post_processing_sec", perfResults->mean_stage_times.post_processing},
+      {"rank_min_sec", perfResults->mean_rank_times.min_sec},
+      {"rank_max_sec", perfResults->mean_rank_times.max_sec},
+      {"rank_mean_sec", perfResults->mean_rank_times.mean_sec},
+      {"imbalance", perfResults->imbalance},
+      {"comm_time_sec", perfResults->comm_profile.comm_time_sec / num_iterations},
+      {"comm_ratio", perfResults->comm_ratio}};
+  const auto& counters = perfResults->mean_counters;
+  std::vector<std::pair<std::string, int64_t>> hw_counters = {{"cycles", counters.cycles},
+                                                              {"instructions", counters.instructions},
+                                                              {"llc_misses", counters.llc_misses},
+                                                              {"branch_misses", counters.branch_misses},
+                                                              {"dtlb_misses", counters.dtlb_misses},
+                                                              {"comm_bytes", per_run(comm.total_bytes())},
+                                                              {"comm_messages", per_run(comm.total_messages())},
+                                                              {"peak_rss_bytes", perfResults->memory.peak_rss_bytes},
+                                                              {"peak_heap_bytes", perfResults->memory.peak_heap_bytes},
+                                                              {"allocations", perfResults->memory.allocations},
+                                                              {"allocated_bytes", perfResults->memory.allocated_bytes}};
+
+  fs::path output_path(output);
+  bool is_dir = fs::is_directory(output_path) || output.back() == '/' || output.back() == '\\';
+  bool is_csv = !is_dir && output_path.extension() == ".csv";
+  if (is_dir) {
+    fs::create_directories(output_path);
+    auto file_name = generic_path;
+    std::replace(file_name.begin(), file_name.end(), '/', '_');
+    output_path /= file_name + "_" + type_test_name + ".json";
+  } else if (output_path.has_parent_path()) {
+    fs::create_directories(output_path.parent_path());
+  }
+
+  bool write_header = is_csv && (!fs::exists(output_path) || fs::file_size(output_path) == 0);
+  std::ofstream out(output_path, is_dir ? std::ios::trunc : std::ios::app);
+  if (!out.is_open()) {
+    std::cerr << "Can't open perf output: " << output_path.string() << std::endl;
+    return;
+  }
+  out << std::setprecision(10);
+
+  if (is_csv) {
+    if (write_header) {
+      out << "task,backend,type_of_running,num_processes,num_threads,input_size,num_iterations";
+      for (const auto& [name, value] : statistics) out << "," << name;
+      for (const auto& [name, value] : hw_counters) out << "," << name;
+      out << ",ipc,placement,host,hardware_concurrency,timestamp\n";
+    }
+    out << csv_escape(generic_path) << "," << csv_escape(backend) << "," << type_test_name << ","
+        << perfResults->num_processes << "," << perfResults->num_threads << "," << perfResults->input_size << ","
+        << perfResults->iteration_times.size();
+    for (const auto& [name, value] : statistics) out << "," << value;
+    for (const auto& [name, value] : hw_counters) out << "," << value;
+    out << "," << counters.ipc() << "," << csv_escape(perfResults->placement) << "," << csv_escape(get_host_name())
+        << "," << std::thread::hardware_concurrency() << "," << timestamp << "\n";
+  } else {
+    out << "{\"task\": \"" << json_escape(generic_path) << "\", \"backend\": \"" << json_escape(backend)
+        << "\", \"type_of_running\": \"" << type_test_name << "\", \"num_processes\": " << perfResults->num_processes
+        << ", \"num_threads\": " << perfResults->num_threads << ", \"input_size\": " << perfResults->input_size
+        << ", \"num_iterations\": " << perfResults->iteration_times.size();
+    for (const auto& [name, value] : statistics) out << ", \"" << name << "\": " << value;
+    for (const auto& [name, value] : hw_counters) out << ", \"" << name << "\": " << value;
+    out << ", \"ipc\": " << counters.ipc();
+    const auto& stage_memory = perfResults->stage_memory;
+    if (perfResults->memory.peak_rss_bytes >= 0 || perfResults->memory.peak_heap_bytes >= 0) {
+      std::vector<std::pair<std::string, const MemoryStats*>> stages = {
+          {"validation", &stage_memory.validation},
+          {"pre_processing", &stage_memory.pre_processing},
+          {"run", &stage_memory.run},
+          {"post_processing", &stage_memory.post_processing}};
+      out << ", \"stage_memory\": {";
+      for (size_t i = 0; i < stages.size(); i++) {
+        const auto& stats = *stages[i].second;
+        out << (i > 0 ? ", " : "") << "\"" << stages[i].first << "\": {\"peak_rss_bytes\": " << stats.peak_rss_bytes
+            << ", \"peak_heap_bytes\": " << stats.peak_heap_bytes << ", \"allocations\": " << stats.allocations
+            << ", \"allocated_bytes\": " << stats.allocated_bytes << "}";
+      }
+      out << "}";
+    }
+    if (comm.num_ranks > 0) {
+      out << ", \"comm_calls\": {";
+      for (size_t i = 0; i < comm.calls.size(); i++) {
+        const auto& call = comm.calls[i];
+        out << (i > 0 ? ", " : "") << "\"" << call.name << "\": {\"calls\": " << per_run(call.calls)
+            << ", \"bytes\": " << per_run(call.bytes) << ", \"time_sec\": " << call.time_sec / num_iterations << "}";
+      }
+      out << "}, \"traffic_bytes\": [";
+      for (int i = 0; i < comm.num_ranks; i++) {
+        out << (i > 0 ? ", [" : "[");
+        for (int j = 0; j < comm.num_ranks; j++) {
+          out << (j > 0 ? ", " : "") << per_run(comm.traffic_bytes[i * comm.num_ranks + j]);
+        }
+        out << "]";
+      }
+      out << "]";
+    }
+    out << ", \"placement\": \"" << json_escape(perfResults->placement) << "\"";
+    out << ", \"host\": \"" << json_escape(get_host_name())
+        << "\", \"hardware_concurrency\": " << std::thread::hardware_concurrency() << ", \"timestamp\": " << timestamp
+        << "}\n";
+  }
 }
@@ -0,0 +1,147 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/perf/include/perf_counters.hpp"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <string>
+#include <system_error>
+#include <utility>
+#endif
+
+double ppc::core::HwCounters::ipc() const {
+  if (cycles <= 0 || instructions < 0) return 0.0;
+  return static_cast<double>(instructions) / static_cast<double>(cycles);
+}
+
+#ifdef __linux__
+
+namespace {
+
+int open_counter(pid_t tid, uint32_t type, uint64_t config, int group_fd) {
+  perf_event_attr attr;
+  std::memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = type;
+  attr.config = config;
+  // members follow leader, which is enabled and disabled for whole group
+  attr.disabled = group_fd < 0 ? 1 : 0;
+  attr.inherit = 1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+  return static_cast<int>(syscall(SYS_perf_event_open, &attr, tid, -1, group_fd, 0));
+}
+
+// Threads of current process
+std::vector<pid_t> process_threads() {
+  std::vector<pid_t> tids;
+  std::error_code error;
+  for (const auto &entry : std::filesystem::directory_iterator("/proc/self/task", error)) {
+    try {
+      tids.push_back(static_cast<pid_t>(std::stoi(entry.path().filename().string())));
+    } catch (const std::exception &) {
+      continue;
+    }
+  }
+  if (tids.empty()) tids.push_back(static_cast<pid_t>(syscall(SYS_gettid)));
+  return tids;
+}
+
+}  // namespace
+
+ppc::core::HwCounterSampler::HwCounterSampler() {
+  const uint64_t dtlb_read_miss = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                  (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+  const std::array<std::pair<uint32_t, uint64_t>, NUM_COUNTERS> events = {{
+      {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+      {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+      {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+      {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+      {PERF_TYPE_HW_CACHE, dtlb_read_miss},
+  }};
+  for (auto tid : process_threads()) {
+    Group group;
+    for (size_t i = 0; i < NUM_COUNTERS; i++) {
+      // first event opened becomes leader
+      int fd = open_counter(tid, events[i].first, events[i].second, group.fds.empty() ? -1 : group.fds[0]);
+      if (fd < 0) continue;
+      group.fds.push_back(fd);
+      group.counters.push_back(i);
+    }
+    if (!group.fds.empty()) groups.push_back(std::move(group));
+  }
+}
+
+ppc::core::HwCounterSampler::~HwCounterSampler() {
+  for (auto &group : groups) {
+    // members are closed before leader
+    for (auto fd = group.fds.rbegin(); fd != group.fds.rend(); ++fd) close(*fd);
+  }
+}
+
+void ppc::core::HwCounterSampler::start() {
+  for (auto &group : groups) {
+    ioctl(group.fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(group.fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+  }
+}
+
+ppc::core::HwCounters ppc::core::HwCounterSampler::stop() {
+  std::array<double, NUM_COUNTERS> totals{};
+  std::array<bool, NUM_COUNTERS> counted{};
+  for (auto &group : groups) {
+    ioctl(group.fds[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+  }
+  for (auto &group : groups) {
+    // nr, time_enabled, time_running, values of nr events
+    std::vector<uint64_t> data(3 + group.fds.size());
+    auto bytes = static_cast<ssize_t>(data.size() * sizeof(uint64_t));
+    if (read(group.fds[0], data.data(), data.size() * sizeof(uint64_t)) != bytes) continue;
+    const auto enabled = static_cast<double>(data[1]);
+    const auto running = static_cast<double>(data[2]);
+    // group didn't run, e.g. its thread was idle
+    if (running == 0.0) continue;
+    for (size_t i = 0; i < group.counters.size() && i < data[0]; i++) {
+      totals[group.counters[i]] += static_cast<double>(data[3 + i]) * enabled / running;
+      counted[group.counters[i]] = true;
+    }
+  }
+  std::array<int64_t, NUM_COUNTERS> values{};
+  for (size_t i = 0; i < NUM_COUNTERS; i++) {
+    bool opened = std::any_of(groups.begin(), groups.end(), [i](const Group &group) {
+      return std::find(group.counters.begin(), group.counters.end(), i) != group.counters.end();
+    });
+    values[i] = opened ? (counted[i] ? std::llround(totals[i]) : 0) : -1;
+  }
+  HwCounters counters;
+  counters.cycles = values[0];
+  counters.instructions = values[1];
+  counters.llc_misses = values[2];
+  counters.branch_misses = values[3];
+  counters.dtlb_misses = values[4];
+  return counters;
+}
+
+#else
+
+ppc::core::HwCounterSampler::HwCounterSampler() = default;
+
+ppc::core::HwCounterSampler::~HwCounterSampler() = default;
+
+void ppc::core::HwCounterSampler::start() {}
+
+ppc::core::HwCounters ppc::core::HwCounterSampler::stop() { return {}; }
+
+#endif
+
+bool ppc::core::HwCounterSampler::available() const { return !groups.empty(); }
@@ -0,0 +1,92 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/perf/include/scaling.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <utility>
+
+ppc::core::ScalingHarness::ScalingHarness(CaseBuilder builder_, std::shared_ptr<PerfAttr> perfAttr_, bool pipeline_)
+    : builder(std::move(builder_)), perfAttr(std::move(perfAttr_)), pipeline(pipeline_) {}
+
+ppc::core::ScalingPoint ppc::core::ScalingHarness::measure(uint64_t input_size, int workers) {
+  auto scalingCase = builder(input_size, workers);
+  auto attr = std::make_shared<PerfAttr>(*perfAttr);
+  attr->num_threads = attr->num_threads > 0 ? attr->num_threads : workers;
+  auto perfResults = std::make_shared<PerfResults>();
+
+  Perf perfAnalyzer(scalingCase.task);
+  if (pipeline) {
+    perfAnalyzer.pipeline_run(attr, perfResults);
+  } else {
+    perfAnalyzer.task_run(attr, perfResults);
+  }
+
+  ScalingPoint point;
+  point.input_size = input_size;
+  point.workers = workers;
+  point.time_sec = perfResults->median_sec;
+  return point;
+}
+
+std::vector<ppc::core::ScalingPoint> ppc::core::ScalingHarness::strong_scaling(uint64_t input_size,
+                                                                                const std::vector<int>& workers) {
+  std::vector<ScalingPoint> points;
+  for (auto p : workers) {
+    points.push_back(measure(input_size, p));
+  }
+  compute_metrics(points, false);
+  return points;
+}
+
+std::vector<ppc::core::ScalingPoint> ppc::core::ScalingHarness::weak_scaling(uint64_t size_per_worker,
+                                                                              const std::vector<int>& workers) {
+  std::vector<ScalingPoint> points;
+  for (auto p : workers) {
+    points.push_back(measure(size_per_worker * p, p));
+  }
+  compute_metrics(points, true);
+  return points;
+}
+
+void ppc::core::ScalingHarness::compute_metrics(std::vector<ScalingPoint>& points, bool weak) {
+  if (points.empty()) return;
+  const auto& base = points.front();
+  for (auto& point : points) {
+    if (point.time_sec <= 0.0 || base.time_sec <= 0.0) {
+      point.speedup = 0.0;
+      point.efficiency = 0.0;
+      point.serial_fraction = 0.0;
+      continue;
+    }
+    // Strong: S = T(p0) / T(p) scaled to p0 workers; weak: scaled speedup S = p * T(p0) / T(p)
+    point.speedup = base.time_sec / point.time_sec * (weak ? point.workers : base.workers);
+    point.efficiency = point.speedup / point.workers;
+    if (point.workers > 1) {
+      auto p = static_cast<double>(point.workers);
+      point.serial_fraction = (1.0 / point.speedup - 1.0 / p) / (1.0 - 1.0 / p);
+    } else {
+      point.serial_fraction = 0.0;
+    }
+  }
+}
+
+void ppc::core::ScalingHarness::write_csv(const std::string& path, const std::string& task_name,
+                                          const std::string& kind, const std::vector<ScalingPoint>& points) {
+  namespace fs = std::filesystem;
+  bool write_header = !fs::exists(path) || fs::file_size(path) == 0;
+  std::ofstream out(path, std::ios::app);
+  if (!out.is_open()) {
+    std::cerr << "Can't open scaling output: " << path << std::endl;
+    return;
+  }
+  if (write_header) {
+    out << "task,scaling,input_size,workers,time_sec,speedup,efficiency,serial_fraction\n";
+  }
+  out << std::setprecision(10);
+  for (const auto& point : points) {
+    out << task_name << "," << kind << "," << point.input_size << "," << point.workers << "," << point.time_sec << ","
+        << point.speedup << "," << point.efficiency << "," << point.serial_fraction << "\n";
+  }
+}
@@ -0,0 +1,110 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "core/pipeline/include/pipeline.hpp"
+#include "core/task/func_tests/test_task.hpp"
+
+namespace {
+
+struct Instance {
+  std::vector<int32_t> in;
+  std::vector<int32_t> out;
+  std::shared_ptr<ppc::core::TaskData> taskData;
+};
+
+std::vector<Instance> make_stream(size_t count) {
+  std::vector<Instance> instances(count);
+  for (size_t i = 0; i < count; i++) {
+    auto &instance = instances[i];
+    instance.in = std::vector<int32_t>(100 + i, 1);
+    instance.out = std::vector<int32_t>(1, 0);
+    instance.taskData = std::make_shared<ppc::core::TaskData>();
+    instance.taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(instance.in.data()));
+    instance.taskData->inputs_count.emplace_back(instance.in.size());
+    instance.taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(instance.out.data()));
+    instance.taskData->outputs_count.emplace_back(instance.out.size());
+  }
+  return instances;
+}
+
+std::vector<std::shared_ptr<ppc::core::TaskData>> get_stream(const std::vector<Instance> &instances) {
+  std::vector<std::shared_ptr<ppc::core::TaskData>> stream;
+  for (const auto &instance : instances) stream.push_back(instance.taskData);
+  return stream;
+}
+
+// Task which fails in run() for inputs of given size
+class ThrowingTask : public ppc::test::TestTask<int32_t> {
+ public:
+  ThrowingTask(std::shared_ptr<ppc::core::TaskData> taskData_, uint32_t bad_size_)
+      : TestTask(std::move(taskData_)), bad_size(bad_size_) {}
+  bool run() override {
+    if (taskData->inputs_count[0] == bad_size) throw std::runtime_error("bad input");
+    return TestTask::run();
+  }
+
+ private:
+  uint32_t bad_size;
+};
+
+}  // namespace
+
+TEST(pipeline_tests, check_stream) {
+  auto instances = make_stream(50);
+  std::atomic<int> created{0};
+  ppc::core::PipelineExecutor executor([&](std::shared_ptr<ppc::core::TaskData> taskData) {
+    created++;
+    return std::make_shared<ppc::test::TestTask<int32_t>>(taskData);
+  });
+
+  auto results = executor.run(get_stream(instances));
+  ASSERT_EQ(results.size(), instances.size());
+  EXPECT_LE(created, 3);
+  for (size_t i = 0; i < instances.size(); i++) {
+    EXPECT_TRUE(results[i]);
+    EXPECT_EQ(static_cast<size_t>(instances[i].out[0]), instances[i].in.size());
+  }
+}
+
+TEST(pipeline_tests, check_depth_one) {
+  auto instances = make_stream(10);
+  ppc::core::PipelineExecutor executor(
+      [](std::shared_ptr<ppc::core::TaskData> taskData) {
+        return std::make_shared<ppc::test::TestTask<int32_t>>(taskData);
+      },
+      1);
+
+  auto results = executor.run(get_stream(instances));
+  for (size_t i = 0; i < instances.size(); i++) {
+    EXPECT_TRUE(results[i]);
+    EXPECT_EQ(static_cast<size_t>(instances[i].out[0]), instances[i].in.size());
+  }
+}
+
+TEST(pipeline_tests, check_failed_validation) {
+  auto instances = make_stream(10);
+  instances[5].taskData->outputs_count[0] = 2;
+  ppc::core::PipelineExecutor executor([](std::shared_ptr<ppc::core::TaskData> taskData) {
+    return std::make_shared<ppc::test::TestTask<int32_t>>(taskData);
+  });
+
+  auto results = executor.run(get_stream(instances));
+  for (size_t i = 0; i < instances.size(); i++) {
+    EXPECT_EQ(results[i], i != 5);
+  }
+  EXPECT_EQ(static_cast<size_t>(instances[6].out[0]), instances[6].in.size());
+}
+
+TEST(pipeline_tests, check_exception) {
+  auto instances = make_stream(20);
+  ppc::core::PipelineExecutor executor([](std::shared_ptr<ppc::core::TaskData> taskData) {
+    return std::make_shared<ThrowingTask>(taskData, 107);
+  });
+
+  EXPECT_THROW((void)executor.run(get_stream(instances)), std::runtime_error);
+}
@@ -0,0 +1,39 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_PIPELINE_HPP_
+#define MODULES_CORE_INCLUDE_PIPELINE_HPP_
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "core/task/include/task.hpp"
+
+namespace ppc::core {
+
+// Processes stream of inputs with stages of consecutive inputs overlapped:
+// while input k is in run(), input k+1 is in validation()/pre_processing() and
+// input k-1 is in post_processing(). Every stage has its own thread and stages are
+// connected by bounded queues; depth task objects are reused for inputs in flight.
+// MPI tasks aren't supported: stages of consecutive inputs would call collectives on the same communicator
+// from different threads at once, which is erroneous even with MPI_THREAD_MULTIPLE.
+class PipelineExecutor {
+ public:
+  using TaskFactory = std::function<std::shared_ptr<Task>(std::shared_ptr<TaskData>)>;
+
+  // depth - count of inputs in flight, 3 is enough to keep every stage busy
+  explicit PipelineExecutor(TaskFactory factory_, size_t depth_ = 3);
+
+  // Process every input of stream in order, result[k] is false if any stage of k-th input failed
+  [[nodiscard]] std::vector<bool> run(const std::vector<std::shared_ptr<TaskData>> &stream,
+                                      TaskData::StateOfTesting state_of_testing = TaskData::FUNC) const;
+
+ private:
+  TaskFactory factory;
+  size_t depth;
+};
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_PIPELINE_HPP_
@@ -0,0 +1,133 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/pipeline/include/pipeline.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <thread>
+#include <utility>
+
+namespace {
+
+// Blocking queue of slot indices, closing it wakes up all waiting consumers
+class SlotQueue {
+ public:
+  void push(size_t value) {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      values.push(value);
+    }
+    cv.notify_one();
+  }
+
+  std::optional<size_t> pop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    cv.wait(lock, [&] { return closed || !values.empty(); });
+    if (values.empty()) return std::nullopt;
+    auto value = values.front();
+    values.pop();
+    return value;
+  }
+
+  void close() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      closed = true;
+    }
+    cv.notify_all();
+  }
+
+ private:
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::queue<size_t> values;
+  bool closed = false;
+};
+
+struct Slot {
+  std::shared_ptr<ppc::core::Task> task;
+  size_t index = 0;
+  bool ok = false;
+};
+
+}  // namespace
+
+ppc::core::PipelineExecutor::PipelineExecutor(TaskFactory factory_, size_t depth_)
+    : factory(std::move(factory_)), depth(std::max<size_t>(depth_, 1)) {}
+
+std::vector<bool> ppc::core::PipelineExecutor::run(const std::vector<std::shared_ptr<TaskData>> &stream,
+                                                   TaskData::StateOfTesting state_of_testing) const {
+  std::vector<char> results(stream.size(), 0);
+  std::vector<Slot> slots(std::min(depth, std::max<size_t>(stream.size(), 1)));
+  // Count of free slots bounds every queue, so no queue needs its own capacity
+  SlotQueue free_slots;
+  SlotQueue loaded;
+  SlotQueue computed;
+  for (size_t s = 0; s < slots.size(); s++) free_slots.push(s);
+
+  std::mutex error_mutex;
+  std::exception_ptr error;
+  auto fail = [&]() {
+    {
+      std::lock_guard<std::mutex> lock(error_mutex);
+      if (!error) error = std::current_exception();
+    }
+    free_slots.close();
+    loaded.close();
+    computed.close();
+  };
+
+  std::thread loader([&]() {
+    try {
+      for (size_t k = 0; k < stream.size(); k++) {
+        auto s = free_slots.pop();
+        if (!s) break;
+        auto &slot = slots[*s];
+        if (slot.task) {
+          slot.task->rebind(stream[k]);
+        } else {
+          slot.task = factory(stream[k]);
+        }
+        stream[k]->state_of_testing = state_of_testing;
+        slot.index = k;
+        slot.ok = run_stage(*slot.task, &Task::validation) && run_stage(*slot.task, &Task::pre_processing);
+        loaded.push(*s);
+      }
+      loaded.close();
+    } catch (...) {
+      fail();
+    }
+  });
+
+  std::thread runner([&]() {
+    try {
+      while (auto s = loaded.pop()) {
+        auto &slot = slots[*s];
+        slot.ok = slot.ok && run_stage(*slot.task, &Task::run);
+        computed.push(*s);
+      }
+      computed.close();
+    } catch (...) {
+      fail();
+    }
+  });
+
+  try {
+    while (auto s = computed.pop()) {
+      auto &slot = slots[*s];
+      slot.ok = slot.ok && run_stage(*slot.task, &Task::post_processing);
+      results[slot.index] = static_cast<char>(slot.ok);
+      free_slots.push(*s);
+    }
+  } catch (...) {
+    fail();
+  }
+  loader.join();
+  runner.join();
+  if (error) std::rethrow_exception(error);
+
+  return {results.begin(), results.end()};
+}
@@ -0,0 +1,4 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/registry/include/bench.hpp"
+
+int main(int argc, char **argv) { return ppc::core::bench_main(argc, argv); }
@@ -0,0 +1,19 @@
+// Copyright 2024 Nesterov Alexander
+#include <boost/mpi/communicator.hpp>
+#include <boost/mpi/environment.hpp>
+
+#include "core/hybrid/include/hybrid_mpi.hpp"
+#include "core/perf/include/perf_mpi.hpp"
+#include "core/registry/include/bench.hpp"
+#include "core/trace/include/trace_mpi.hpp"
+
+int main(int argc, char **argv) {
+  boost::mpi::environment env(argc, argv, ppc::core::HYBRID_THREADING);
+  boost::mpi::communicator world;
+  ppc::core::BenchHooks hooks;
+  hooks.configure = [&](ppc::core::PerfAttr &perfAttr) { ppc::core::set_mpi_timing(world, perfAttr); };
+  hooks.print = world.rank() == 0;
+  auto result = ppc::core::bench_main(argc, argv, hooks);
+  ppc::core::write_trace(world);
+  return result;
+}
@@ -0,0 +1,74 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "core/perf/func_tests/test_task.hpp"
+#include "core/registry/include/bench.hpp"
+#include "core/registry/include/registry.hpp"
+
+namespace {
+
+ppc::core::BenchInput generate_sum_input(uint64_t size) {
+  return ppc::core::make_bench_input(std::vector<uint32_t>(size, 1), std::vector<uint32_t>(1, 0),
+                                     [size](const std::vector<uint32_t> &out) { return out[0] == size; });
+}
+
+const ppc::core::TaskRegistrar registrar({"test/registry_sum",
+                                          [](std::shared_ptr<ppc::core::TaskData> taskData) {
+                                            return std::make_shared<ppc::test::TestTask<uint32_t>>(taskData);
+                                          },
+                                          generate_sum_input,
+                                          {10, 100}});
+
+}  // namespace
+
+TEST(registry_tests, check_registered_task) {
+  auto &registry = ppc::core::TaskRegistry::instance();
+  const auto &entry = registry.get("test/registry_sum");
+  EXPECT_EQ(entry.sizes, std::vector<uint64_t>({10, 100}));
+  EXPECT_EQ(registry.match("test/*"), std::vector<std::string>({"test/registry_sum"}));
+  EXPECT_EQ(registry.match("*sum"), std::vector<std::string>({"test/registry_sum"}));
+  EXPECT_TRUE(registry.match("seq/*").empty());
+  EXPECT_THROW((void)registry.get("test/unknown"), std::invalid_argument);
+}
+
+TEST(registry_tests, check_duplicate_and_incomplete_entries) {
+  auto &registry = ppc::core::TaskRegistry::instance();
+  auto entry = registry.get("test/registry_sum");
+  EXPECT_THROW(registry.add(entry), std::invalid_argument);
+  entry.name = "test/no_generator";
+  entry.generator = nullptr;
+  EXPECT_THROW(registry.add(entry), std::invalid_argument);
+}
+
+TEST(registry_tests, check_bench_options) {
+  auto options =
+      ppc::core::parse_bench_options({"--tasks=seq/*,mpi/example", "--sizes=10,20", "--reps=3", "--modes=task_run"});
+  EXPECT_EQ(options.tasks, std::vector<std::string>({"seq/*", "mpi/example"}));
+  EXPECT_EQ(options.sizes, std::vector<uint64_t>({10, 20}));
+  EXPECT_EQ(options.repetitions, 3U);
+  EXPECT_EQ(options.modes, std::vector<std::string>({"task_run"}));
+  EXPECT_THROW(ppc::core::parse_bench_options({"--reps=x"}), std::invalid_argument);
+  EXPECT_THROW(ppc::core::parse_bench_options({"--modes=fast"}), std::invalid_argument);
+  EXPECT_THROW(ppc::core::parse_bench_options({"--unknown"}), std::invalid_argument);
+}
+
+TEST(registry_tests, check_run_bench) {
+  auto options = ppc::core::parse_bench_options({"--tasks=test/registry_*", "--reps=2", "--warmup=0"});
+  int configured = 0;
+  ppc::core::BenchHooks hooks;
+  hooks.configure = [&](ppc::core::PerfAttr &perfAttr) {
+    EXPECT_EQ(perfAttr.num_running, 2U);
+    configured++;
+  };
+  EXPECT_EQ(ppc::core::run_bench(options, hooks), 0);
+  // two default sizes, two modes
+  EXPECT_EQ(configured, 4);
+
+  options.tasks = {"test/missing*"};
+  EXPECT_THROW(ppc::core::run_bench(options, hooks), std::invalid_argument);
+}
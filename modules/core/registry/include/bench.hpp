@@ -0,0 +1,47 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_BENCH_HPP_
+#define MODULES_CORE_INCLUDE_BENCH_HPP_
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "core/perf/include/perf.hpp"
+
+namespace ppc::core {
+
+struct BenchOptions {
+  // patterns of task names (empty - all registered tasks)
+  std::vector<std::string> tasks;
+  // input sizes (empty - default sizes of every task)
+  std::vector<uint64_t> sizes;
+  uint64_t repetitions = 10;
+  uint64_t warmup = 1;
+  // "pipeline" and/or "task_run"
+  std::vector<std::string> modes = {"pipeline", "task_run"};
+  // print names of selected tasks instead of running them
+  bool list = false;
+};
+
+// Parses --tasks=a,b*  --sizes=100,1000  --reps=N  --warmup=N  --modes=pipeline,task_run  --list
+// (arguments without program name), throws std::invalid_argument for unknown or malformed ones
+BenchOptions parse_bench_options(const std::vector<std::string> &args);
+
+// Backend specific setup of driver, e.g. MPI timing and printing on root only
+struct BenchHooks {
+  std::function<void(PerfAttr &)> configure;
+  bool print = true;
+};
+
+// Runs every selected task, size and mode with Perf from the same process and prints results
+// like perf tests do. Returns count of runs with failed check of outputs.
+int run_bench(const BenchOptions &options, const BenchHooks &hooks = {});
+
+// main() of bench driver: parses arguments and runs selected tasks
+int bench_main(int argc, char **argv, const BenchHooks &hooks = {});
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_BENCH_HPP_
@@ -0,0 +1,83 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_REGISTRY_HPP_
+#define MODULES_CORE_INCLUDE_REGISTRY_HPP_
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "core/task/include/task.hpp"
+
+namespace ppc::core {
+
+// Generated input of one benchmark run, storage owns buffers referenced by taskData
+struct BenchInput {
+  std::shared_ptr<TaskData> taskData;
+  std::shared_ptr<void> storage;
+  // checks outputs after runs (empty - no check)
+  std::function<bool()> check;
+};
+
+// Input of one input and one output buffer owned by returned BenchInput,
+// check gets outputs after runs
+template <typename In, typename Out>
+BenchInput make_bench_input(std::vector<In> in, std::vector<Out> out,
+                            std::function<bool(const std::vector<std::type_identity_t<Out>> &)> check = {}) {
+  auto in_ptr = std::make_shared<std::vector<In>>(std::move(in));
+  auto out_ptr = std::make_shared<std::vector<Out>>(std::move(out));
+  BenchInput input;
+  input.taskData = std::make_shared<TaskData>();
+  input.taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in_ptr->data()));
+  input.taskData->inputs_count.emplace_back(in_ptr->size());
+  input.taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out_ptr->data()));
+  input.taskData->outputs_count.emplace_back(out_ptr->size());
+  input.storage = std::make_shared<std::pair<decltype(in_ptr), decltype(out_ptr)>>(in_ptr, out_ptr);
+  if (check) {
+    input.check = [out_ptr, check] { return check(*out_ptr); };
+  }
+  return input;
+}
+
+struct TaskEntry {
+  // "<backend>/<task>" as in tasks directory, e.g. "seq/example"
+  std::string name;
+  std::function<std::shared_ptr<Task>(std::shared_ptr<TaskData>)> factory;
+  // creates input of given size, called on all processes of MPI task
+  std::function<BenchInput(uint64_t)> generator;
+  // sizes used when none are given to bench
+  std::vector<uint64_t> sizes;
+};
+
+// Tasks available to bench driver by name
+class TaskRegistry {
+ public:
+  static TaskRegistry &instance();
+
+  // throws std::invalid_argument for incomplete entry or already registered name
+  void add(TaskEntry entry);
+  // throws std::invalid_argument for unknown name
+  [[nodiscard]] const TaskEntry &get(const std::string &name) const;
+  // sorted names of all tasks
+  [[nodiscard]] std::vector<std::string> names() const;
+  // sorted names matching pattern, '*' in pattern matches any sequence of characters
+  [[nodiscard]] std::vector<std::string> match(const std::string &pattern) const;
+
+ private:
+  std::map<std::string, TaskEntry> entries;
+};
+
+// Registers task at static initialization, task library has to be linked as whole archive:
+//   static const ppc::core::TaskRegistrar registrar({"seq/example", factory, generator, {100}});
+struct TaskRegistrar {
+  explicit TaskRegistrar(TaskEntry entry);
+};
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_REGISTRY_HPP_
@@ -0,0 +1,132 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/registry/include/bench.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+
+#include "core/registry/include/registry.hpp"
+
+namespace {
+
+std::vector<std::string> split(const std::string &value) {
+  std::vector<std::string> items;
+  std::stringstream stream(value);
+  std::string item;
+  while (std::getline(stream, item, ',')) {
+    if (!item.empty()) items.push_back(item);
+  }
+  return items;
+}
+
+uint64_t parse_count(const std::string &name, const std::string &value) {
+  try {
+    size_t pos = 0;
+    auto count = std::stoull(value, &pos);
+    if (pos == value.size()) return count;
+  } catch (const std::exception &) {
+  }
+  throw std::invalid_argument("Wrong value of " + name + ": " + value);
+}
+
+}  // namespace
+
+ppc::core::BenchOptions ppc::core::parse_bench_options(const std::vector<std::string> &args) {
+  BenchOptions options;
+  for (const auto &arg : args) {
+    auto eq = arg.find('=');
+    auto name = arg.substr(0, eq);
+    auto value = eq == std::string::npos ? std::string() : arg.substr(eq + 1);
+    if (name == "--list") {
+      options.list = true;
+    } else if (name == "--tasks") {
+      options.tasks = split(value);
+    } else if (name == "--sizes") {
+      options.sizes.clear();
+      for (const auto &size : split(value)) options.sizes.push_back(parse_count(name, size));
+    } else if (name == "--reps") {
+      options.repetitions = parse_count(name, value);
+    } else if (name == "--warmup") {
+      options.warmup = parse_count(name, value);
+    } else if (name == "--modes") {
+      options.modes = split(value);
+      for (const auto &mode : options.modes) {
+        if (mode != "pipeline" && mode != "task_run") throw std::invalid_argument("Unknown mode: " + mode);
+      }
+    } else {
+      throw std::invalid_argument("Unknown argument: " + arg);
+    }
+  }
+  if (options.repetitions == 0) throw std::invalid_argument("--reps has to be positive");
+  return options;
+}
+
+int ppc::core::run_bench(const BenchOptions &options, const BenchHooks &hooks) {
+  const auto &registry = TaskRegistry::instance();
+  std::vector<std::string> names;
+  for (const auto &pattern : options.tasks.empty() ? std::vector<std::string>{"*"} : options.tasks) {
+    auto matched = registry.match(pattern);
+    if (matched.empty() && !options.tasks.empty()) throw std::invalid_argument("No tasks match: " + pattern);
+    for (auto &name : matched) {
+      if (std::find(names.begin(), names.end(), name) == names.end()) names.push_back(std::move(name));
+    }
+  }
+
+  if (options.list) {
+    if (hooks.print) {
+      for (const auto &name : names) std::cout << name << std::endl;
+    }
+    return 0;
+  }
+
+  int failed = 0;
+  const auto t0 = std::chrono::high_resolution_clock::now();
+  for (const auto &name : names) {
+    const auto &entry = registry.get(name);
+    for (auto size : options.sizes.empty() ? entry.sizes : options.sizes) {
+      for (const auto &mode : options.modes) {
+        auto input = entry.generator(size);
+        auto task = entry.factory(input.taskData);
+
+        auto perfAttr = std::make_shared<PerfAttr>();
+        perfAttr->num_running = options.repetitions;
+        perfAttr->num_warmup = options.warmup;
+        perfAttr->current_timer = [&] {
+          auto duration = std::chrono::high_resolution_clock::now() - t0;
+          return std::chrono::duration<double>(duration).count();
+        };
+        if (hooks.configure) hooks.configure(*perfAttr);
+
+        auto perfResults = std::make_shared<PerfResults>();
+        Perf perfAnalyzer(task);
+        if (mode == "pipeline") {
+          perfAnalyzer.pipeline_run(perfAttr, perfResults);
+        } else {
+          perfAnalyzer.task_run(perfAttr, perfResults);
+        }
+
+        if (hooks.print) {
+          Perf::print_perf_statistic("tasks/" + name, perfResults);
+        }
+        if (input.check && !input.check()) {
+          std::cerr << "Wrong result of " << name << " (size " << size << ", " << mode << ")" << std::endl;
+          failed++;
+        }
+      }
+    }
+  }
+  return failed;
+}
+
+int ppc::core::bench_main(int argc, char **argv, const BenchHooks &hooks) {
+  try {
+    auto options = parse_bench_options(std::vector<std::string>(argv + 1, argv + argc));
+    return run_bench(options, hooks) == 0 ? 0 : 1;
+  } catch (const std::invalid_argument &e) {
+    if (hooks.print) std::cerr << e.what() << std::endl;
+    return 2;
+  }
+}
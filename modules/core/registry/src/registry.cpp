@@ -0,0 +1,69 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/registry/include/registry.hpp"
+
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+// Glob matching with '*' only
+bool wildcard_match(const std::string &pattern, const std::string &text) {
+  size_t p = 0;
+  size_t t = 0;
+  size_t star = std::string::npos;
+  size_t star_text = 0;
+  while (t < text.size()) {
+    if (p < pattern.size() && pattern[p] == '*') {
+      star = p++;
+      star_text = t;
+    } else if (p < pattern.size() && pattern[p] == text[t]) {
+      p++;
+      t++;
+    } else if (star != std::string::npos) {
+      p = star + 1;
+      t = ++star_text;
+    } else {
+      return false;
+    }
+  }
+  while (p < pattern.size() && pattern[p] == '*') p++;
+  return p == pattern.size();
+}
+
+}  // namespace
+
+ppc::core::TaskRegistry &ppc::core::TaskRegistry::instance() {
+  static TaskRegistry registry;
+  return registry;
+}
+
+void ppc::core::TaskRegistry::add(TaskEntry entry) {
+  if (entry.name.empty() || !entry.factory || !entry.generator) {
+    throw std::invalid_argument("Task entry needs name, factory and generator: " + entry.name);
+  }
+  if (entries.count(entry.name) != 0) {
+    throw std::invalid_argument("Task is already registered: " + entry.name);
+  }
+  auto name = entry.name;
+  entries.emplace(std::move(name), std::move(entry));
+}
+
+const ppc::core::TaskEntry &ppc::core::TaskRegistry::get(const std::string &name) const {
+  auto it = entries.find(name);
+  if (it == entries.end()) {
+    throw std::invalid_argument("Unknown task: " + name);
+  }
+  return it->second;
+}
+
+std::vector<std::string> ppc::core::TaskRegistry::names() const { return match("*"); }
+
+std::vector<std::string> ppc::core::TaskRegistry::match(const std::string &pattern) const {
+  std::vector<std::string> result;
+  for (const auto &[name, entry] : entries) {
+    if (wildcard_match(pattern, name)) result.push_back(name);
+  }
+  return result;
+}
+
+ppc::core::TaskRegistrar::TaskRegistrar(TaskEntry entry) { TaskRegistry::instance().add(std::move(entry)); }
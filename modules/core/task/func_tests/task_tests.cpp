@@ -154,6 +154,105 @@ TEST(task_tests, check_wrong_order) {
   ASSERT_ANY_THROW(testTask.post_processing());
 }
 
+TEST(task_tests, check_stage_time_points) {
+  // Create data
+  std::vector<int32_t> in(20, 1);
+  std::vector<int32_t> out(1, 0);
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  ppc::test::TestTask<int32_t> testTask(taskData);
+  ASSERT_EQ(testTask.validation(), true);
+  testTask.pre_processing();
+  testTask.run();
+  testTask.post_processing();
+
+  const auto &points = testTask.get_stage_time_points();
+  for (size_t i = 1; i < points.size(); i++) {
+    EXPECT_LE(points[i - 1], points[i]);
+  }
+  EXPECT_NE(points[0].time_since_epoch().count(), 0);
+}
+
+TEST(task_tests, check_typed_views) {
+  // Create data
+  std::vector<double> in(20, 1.0);
+  std::vector<double> out(1, 0.0);
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  auto input = taskData->input_view<double>(0);
+  auto output = taskData->output_view<double>(0);
+  ASSERT_EQ(input.size(), in.size());
+  EXPECT_EQ(input.data(), in.data());
+  output[0] = 5.0;
+  EXPECT_EQ(out[0], 5.0);
+
+  EXPECT_THROW((void)taskData->input_view<double>(1), std::invalid_argument);
+  taskData->inputs[0] = reinterpret_cast<uint8_t *>(in.data()) + 1;
+  EXPECT_THROW((void)taskData->input_view<double>(0), std::invalid_argument);
+  taskData->inputs_count[0] = 0;
+  EXPECT_TRUE(taskData->input_view<double>(0).empty());
+}
+
+TEST(task_tests, check_reset_and_rebind) {
+  // Create data
+  std::vector<int32_t> in(20, 1);
+  std::vector<int32_t> out(1, 0);
+  std::vector<int32_t> other_in(30, 2);
+  std::vector<int32_t> other_out(1, 0);
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  std::shared_ptr<ppc::core::TaskData> otherTaskData = std::make_shared<ppc::core::TaskData>();
+  otherTaskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(other_in.data()));
+  otherTaskData->inputs_count.emplace_back(other_in.size());
+  otherTaskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(other_out.data()));
+  otherTaskData->outputs_count.emplace_back(other_out.size());
+
+  // Create Task and break its order
+  ppc::test::TestTask<int32_t> testTask(taskData);
+  ASSERT_EQ(testTask.validation(), true);
+  ASSERT_ANY_THROW(testTask.run());
+  ASSERT_ANY_THROW(testTask.pre_processing());
+
+  // Reset clears tracking of order
+  testTask.reset();
+  for (int i = 0; i < 1000; i++) {
+    ASSERT_EQ(testTask.validation(), true);
+    testTask.pre_processing();
+    testTask.run();
+    testTask.post_processing();
+  }
+  ASSERT_EQ(static_cast<size_t>(out[0]), in.size());
+
+  // Rebind in the middle of pipeline starts from validation with new data
+  testTask.validation();
+  testTask.rebind(otherTaskData);
+  EXPECT_EQ(otherTaskData->state_of_testing, ppc::core::TaskData::StateOfTesting::FUNC);
+  ASSERT_EQ(testTask.validation(), true);
+  testTask.pre_processing();
+  testTask.run();
+  testTask.post_processing();
+  ASSERT_EQ(static_cast<size_t>(other_out[0]), 2 * other_in.size());
+}
+
 int main(int argc, char **argv) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -3,32 +3,79 @@
 #ifndef MODULES_CORE_INCLUDE_TASK_HPP_
 #define MODULES_CORE_INCLUDE_TASK_HPP_
 
+#include <array>
 #include <chrono>
 #include <cstdint>
 #include <iostream>
 #include <memory>
+#include <span>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
+#include "core/arena/include/arena.hpp"
+
 namespace ppc::core {
 
+namespace detail {
+
+template <class T>
+std::span<T> make_view(const std::vector<uint8_t *> &buffers, const std::vector<std::uint32_t> &counts, size_t index,
+                       const std::string &kind) {
+  if (index >= buffers.size() || index >= counts.size()) {
+    throw std::invalid_argument("No " + kind + " buffer with index " + std::to_string(index));
+  }
+  auto *ptr = buffers[index];
+  if (counts[index] == 0) return {};
+  if (ptr == nullptr) {
+    throw std::invalid_argument("Null " + kind + " buffer with index " + std::to_string(index));
+  }
+  if (reinterpret_cast<std::uintptr_t>(ptr) % alignof(T) != 0) {
+    throw std::invalid_argument("Misaligned " + kind + " buffer with index " + std::to_string(index));
+  }
+  return {reinterpret_cast<T *>(ptr), counts[index]};
+}
+
+}  // namespace detail
+
 struct TaskData {
   std::vector<uint8_t *> inputs;
   std::vector<std::uint32_t> inputs_count;
   std::vector<uint8_t *> outputs;
   std::vector<std::uint32_t> outputs_count;
   enum StateOfTesting { FUNC, PERF } state_of_testing;
+
+  // Typed views of caller's memory without copying, sizes are taken from inputs_count/outputs_count.
+  // Throw std::invalid_argument for missing, null or misaligned buffers
+  template <class T>
+  [[nodiscard]] std::span<const T> input_view(size_t index) const {
+    return detail::make_view<const T>(inputs, inputs_count, index, "input");
+  }
+  template <class T>
+  [[nodiscard]] std::span<T> output_view(size_t index) const {
+    return detail::make_view<T>(outputs, outputs_count, index, "output");
+  }
 };
 
 // Memory of inputs and outputs need to be initialized before create object of
 // Task class
 class Task {
  public:
+  using time_point = std::chrono::high_resolution_clock::time_point;
+  static constexpr size_t NUM_STAGES = 4;
+
   explicit Task(std::shared_ptr<TaskData> taskData_);
 
   // set input and output data
   void set_data(std::shared_ptr<TaskData> taskData_);
 
+  // prepare task for next pipeline: clear order tracking and stage time points in O(1),
+  // buffers of arena and capacity of task's containers are kept
+  virtual void reset();
+
+  // reset task and bind it to new input and output data, keeping current state of testing
+  void rebind(std::shared_ptr<TaskData> taskData_);
+
   // validation of data and validation of task attributes before running
   virtual bool validation() = 0;
 
@@ -44,19 +91,37 @@ class Task {
   // get input and output data
   [[nodiscard]] std::shared_ptr<TaskData> get_data() const;
 
+  // time points of the last entry to validation, pre_processing, run and post_processing
+  [[nodiscard]] const std::array<time_point, NUM_STAGES> &get_stage_time_points() const;
+
+  // ends timeline span of stage entered last, otherwise it lasts till next stage is entered or task is reset
+  void end_stage();
+
   virtual ~Task();
 
  protected:
   void internal_order_test(const std::string &str = __builtin_FUNCTION());
   std::shared_ptr<TaskData> taskData;
+  // aligned working buffers that live as long as the task, see BufferArena
+  BufferArena arena;
 
  private:
-  std::vector<std::string> functions_order;
+  void clear_order_test();
+  // count of stage calls since last reset, last called stage and error of broken order
+  uint64_t num_calls = 0;
+  std::string last_function;
+  std::string order_error;
   std::vector<std::string> right_functions_order = {"validation", "pre_processing", "run", "post_processing"};
   const double max_test_time = 1.0;
-  std::chrono::high_resolution_clock::time_point tmp_time_point;
+  std::array<time_point, NUM_STAGES> stage_time_points{};
+  size_t trace_stage = 0;
+  int64_t trace_stage_begin = -1;
 };
 
+// Calls stage of task (e.g. &Task::run) and ends its timeline span when it returns or throws, so runners (Perf,
+// pipelines, batches) don't add their own time between stages to spans of stages
+bool run_stage(Task &task, bool (Task::*stage)());
+
 }  // namespace ppc::core
 
 #endif  // MODULES_CORE_INCLUDE_TASK_HPP_
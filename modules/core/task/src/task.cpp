@@ -6,36 +6,77 @@
 #include <stdexcept>
 #include <utility>
 
+#include "core/trace/include/trace.hpp"
+
+namespace {
+
+constexpr std::array<const char *, ppc::core::Task::NUM_STAGES> STAGE_NAMES = {"validation", "pre_processing", "run",
+                                                                               "post_processing"};
+
+}  // namespace
+
 void ppc::core::Task::set_data(std::shared_ptr<TaskData> taskData_) {
   taskData_->state_of_testing = TaskData::StateOfTesting::FUNC;
-  functions_order.clear();
+  clear_order_test();
+  taskData = std::move(taskData_);
+}
+
+void ppc::core::Task::reset() { clear_order_test(); }
+
+void ppc::core::Task::clear_order_test() {
+  end_stage();
+  num_calls = 0;
+  last_function.clear();
+  order_error.clear();
+  stage_time_points.fill(time_point());
+}
+
+void ppc::core::Task::end_stage() {
+  if (trace_stage_begin < 0) return;
+  Tracer::instance().record(STAGE_NAMES[trace_stage], "stage", trace_stage_begin, Tracer::now_ns());
+  trace_stage_begin = -1;
+}
+
+void ppc::core::Task::rebind(std::shared_ptr<TaskData> taskData_) {
+  if (taskData) {
+    taskData_->state_of_testing = taskData->state_of_testing;
+  }
+  reset();
   taskData = std::move(taskData_);
 }
 
 std::shared_ptr<ppc::core::TaskData> ppc::core::Task::get_data() const { return taskData; }
 
+const std::array<ppc::core::Task::time_point, ppc::core::Task::NUM_STAGES>& ppc::core::Task::get_stage_time_points()
+    const {
+  return stage_time_points;
+}
+
 ppc::core::Task::Task(std::shared_ptr<TaskData> taskData_) { set_data(std::move(taskData_)); }
 
 void ppc::core::Task::internal_order_test(const std::string& str) {
-  if (!functions_order.empty() && str == functions_order.back() && str == "run") return;
+  auto now = std::chrono::high_resolution_clock::now();
+  if (!order_error.empty()) throw std::invalid_argument(order_error);
+  if (num_calls > 0 && str == last_function && str == "run") return;
 
-  functions_order.push_back(str);
-
-  for (size_t i = 0; i < functions_order.size(); i++) {
-    if (functions_order[i] != right_functions_order[i % right_functions_order.size()]) {
-      throw std::invalid_argument("ORDER OF FUCTIONS IS NOT RIGHT: \n" + std::string("Serial number: ") +
-                                  std::to_string(i + 1) + "\n" + std::string("Yours function: ") + functions_order[i] +
-                                  "\n" + std::string("Expected function: ") + right_functions_order[i]);
-    }
+  auto stage = num_calls % right_functions_order.size();
+  const auto& expected = right_functions_order[stage];
+  if (str != expected) {
+    order_error = "ORDER OF FUCTIONS IS NOT RIGHT: \n" + std::string("Serial number: ") + std::to_string(num_calls + 1) +
+                  "\n" + std::string("Yours function: ") + str + "\n" + std::string("Expected function: ") + expected;
+    throw std::invalid_argument(order_error);
   }
-
-  if (str == "pre_processing" && taskData->state_of_testing == TaskData::StateOfTesting::FUNC) {
-    tmp_time_point = std::chrono::high_resolution_clock::now();
+  num_calls++;
+  last_function = str;
+  stage_time_points[stage] = now;
+  end_stage();
+  if (Tracer::instance().enabled()) {
+    trace_stage = stage;
+    trace_stage_begin = Tracer::now_ns();
   }
 
   if (str == "post_processing" && taskData->state_of_testing == TaskData::StateOfTesting::FUNC) {
-    auto end = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - tmp_time_point).count();
+    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(now - stage_time_points[1]).count();
     auto current_time = static_cast<double>(duration) * 1e-9;
     if (current_time > max_test_time) {
       std::cerr << "Current test work more than " << max_test_time << " secs: " << current_time << std::endl;
@@ -44,4 +85,12 @@ void ppc::core::Task::internal_order_test(const std::string& str) {
   }
 }
 
-ppc::core::Task::~Task() { functions_order.clear(); }
+ppc::core::Task::~Task() { end_stage(); }
+
+bool ppc::core::run_stage(Task& task, bool (Task::*stage)()) {
+  struct StageEnd {
+    Task& task;
+    ~StageEnd() { task.end_stage(); }
+  } end{task};
+  return (task.*stage)();
+}
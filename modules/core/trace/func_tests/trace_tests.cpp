@@ -0,0 +1,154 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/task/func_tests/test_task.hpp"
+#include "core/trace/include/trace.hpp"
+
+namespace {
+
+std::vector<std::string> names_of(const std::vector<ppc::core::TraceEvent> &events, const std::string &category) {
+  std::vector<std::string> names;
+  for (const auto &event : events) {
+    if (event.category == category) names.emplace_back(event.name);
+  }
+  return names;
+}
+
+}  // namespace
+
+TEST(trace_tests, check_stages_and_scopes) {
+  auto &tracer = ppc::core::Tracer::instance();
+  tracer.clear();
+  tracer.enable();
+
+  std::vector<int32_t> in(20, 1);
+  std::vector<int32_t> out(1, 0);
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+  {
+    PPC_TRACE_SCOPE("pipeline");
+    ppc::test::TestTask<int32_t> testTask(taskData);
+    ASSERT_TRUE(testTask.validation());
+    testTask.pre_processing();
+    testTask.run();
+    testTask.run();
+    testTask.post_processing();
+  }
+  std::thread worker([] { PPC_TRACE_SCOPE("worker"); });
+  worker.join();
+  tracer.disable();
+  {
+    PPC_TRACE_SCOPE("disabled");
+  }
+
+  auto events = tracer.events();
+  EXPECT_EQ(names_of(events, "stage"),
+            (std::vector<std::string>{"validation", "pre_processing", "run", "post_processing"}));
+  EXPECT_EQ(names_of(events, "user"), (std::vector<std::string>{"pipeline", "worker"}));
+  const auto &pipeline = events.front();
+  ASSERT_EQ(std::string(pipeline.name), "pipeline");
+  for (const auto &event : events) {
+    EXPECT_GE(event.duration_ns, 0);
+    if (std::string(event.category) == "stage") {
+      EXPECT_EQ(event.tid, pipeline.tid);
+      EXPECT_GE(event.begin_ns, pipeline.begin_ns);
+      EXPECT_LE(event.begin_ns + event.duration_ns, pipeline.begin_ns + pipeline.duration_ns);
+    } else if (std::string(event.name) == "worker") {
+      EXPECT_NE(event.tid, pipeline.tid);
+    }
+  }
+  tracer.clear();
+}
+
+TEST(trace_tests, check_full_buffer_keeps_newest) {
+  auto &tracer = ppc::core::Tracer::instance();
+  tracer.clear();
+  tracer.enable(4);
+  std::thread worker([&] {
+    for (int64_t i = 0; i < 10; i++) tracer.record("event", "ring", i, i + 1);
+  });
+  worker.join();
+  tracer.disable();
+
+  auto events = tracer.events();
+  ASSERT_EQ(names_of(events, "ring").size(), 4U);
+  EXPECT_EQ(events.front().begin_ns, 6);
+  EXPECT_EQ(events.back().begin_ns, 9);
+  EXPECT_EQ(tracer.dropped(), 6U);
+  tracer.clear();
+  EXPECT_EQ(tracer.dropped(), 0U);
+  EXPECT_TRUE(tracer.events().empty());
+  EXPECT_THROW(tracer.enable(0), std::invalid_argument);
+  tracer.enable(ppc::core::Tracer::DEFAULT_CAPACITY);
+  tracer.disable();
+}
+
+TEST(trace_tests, check_chrome_json) {
+  auto &tracer = ppc::core::Tracer::instance();
+  tracer.clear();
+  tracer.enable();
+  tracer.record("send \"halo\"", "mpi", 2000, 3500);
+  tracer.disable();
+
+  auto fragment = tracer.json_events(3, 1000, "rank 3");
+  EXPECT_NE(fragment.find(R"("name":"process_name","ph":"M","pid":3)"), std::string::npos);
+  EXPECT_NE(fragment.find(R"("args":{"name":"rank 3"})"), std::string::npos);
+  EXPECT_NE(fragment.find(R"("name":"thread_name")"), std::string::npos);
+  EXPECT_NE(fragment.find(R"({"name":"send \"halo\"","cat":"mpi","ph":"X","ts":3.000,"dur":1.500,"pid":3,)"),
+            std::string::npos);
+
+  auto path = (std::filesystem::temp_directory_path() / "ppc_trace_tests.json").string();
+  tracer.write(path);
+  std::ifstream file(path);
+  std::stringstream content;
+  content << file.rdbuf();
+  EXPECT_EQ(content.str().rfind(R"({"displayTimeUnit":"ms","otherData":{"dropped_events":0},"traceEvents":[)", 0),
+            0U);
+  EXPECT_NE(content.str().find(R"("ts":2.000,"dur":1.500,"pid":0,)"), std::string::npos);
+  EXPECT_EQ(content.str().substr(content.str().size() - 4), "\n]}\n");
+  std::filesystem::remove(path);
+  tracer.clear();
+}
+
+TEST(trace_tests, check_stage_span_ends_with_stage) {
+  auto &tracer = ppc::core::Tracer::instance();
+  tracer.clear();
+  tracer.enable();
+
+  std::vector<int32_t> in(20, 1);
+  std::vector<int32_t> out(1, 0);
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+  ppc::test::TestTask<int32_t> testTask(taskData);
+  const auto gap = std::chrono::milliseconds(20);
+  for (auto stage : {&ppc::core::Task::validation, &ppc::core::Task::pre_processing, &ppc::core::Task::run,
+                     &ppc::core::Task::post_processing}) {
+    ASSERT_TRUE(ppc::core::run_stage(testTask, stage));
+    // time of runner between stages isn't part of stage
+    std::this_thread::sleep_for(gap);
+  }
+  // last stage is recorded without waiting for next one
+  auto events = tracer.events();
+  tracer.disable();
+  EXPECT_EQ(names_of(events, "stage"),
+            (std::vector<std::string>{"validation", "pre_processing", "run", "post_processing"}));
+  for (const auto &event : events) {
+    EXPECT_LT(event.duration_ns, std::chrono::nanoseconds(gap).count());
+  }
+  tracer.clear();
+}
@@ -0,0 +1,103 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_TRACE_HPP_
+#define MODULES_CORE_INCLUDE_TRACE_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace ppc::core {
+
+// Region of time on one thread, name and category have to be string literals (or live until trace is written)
+struct TraceEvent {
+  const char *name = "";
+  const char *category = "";
+  int64_t begin_ns = 0;
+  int64_t duration_ns = 0;
+  uint32_t tid = 0;
+};
+
+// Timeline of task stages, MPI calls and user regions in Chrome trace format (opens in Perfetto or
+// chrome://tracing). Every thread records to its own ring buffer without locks, oldest events are
+// overwritten when buffer is full; buffers are read when recording threads are idle.
+// Enabled by PPC_TRACE=<output.json> (written at exit or by write_trace of trace_mpi.hpp) or enable().
+// The instance is never destroyed, so threads can record till process exit.
+class Tracer {
+ public:
+  static constexpr size_t DEFAULT_CAPACITY = size_t{1} << 16;
+  // ring of events of one thread, defined in trace.cpp
+  struct ThreadBuffer;
+
+  static Tracer &instance();
+  // monotonic time of events
+  static int64_t now_ns();
+
+  [[nodiscard]] bool enabled() const { return active.load(std::memory_order_relaxed); }
+  // capacity applies to buffers of threads recording for the first time
+  void enable(size_t events_per_thread = DEFAULT_CAPACITY);
+  void disable();
+
+  void record(const char *name, const char *category, int64_t begin_ns, int64_t end_ns);
+
+  // events of all threads ordered by begin time
+  [[nodiscard]] std::vector<TraceEvent> events() const;
+  // count of events overwritten in full buffers
+  [[nodiscard]] uint64_t dropped() const;
+  void clear();
+
+  // Comma separated JSON objects of events and names of process pid and its threads,
+  // timestamps are shifted by offset_ns (to clock of other process)
+  [[nodiscard]] std::string json_events(int pid, int64_t offset_ns = 0, const std::string &process_name = {}) const;
+  // Write trace of this process
+  void write(const std::string &path) const;
+  // Write trace document of json_events fragments of processes
+  static void write_json(const std::string &path, const std::vector<std::string> &fragments, uint64_t dropped_events);
+
+  // PPC_TRACE output, empty if tracing wasn't requested by environment
+  [[nodiscard]] const std::string &output() const { return output_path; }
+  // trace is already written for this run, nothing is written at exit
+  void set_written() { trace_written = true; }
+  [[nodiscard]] bool written() const { return trace_written; }
+
+ private:
+  Tracer();
+  ThreadBuffer &thread_buffer();
+
+  std::atomic<bool> active{false};
+  std::atomic<size_t> capacity{DEFAULT_CAPACITY};
+  mutable std::mutex buffers_mutex;
+  std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+  std::string output_path;
+  std::atomic<bool> trace_written{false};
+};
+
+// Records region from construction to destruction if tracing is enabled
+class TraceScope {
+ public:
+  explicit TraceScope(const char *name_, const char *category_ = "user")
+      : name(name_), category(category_), begin(Tracer::instance().enabled() ? Tracer::now_ns() : -1) {}
+  TraceScope(const TraceScope &) = delete;
+  TraceScope &operator=(const TraceScope &) = delete;
+  ~TraceScope() {
+    if (begin >= 0) Tracer::instance().record(name, category, begin, Tracer::now_ns());
+  }
+
+ private:
+  const char *name;
+  const char *category;
+  int64_t begin;
+};
+
+}  // namespace ppc::core
+
+#define PPC_TRACE_CONCAT_IMPL(a, b) a##b
+#define PPC_TRACE_CONCAT(a, b) PPC_TRACE_CONCAT_IMPL(a, b)
+// Annotate region of code till end of scope: PPC_TRACE_SCOPE("exchange halo");
+#define PPC_TRACE_SCOPE(name) const ppc::core::TraceScope PPC_TRACE_CONCAT(ppc_trace_scope_, __LINE__)(name)
+
+#endif  // MODULES_CORE_INCLUDE_TRACE_HPP_
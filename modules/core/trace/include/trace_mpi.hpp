@@ -0,0 +1,70 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_TRACE_MPI_HPP_
+#define MODULES_CORE_INCLUDE_TRACE_MPI_HPP_
+
+#include <boost/mpi/collectives.hpp>
+#include <boost/mpi/communicator.hpp>
+#include <boost/serialization/string.hpp>
+#include <boost/serialization/vector.hpp>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "core/trace/include/trace.hpp"
+
+namespace ppc::core {
+
+// Offset from steady clock of this rank to clock of root, estimated by Cristian's algorithm: root answers
+// pings of every rank with its time, the ping with the smallest round trip gives the estimate.
+inline int64_t trace_clock_offset(const boost::mpi::communicator &world, int root = 0, int rounds = 16) {
+  const int tag = 7301;
+  int64_t offset = 0;
+  if (world.rank() == root) {
+    for (int rank = 0; rank < world.size(); rank++) {
+      if (rank == root) continue;
+      for (int i = 0; i < rounds; i++) {
+        world.recv(rank, tag);
+        world.send(rank, tag, Tracer::now_ns());
+      }
+    }
+    return offset;
+  }
+  auto best_round_trip = std::numeric_limits<int64_t>::max();
+  for (int i = 0; i < rounds; i++) {
+    auto sent = Tracer::now_ns();
+    world.send(root, tag);
+    int64_t root_time = 0;
+    world.recv(root, tag, root_time);
+    auto received = Tracer::now_ns();
+    if (received - sent < best_round_trip) {
+      best_round_trip = received - sent;
+      offset = root_time - (sent + (received - sent) / 2);
+    }
+  }
+  return offset;
+}
+
+// Writes one trace of all ranks of world to path on root: every rank is a process of timeline and its
+// events are moved to clock of root. Has to be called on all ranks before MPI is finalized, stops tracing.
+// Nothing is done if path is empty, by default it's PPC_TRACE.
+inline void write_trace(const boost::mpi::communicator &world, const std::string &path = Tracer::instance().output(),
+                        int root = 0) {
+  auto &tracer = Tracer::instance();
+  if (path.empty()) return;
+  tracer.disable();
+  auto offset = trace_clock_offset(world, root);
+  auto fragment = tracer.json_events(world.rank(), offset, "rank " + std::to_string(world.rank()));
+  uint64_t dropped = 0;
+  boost::mpi::reduce(world, tracer.dropped(), dropped, std::plus<uint64_t>(), root);
+  std::vector<std::string> fragments;
+  boost::mpi::gather(world, fragment, fragments, root);
+  if (world.rank() == root) Tracer::write_json(path, fragments, dropped);
+  tracer.set_written();
+}
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_TRACE_MPI_HPP_
@@ -0,0 +1,238 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/trace/include/trace.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::string get_env(const char *name) {
+#ifdef _MSC_VER
+  char *buf = nullptr;
+  size_t len = 0;
+  if (_dupenv_s(&buf, &len, name) != 0 || buf == nullptr) return {};
+  std::string value(buf);
+  free(buf);
+  return value;
+#else
+  const char *value = std::getenv(name);
+  return value != nullptr ? value : "";
+#endif
+}
+
+// Rank of process started by mpirun and count of processes, {0, 1} otherwise
+std::pair<int, int> launcher_rank() {
+  for (const auto &[rank, size] : {std::pair{"OMPI_COMM_WORLD_RANK", "OMPI_COMM_WORLD_SIZE"},
+                                   std::pair{"PMI_RANK", "PMI_SIZE"}, std::pair{"PMIX_RANK", "PMI_SIZE"}}) {
+    auto rank_value = get_env(rank);
+    auto size_value = get_env(size);
+    if (!rank_value.empty() && !size_value.empty()) {
+      try {
+        return {std::stoi(rank_value), std::stoi(size_value)};
+      } catch (const std::exception &) {
+        continue;
+      }
+    }
+  }
+  return {0, 1};
+}
+
+void write_escaped(std::ostream &out, const char *text) {
+  for (const char *c = text; *c != '\0'; c++) {
+    if (*c == '"' || *c == '\\') {
+      out << '\\' << *c;
+    } else if (static_cast<unsigned char>(*c) < 0x20) {
+      out << ' ';
+    } else {
+      out << *c;
+    }
+  }
+}
+
+// Chrome trace timestamps are microseconds
+void write_us(std::ostream &out, int64_t ns) { out << std::fixed << std::setprecision(3) << ns / 1000.0; }
+
+// Trace of every process if program exits without write_trace
+void write_at_exit() {
+  auto &tracer = ppc::core::Tracer::instance();
+  if (tracer.written()) return;
+  auto path = tracer.output();
+  auto [rank, size] = launcher_rank();
+  if (size > 1) path += ".rank" + std::to_string(rank);
+  try {
+    tracer.write(path);
+  } catch (const std::exception &e) {
+    std::fprintf(stderr, "%s\n", e.what());
+  }
+}
+
+}  // namespace
+
+struct ppc::core::Tracer::ThreadBuffer {
+  std::vector<TraceEvent> slots;
+  // events recorded since clear, owner thread is the only writer
+  std::atomic<uint64_t> count{0};
+  std::atomic<bool> in_use{true};
+  uint32_t tid = 0;
+};
+
+namespace {
+
+// Returns buffer of exited thread to the tracer, next new thread continues its timeline
+struct BufferLease {
+  std::atomic<bool> *in_use = nullptr;
+  ~BufferLease() {
+    if (in_use != nullptr) in_use->store(false, std::memory_order_release);
+  }
+};
+
+thread_local BufferLease lease;
+thread_local ppc::core::Tracer::ThreadBuffer *local_buffer = nullptr;
+
+}  // namespace
+
+ppc::core::Tracer::Tracer() {
+  output_path = get_env("PPC_TRACE");
+  if (!output_path.empty()) {
+    active = true;
+    std::atexit(write_at_exit);
+  }
+}
+
+ppc::core::Tracer &ppc::core::Tracer::instance() {
+  static auto *tracer = new Tracer();
+  return *tracer;
+}
+
+int64_t ppc::core::Tracer::now_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void ppc::core::Tracer::enable(size_t events_per_thread) {
+  if (events_per_thread == 0) throw std::invalid_argument("Trace buffer can't be empty");
+  capacity = events_per_thread;
+  active = true;
+}
+
+void ppc::core::Tracer::disable() { active = false; }
+
+ppc::core::Tracer::ThreadBuffer &ppc::core::Tracer::thread_buffer() {
+  if (local_buffer != nullptr) return *local_buffer;
+  std::lock_guard lock(buffers_mutex);
+  for (auto &buffer : buffers) {
+    if (buffer->slots.size() != capacity) continue;
+    bool expected = false;
+    if (buffer->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+      local_buffer = buffer.get();
+      break;
+    }
+  }
+  if (local_buffer == nullptr) {
+    buffers.push_back(std::make_unique<ThreadBuffer>());
+    local_buffer = buffers.back().get();
+    local_buffer->slots.resize(capacity);
+    local_buffer->tid = static_cast<uint32_t>(buffers.size());
+  }
+  lease.in_use = &local_buffer->in_use;
+  return *local_buffer;
+}
+
+void ppc::core::Tracer::record(const char *name, const char *category, int64_t begin_ns, int64_t end_ns) {
+  if (!enabled()) return;
+  auto &buffer = thread_buffer();
+  auto index = buffer.count.load(std::memory_order_relaxed);
+  buffer.slots[index % buffer.slots.size()] = {name, category, begin_ns, end_ns - begin_ns, buffer.tid};
+  buffer.count.store(index + 1, std::memory_order_release);
+}
+
+std::vector<ppc::core::TraceEvent> ppc::core::Tracer::events() const {
+  std::vector<TraceEvent> result;
+  {
+    std::lock_guard lock(buffers_mutex);
+    for (const auto &buffer : buffers) {
+      auto count = buffer->count.load(std::memory_order_acquire);
+      auto size = static_cast<uint64_t>(buffer->slots.size());
+      // oldest retained event first
+      for (auto i = count > size ? count - size : 0; i < count; i++) {
+        result.push_back(buffer->slots[i % size]);
+      }
+    }
+  }
+  std::stable_sort(result.begin(), result.end(),
+                   [](const TraceEvent &a, const TraceEvent &b) { return a.begin_ns < b.begin_ns; });
+  return result;
+}
+
+uint64_t ppc::core::Tracer::dropped() const {
+  std::lock_guard lock(buffers_mutex);
+  uint64_t result = 0;
+  for (const auto &buffer : buffers) {
+    auto count = buffer->count.load(std::memory_order_acquire);
+    auto size = static_cast<uint64_t>(buffer->slots.size());
+    if (count > size) result += count - size;
+  }
+  return result;
+}
+
+void ppc::core::Tracer::clear() {
+  std::lock_guard lock(buffers_mutex);
+  for (auto &buffer : buffers) buffer->count.store(0, std::memory_order_release);
+}
+
+std::string ppc::core::Tracer::json_events(int pid, int64_t offset_ns, const std::string &process_name) const {
+  auto recorded = events();
+  std::vector<uint32_t> tids;
+  for (const auto &event : recorded) tids.push_back(event.tid);
+  std::sort(tids.begin(), tids.end());
+  tids.erase(std::unique(tids.begin(), tids.end()), tids.end());
+
+  std::ostringstream out;
+  auto name = process_name.empty() ? "process " + std::to_string(pid) : process_name;
+  out << R"({"name":"process_name","ph":"M","pid":)" << pid << R"(,"tid":0,"args":{"name":")";
+  write_escaped(out, name.c_str());
+  out << R"("}},)" << '\n';
+  out << R"({"name":"process_sort_index","ph":"M","pid":)" << pid << R"(,"tid":0,"args":{"sort_index":)" << pid
+      << "}}";
+  for (auto tid : tids) {
+    out << ",\n"
+        << R"({"name":"thread_name","ph":"M","pid":)" << pid << R"(,"tid":)" << tid << R"(,"args":{"name":"thread )"
+        << tid << R"("}})";
+  }
+  for (const auto &event : recorded) {
+    out << ",\n" << R"({"name":")";
+    write_escaped(out, event.name);
+    out << R"(","cat":")";
+    write_escaped(out, event.category);
+    out << R"(","ph":"X","ts":)";
+    write_us(out, event.begin_ns + offset_ns);
+    out << R"(,"dur":)";
+    write_us(out, event.duration_ns);
+    out << R"(,"pid":)" << pid << R"(,"tid":)" << event.tid << "}";
+  }
+  return out.str();
+}
+
+void ppc::core::Tracer::write(const std::string &path) const {
+  write_json(path, {json_events(launcher_rank().first)}, dropped());
+}
+
+void ppc::core::Tracer::write_json(const std::string &path, const std::vector<std::string> &fragments,
+                                   uint64_t dropped_events) {
+  std::ofstream file(path);
+  if (!file.is_open()) throw std::invalid_argument("Can't write trace " + path);
+  file << R"({"displayTimeUnit":"ms","otherData":{"dropped_events":)" << dropped_events << R"(},"traceEvents":[)";
+  for (size_t i = 0; i < fragments.size(); i++) {
+    file << (i == 0 ? "\n" : ",\n") << fragments[i];
+  }
+  file << "\n]}\n";
+  if (!file) throw std::invalid_argument("Can't write trace " + path);
+}
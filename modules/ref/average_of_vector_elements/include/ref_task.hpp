@@ -6,9 +6,9 @@
 #include <gtest/gtest.h>
 
 #include <memory>
-#include <numeric>
 #include <vector>
 
+#include "core/coll/include/reduce_ops.hpp"
 #include "core/task/include/task.hpp"
 
 namespace ppc {
@@ -39,7 +39,9 @@ class AverageOfVectorElements : public ppc::core::Task {
 
   bool run() override {
     internal_order_test();
-    average = static_cast<OutType>(std::accumulate(input_.begin(), input_.end(), 0.0));
+    // compensated sum keeps average of long vectors of floating point values exact
+    auto sum = ppc::coll::fold(input_.data(), input_.size(), ppc::coll::KahanSum<OutType>());
+    average = ppc::coll::KahanSum<OutType>::result(sum);
     average /= static_cast<OutType>(taskData->inputs_count[0]);
     return true;
   }
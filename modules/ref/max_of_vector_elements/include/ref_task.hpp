@@ -5,11 +5,10 @@
 
 #include <gtest/gtest.h>
 
-#include <algorithm>
 #include <memory>
-#include <numeric>
 #include <vector>
 
+#include "core/coll/include/reduce_ops.hpp"
 #include "core/task/include/task.hpp"
 
 namespace ppc {
@@ -46,9 +45,14 @@ class MaxOfVectorElements : public ppc::core::Task {
 
   bool run() override {
     internal_order_test();
-    auto result = std::max_element(input_.begin(), input_.end());
-    max = static_cast<InOutType>(*result);
-    max_index = static_cast<IndexType>(std::distance(input_.begin(), result));
+    // first of equal maximums wins, as with std::max_element
+    ppc::coll::ArgMax<InOutType, IndexType> op;
+    auto result = op.identity();
+    for (size_t i = 0; i < input_.size(); i++) {
+      result = op(result, {input_[i], static_cast<IndexType>(i)});
+    }
+    max = result.value;
+    max_index = result.index;
     return true;
   }
 
@@ -5,11 +5,10 @@
 
 #include <gtest/gtest.h>
 
-#include <algorithm>
 #include <memory>
-#include <numeric>
 #include <vector>
 
+#include "core/coll/include/reduce_ops.hpp"
 #include "core/task/include/task.hpp"
 
 namespace ppc {
@@ -46,9 +45,14 @@ class MinOfVectorElements : public ppc::core::Task {
 
   bool run() override {
     internal_order_test();
-    auto result = std::min_element(input_.begin(), input_.end());
-    min = static_cast<InOutType>(*result);
-    min_index = static_cast<IndexType>(std::distance(input_.begin(), result));
+    // first of equal minimums wins, as with std::min_element
+    ppc::coll::ArgMin<InOutType, IndexType> op;
+    auto result = op.identity();
+    for (size_t i = 0; i < input_.size(); i++) {
+      result = op(result, {input_[i], static_cast<IndexType>(i)});
+    }
+    min = result.value;
+    min_index = result.index;
     return true;
   }
 
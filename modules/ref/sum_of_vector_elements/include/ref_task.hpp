@@ -5,9 +5,9 @@
 #include <gtest/gtest.h>
 
 #include <memory>
-#include <numeric>
 #include <vector>
 
+#include "core/coll/include/reduce_ops.hpp"
 #include "core/task/include/task.hpp"
 
 namespace ppc::reference {
@@ -37,7 +37,7 @@ class SumOfVectorElements : public ppc::core::Task {
 
   bool run() override {
     internal_order_test();
-    sum = std::accumulate(input_.begin(), input_.end(), 0);
+    sum = ppc::coll::fold(input_.data(), input_.size(), ppc::coll::Sum<InOutType>());
     return true;
   }
 
@@ -1,11 +1,13 @@
 import argparse
+import json
 import os
 import re
 import xlsxwriter
 import multiprocessing
 
 parser = argparse.ArgumentParser()
-parser.add_argument('-i', '--input', help='Input file path (logs of perf tests, .txt)', required=True)
+parser.add_argument('-i', '--input', required=True,
+                    help='Input file path (logs of perf tests, .txt, or records written via PPC_PERF_OUTPUT, .json)')
 parser.add_argument('-o', '--output', help='Output file path (path to .xlsx table)', required=True)
 args = parser.parse_args()
 logs_path = os.path.abspath(args.input)
@@ -16,29 +18,31 @@ list_of_type_of_tasks = ["mpi", "omp", "seq", "stl", "tbb"]
 result_tables = {"pipeline": {}, "task_run": {}}
 set_of_task_name = []
 
-logs_file = open(logs_path, "r")
-logs_lines = logs_file.readlines()
-for line in logs_lines:
-    pattern = r'tasks[\/|\\](\w*)[\/|\\](\w*):(\w*):(-*\d*\.\d*)'
-    result = re.findall(pattern, line)
-    if len(result):
-        task_name = result[0][1]
-        perf_type = result[0][2]
+
+def add_result(task_type, task_name, perf_type, perf_time):
+    if task_name not in set_of_task_name:
         set_of_task_name.append(task_name)
-        result_tables[perf_type][task_name] = {}
+        for table in result_tables.values():
+            table[task_name] = {ttype: -1.0 for ttype in list_of_type_of_tasks}
+    result_tables[perf_type][task_name][task_type] = perf_time
 
-        for ttype in list_of_type_of_tasks:
-            result_tables[perf_type][task_name][ttype] = -1.0
 
-for line in logs_lines:
-    pattern = r'tasks[\/|\\](\w*)[\/|\\](\w*):(\w*):(-*\d*\.\d*)'
-    result = re.findall(pattern, line)
-    if len(result):
-        task_type = result[0][0]
-        task_name = result[0][1]
-        perf_type = result[0][2]
-        perf_time = float(result[0][3])
-        result_tables[perf_type][task_name][task_type] = perf_time
+logs_file = open(logs_path, "r")
+logs_lines = logs_file.readlines()
+if logs_path.endswith(".json"):
+    for line in logs_lines:
+        if not line.strip():
+            continue
+        record = json.loads(line)
+        task_name = os.path.basename(record["task"])
+        if record["backend"] in list_of_type_of_tasks and record["type_of_running"] in result_tables:
+            add_result(record["backend"], task_name, record["type_of_running"], record["time_sec"])
+else:
+    for line in logs_lines:
+        pattern = r'tasks[\/|\\](\w*)[\/|\\](\w*):(\w*):(-*\d*\.\d*)'
+        result = re.findall(pattern, line)
+        if len(result) and result[0][2] in result_tables:
+            add_result(result[0][0], result[0][1], result[0][2], float(result[0][3]))
 
 
 for table_name in result_tables:
@@ -0,0 +1,51 @@
+import argparse
+import csv
+import json
+import os
+
+parser = argparse.ArgumentParser()
+parser.add_argument('-i', '--input', required=True, nargs='+',
+                    help='Input file paths (records written via PPC_PERF_OUTPUT, .json)')
+parser.add_argument('-o', '--output', help='Output file path (path to .csv table)', required=True)
+parser.add_argument('--weak', action='store_true', help='Input size grows with count of workers (weak scaling)')
+args = parser.parse_args()
+
+groups = {}
+for path in args.input:
+    with open(os.path.abspath(path), "r") as records_file:
+        for line in records_file:
+            if not line.strip():
+                continue
+            record = json.loads(line)
+            workers = record["num_processes"] if record["backend"] == "mpi" else record["num_threads"]
+            key = (os.path.basename(record["task"]), record["backend"], record["type_of_running"])
+            # points of one curve share input size (strong) or input size per worker (weak)
+            key += (record["input_size"] // workers if args.weak else record["input_size"],)
+            # the last record for the same point wins
+            groups.setdefault(key, {})[workers] = record
+
+
+def scaling_rows(points):
+    workers = sorted(points)
+    base = points[workers[0]]
+    rows = []
+    for p in workers:
+        time_sec = points[p]["median_sec"]
+        speedup = base["median_sec"] / time_sec * (p if args.weak else workers[0]) if time_sec > 0 else 0.0
+        efficiency = speedup / p
+        row = [p, points[p]["input_size"], time_sec, speedup, efficiency]
+        # Karp-Flatt serial fraction assumes fixed problem size, so it's given for strong scaling only
+        if not args.weak:
+            row.append((1.0 / speedup - 1.0 / p) / (1.0 - 1.0 / p) if p > 1 and speedup > 0 else 0.0)
+        rows.append(row)
+    return rows
+
+
+with open(os.path.abspath(args.output), "w", newline="") as table_file:
+    writer = csv.writer(table_file)
+    header = ["task", "backend", "type_of_running", "scaling", "workers", "input_size", "time_sec", "speedup",
+              "efficiency"]
+    writer.writerow(header if args.weak else header + ["serial_fraction"])
+    for key, points in sorted(groups.items()):
+        for row in scaling_rows(points):
+            writer.writerow(list(key[:3]) + ["weak" if args.weak else "strong"] + row)
@@ -1,4 +1,7 @@
 @echo off
-mkdir build\perf_stat_dir
-scripts\run_perf_collector.bat > build\perf_stat_dir\perf_log.txt
-python scripts\create_perf_table.py --input build\perf_stat_dir\perf_log.txt --output build\perf_stat_dir
+if not exist build\perf_stat_dir mkdir build\perf_stat_dir
+REM records are appended, so results of earlier runs are removed
+if exist build\perf_stat_dir\perf_results.json del build\perf_stat_dir\perf_results.json
+set PPC_PERF_OUTPUT=build\perf_stat_dir\perf_results.json
+call scripts\run_perf_collector.bat > build\perf_stat_dir\perf_log.txt 2>&1
+python scripts\create_perf_table.py --input build\perf_stat_dir\perf_results.json --output build\perf_stat_dir
@@ -1,3 +1,6 @@
-mkdir build/perf_stat_dir
+mkdir -p build/perf_stat_dir
+# records are appended, so results of earlier runs are removed
+rm -f build/perf_stat_dir/perf_results.json
+export PPC_PERF_OUTPUT=build/perf_stat_dir/perf_results.json
 source scripts/run_perf_collector.sh 2>&1 | tee build/perf_stat_dir/perf_log.txt
-python3 scripts/create_perf_table.py --input build/perf_stat_dir/perf_log.txt --output build/perf_stat_dir
+python3 scripts/create_perf_table.py --input build/perf_stat_dir/perf_results.json --output build/perf_stat_dir
@@ -0,0 +1,15 @@
+#!/bin/bash
+# all registered tasks of every backend in one process (one MPI session for mpi tasks),
+# output has the same format as run_perf_collector.sh
+if [[ -z "$ASAN_RUN" ]]; then
+  if [[ $OSTYPE == "linux-gnu" ]]; then
+    mpirun --oversubscribe -np 4 ./build/bin/mpi_bench "$@"
+  elif [[ $OSTYPE == "darwin"* ]]; then
+    mpirun -np 2 ./build/bin/mpi_bench "$@"
+  fi
+fi
+
+./build/bin/omp_bench "$@"
+./build/bin/seq_bench "$@"
+./build/bin/stl_bench "$@"
+./build/bin/tbb_bench "$@"
@@ -0,0 +1,31 @@
+#!/bin/bash
+# scaling sweep with bench drivers: every registered task for every count of processes / threads and input size
+#   strong scaling - the same sizes of PPC_SCALING_SIZES for every count of workers
+#   weak scaling (PPC_SCALING_WEAK=1) - PPC_SCALING_SIZES are sizes per worker, input grows with workers
+PPC_SCALING_WORKERS=${PPC_SCALING_WORKERS:-"1 2 4"}
+PPC_SCALING_SIZES=${PPC_SCALING_SIZES:-"100000 1000000"}
+mkdir -p build/perf_stat_dir
+rm -f build/perf_stat_dir/scaling_results.json
+export PPC_PERF_OUTPUT=build/perf_stat_dir/scaling_results.json
+
+for workers in $PPC_SCALING_WORKERS
+do
+  sizes=""
+  for size in $PPC_SCALING_SIZES
+  do
+    if [[ -n "$PPC_SCALING_WEAK" ]]; then
+      size=$((size * workers))
+    fi
+    sizes="${sizes:+$sizes,}$size"
+  done
+
+  if [[ -z "$ASAN_RUN" ]]; then
+    mpirun --oversubscribe -np "$workers" ./build/bin/mpi_bench --sizes="$sizes"
+  fi
+  PPC_NUM_THREADS=$workers OMP_NUM_THREADS=$workers ./build/bin/omp_bench --sizes="$sizes"
+  PPC_NUM_THREADS=$workers ./build/bin/stl_bench --sizes="$sizes"
+  PPC_NUM_THREADS=$workers ./build/bin/tbb_bench --sizes="$sizes"
+done
+
+python3 scripts/create_scaling_table.py --input build/perf_stat_dir/scaling_results.json \
+  --output build/perf_stat_dir/scaling_table.csv ${PPC_SCALING_WEAK:+--weak}
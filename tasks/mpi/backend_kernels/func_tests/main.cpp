@@ -0,0 +1,67 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <boost/mpi/collectives.hpp>
+#include <boost/mpi/communicator.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "core/backend/func_tests/backend_kernels_tests.hpp"
+#include "core/backend/func_tests/check_executor.hpp"
+#include "core/dataset/include/dataset_mpi.hpp"
+#include "core/gen/include/generators.hpp"
+#include "core/backend/include/backend_mpi.hpp"
+#include "core/hybrid/include/hybrid_mpi.hpp"
+
+INSTANTIATE_TYPED_TEST_SUITE_P(mpi_backend_kernels, BackendKernelsTest, ppc::core::MpiExecutor<>);
+
+TEST(mpi_backend_kernels, check_parallel_for_visits_index_once) {
+  boost::mpi::communicator world;
+  ppc::core::MpiExecutor<> exec(world);
+  // every index is visited by exactly one rank
+  std::vector<int> touched(1000, 0);
+  exec.parallel_for(0, touched.size(), [&](size_t i) { touched[i]++; });
+  std::vector<int> visits(touched.size());
+  boost::mpi::all_reduce(world, touched.data(), static_cast<int>(touched.size()), visits.data(), std::plus<>());
+  EXPECT_TRUE(std::all_of(visits.begin(), visits.end(), [](int count) { return count == 1; }));
+}
+
+TEST(mpi_backend_kernels, check_hybrid_executor) {
+  boost::mpi::communicator world;
+  ppc::core::HybridContext hybrid(world);
+  // communicators of nodes partition world
+  int leader_size = hybrid.node().rank() == 0 ? hybrid.node().size() : 0;
+  int total_size = 0;
+  boost::mpi::all_reduce(world, leader_size, total_size, std::plus<>());
+  EXPECT_EQ(total_size, world.size());
+  EXPECT_EQ(hybrid.layout().node_rank, hybrid.node().rank());
+
+  hybrid.apply();
+  EXPECT_EQ(ppc::core::current_placement().cpus, hybrid.layout().placement.cpus);
+  auto exec = hybrid.executor();
+  EXPECT_EQ(exec.concurrency(), world.size() * hybrid.layout().threads);
+  ppc::test::check_primitives(exec, true);
+  ppc::test::check_kernels(exec);
+}
+
+TEST(mpi_backend_kernels, check_rank_rows_of_dataset) {
+  boost::mpi::communicator world;
+  auto dir = std::filesystem::temp_directory_path() / "ppc_mpi_backend_kernels_datasets";
+  ppc::core::DatasetCache cache(dir.string());
+  auto fill = [](std::span<int32_t> out) { ppc::core::fill_uniform(out, 0, 1000, 5); };
+  auto generator = ppc::core::generator_key("uniform_matrix", 0, 1000);
+  auto rows = ppc::core::map_rank_rows<int32_t>(world, cache, generator, 5, {25, 8}, fill);
+
+  // every rank maps its block of rows, which is the same as generated slice
+  auto [lo, hi] = ppc::core::block_range(0, 25, world.size(), world.rank());
+  auto expected = ppc::core::random_vector<int32_t>((hi - lo) * 8, 0, 1000, 5, lo * 8);
+  auto values = rows.as<int32_t>();
+  EXPECT_EQ(std::vector<int32_t>(values.begin(), values.end()), expected);
+  world.barrier();
+  if (world.rank() == 0) std::filesystem::remove_all(dir);
+}
@@ -0,0 +1,41 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <boost/mpi/communicator.hpp>
+#include <cstdint>
+#include <memory>
+
+#include "core/backend/func_tests/backend_kernels_perf_tests.hpp"
+#include "core/backend/include/backend_mpi.hpp"
+#include "core/dataset/include/dataset_mpi.hpp"
+#include "core/perf/include/perf.hpp"
+#include "core/perf/include/perf_mpi.hpp"
+
+namespace {
+
+// Inputs are mapped by every rank, leaders of nodes create them once; time is reduced over ranks
+void run_mpi_dot_perf(bool task_run) {
+  boost::mpi::communicator world;
+  ppc::core::DatasetCache cache;
+  auto open = [&](uint64_t seed) {
+    return ppc::core::MappedDataset::open(ppc::core::ensure_on_nodes<int64_t>(
+        world, cache, ppc::test::dot_perf_generator(), seed, {ppc::test::DOT_PERF_COUNT},
+        ppc::test::dot_perf_fill(seed)));
+  };
+  auto a = open(1);
+  auto b = open(2);
+
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 10;
+  ppc::core::set_mpi_timing(world, *perfAttr);
+  ppc::test::run_dot_perf<ppc::core::MpiExecutor<>>(a, b, perfAttr, task_run, world.rank() == 0);
+}
+
+}  // namespace
+
+// shared suite times runs by clock of process, which isn't reduced over ranks
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(BackendKernelsPerfTest);
+
+TEST(mpi_backend_kernels_perf_test, test_pipeline_run) { run_mpi_dot_perf(false); }
+
+TEST(mpi_backend_kernels_perf_test, test_task_run) { run_mpi_dot_perf(true); }
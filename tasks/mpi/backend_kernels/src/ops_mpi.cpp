@@ -0,0 +1,10 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/backend/include/backend_mpi.hpp"
+#include "core/backend/include/kernel_tasks.hpp"
+
+namespace {
+
+// mpi/backend_dot and mpi/backend_column_max for bench
+const ppc::core::KernelTasksRegistrar<ppc::core::MpiExecutor<>> registrar;
+
+}  // namespace
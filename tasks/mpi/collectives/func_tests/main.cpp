@@ -0,0 +1,320 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <boost/mpi/communicator.hpp>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include "core/coll/include/coll_mpi.hpp"
+#include "core/coll/include/hier_mpi.hpp"
+#include "core/coll/include/icoll_mpi.hpp"
+
+using ppc::coll::Algorithm;
+
+namespace {
+
+struct Sample {
+  int32_t id;
+  double value;
+  bool operator==(const Sample &other) const { return id == other.id && value == other.value; }
+};
+
+// Concatenation of digits keeps order of ranks only if algorithm does
+struct Concat {
+  using value_type = int64_t;
+  static constexpr bool commutative = false;
+  static constexpr bool associative = true;
+  static constexpr int64_t identity() { return 0; }
+  int64_t operator()(int64_t a, int64_t b) const {
+    int64_t shift = 10;
+    while (shift <= b) shift *= 10;
+    return a * shift + b;
+  }
+};
+
+std::vector<int64_t> rank_values(int rank, size_t count) {
+  std::vector<int64_t> values(count);
+  for (size_t i = 0; i < count; i++) values[i] = rank * 1000 + static_cast<int64_t>(i % 97);
+  return values;
+}
+
+std::vector<int64_t> expected_sum(int size, size_t count) {
+  std::vector<int64_t> sum(count, 0);
+  for (int rank = 0; rank < size; rank++) {
+    auto values = rank_values(rank, count);
+    for (size_t i = 0; i < count; i++) sum[i] += values[i];
+  }
+  return sum;
+}
+
+}  // namespace
+
+TEST(mpi_collectives, check_all_reduce_algorithms) {
+  boost::mpi::communicator world;
+  for (auto algorithm : {Algorithm::AUTO, Algorithm::BINOMIAL, Algorithm::RECURSIVE_DOUBLING, Algorithm::RABENSEIFNER,
+                         Algorithm::RING}) {
+    for (size_t count : {1, 7, 1000, 20000}) {
+      auto in = rank_values(world.rank(), count);
+      std::vector<int64_t> out(count);
+      ppc::coll::all_reduce(world, in.data(), static_cast<int>(count), out.data(), std::plus<>(), algorithm);
+      EXPECT_EQ(out, expected_sum(world.size(), count)) << ppc::coll::algorithm_name(algorithm) << " " << count;
+      // in place
+      ppc::coll::all_reduce(world, in.data(), static_cast<int>(count), in.data(), std::plus<>(), algorithm);
+      EXPECT_EQ(in, out);
+    }
+  }
+}
+
+TEST(mpi_collectives, check_reduce_algorithms) {
+  boost::mpi::communicator world;
+  for (auto algorithm : {Algorithm::AUTO, Algorithm::LINEAR, Algorithm::BINOMIAL, Algorithm::RABENSEIFNER}) {
+    for (int root = 0; root < world.size(); root++) {
+      for (size_t count : {1, 5, 1003}) {
+        auto in = rank_values(world.rank(), count);
+        std::vector<int64_t> out(world.rank() == root ? count : 0);
+        ppc::coll::reduce(world, in.data(), static_cast<int>(count), out.data(), std::plus<>(), root, algorithm);
+        if (world.rank() == root) {
+          EXPECT_EQ(out, expected_sum(world.size(), count)) << ppc::coll::algorithm_name(algorithm) << " " << root;
+        }
+      }
+    }
+  }
+}
+
+TEST(mpi_collectives, check_ordered_algorithms_keep_rank_order) {
+  boost::mpi::communicator world;
+  // concatenation of digits isn't commutative
+  auto concat = [](int64_t a, int64_t b) {
+    int64_t shift = 10;
+    while (shift <= b) shift *= 10;
+    return a * shift + b;
+  };
+  int64_t expected = 0;
+  for (int rank = 0; rank < world.size(); rank++) expected = concat(expected, rank + 1);
+
+  int64_t in = world.rank() + 1;
+  int64_t out = 0;
+  ppc::coll::reduce(world, &in, 1, &out, concat, world.size() - 1, Algorithm::LINEAR);
+  if (world.rank() == world.size() - 1) {
+    EXPECT_EQ(out, expected);
+  }
+  ppc::coll::all_reduce(world, &in, 1, &out, concat, Algorithm::RECURSIVE_DOUBLING);
+  EXPECT_EQ(out, expected);
+}
+
+TEST(mpi_collectives, check_broadcast_algorithms) {
+  boost::mpi::communicator world;
+  // many segments of pipelined algorithms, including shorter last one
+  auto &limits = ppc::coll::thresholds();
+  const auto saved = limits;
+  limits.bcast_segment_bytes = 1000;
+  for (auto algorithm : {Algorithm::AUTO, Algorithm::BINOMIAL, Algorithm::SCATTER_ALLGATHER,
+                         Algorithm::PIPELINED_CHAIN, Algorithm::PIPELINED_BINARY}) {
+    for (int root = 0; root < world.size(); root++) {
+      for (size_t count : {1, 3, 10007}) {
+        std::vector<Sample> expected(count);
+        for (size_t i = 0; i < count; i++) expected[i] = {static_cast<int32_t>(i) + root, 0.5 * static_cast<double>(i)};
+        std::vector<Sample> values = world.rank() == root ? expected : std::vector<Sample>(count, Sample{-1, 0.0});
+        ppc::coll::broadcast(world, values.data(), static_cast<int>(count), root, algorithm);
+        EXPECT_EQ(values, expected) << ppc::coll::algorithm_name(algorithm) << " " << root << " " << count;
+      }
+    }
+  }
+  limits = saved;
+}
+
+TEST(mpi_collectives, check_scatter_and_gather_algorithms) {
+  boost::mpi::communicator world;
+  const int count = 3;
+  for (auto algorithm : {Algorithm::AUTO, Algorithm::BINOMIAL, Algorithm::LINEAR}) {
+    for (int root = 0; root < world.size(); root++) {
+      std::vector<int32_t> all(world.rank() == root ? count * world.size() : 0);
+      std::iota(all.begin(), all.end(), 100 * root);
+      std::vector<int32_t> part(count);
+      ppc::coll::scatter(world, all.data(), part.data(), count, root, algorithm);
+      for (int i = 0; i < count; i++) EXPECT_EQ(part[i], 100 * root + world.rank() * count + i);
+
+      for (auto &value : part) value = -value;
+      std::vector<int32_t> gathered(all.size());
+      ppc::coll::gather(world, part.data(), count, gathered.data(), root, algorithm);
+      if (world.rank() == root) {
+        for (size_t i = 0; i < all.size(); i++) EXPECT_EQ(gathered[i], -all[i]) << ppc::coll::algorithm_name(algorithm);
+      }
+    }
+  }
+}
+
+TEST(mpi_collectives, check_vector_variants) {
+  boost::mpi::communicator world;
+  const int root = world.size() / 2;
+  std::vector<int> sizes(world.size());
+  std::vector<int> displs(world.size());
+  for (int rank = 0; rank < world.size(); rank++) {
+    sizes[rank] = rank + 1;
+    displs[rank] = rank * (rank + 1) / 2;
+  }
+  const int total = displs.back() + sizes.back();
+  std::vector<double> all(world.rank() == root ? total : 0);
+  std::iota(all.begin(), all.end(), 0.0);
+  std::vector<double> part(world.rank() + 1);
+  ppc::coll::scatterv(world, all.data(), sizes, displs, part.data(), world.rank() + 1, root);
+  for (int i = 0; i <= world.rank(); i++) EXPECT_EQ(part[i], displs[world.rank()] + i);
+
+  std::vector<double> gathered(all.size());
+  ppc::coll::gatherv(world, part.data(), world.rank() + 1, gathered.data(), sizes, displs, root);
+  if (world.rank() == root) {
+    EXPECT_EQ(gathered, all);
+  }
+}
+
+TEST(mpi_collectives, check_all_gather_algorithms) {
+  boost::mpi::communicator world;
+  for (auto algorithm : {Algorithm::AUTO, Algorithm::RING, Algorithm::RECURSIVE_DOUBLING}) {
+    for (int count : {1, 33}) {
+      std::vector<int32_t> in(count);
+      std::iota(in.begin(), in.end(), world.rank() * count);
+      std::vector<int32_t> out(count * world.size());
+      ppc::coll::all_gather(world, in.data(), count, out.data(), algorithm);
+      std::vector<int32_t> expected(out.size());
+      std::iota(expected.begin(), expected.end(), 0);
+      EXPECT_EQ(out, expected) << ppc::coll::algorithm_name(algorithm);
+    }
+  }
+}
+
+TEST(mpi_collectives, check_unavailable_algorithm) {
+  boost::mpi::communicator world;
+  if (world.size() == 1) GTEST_SKIP();
+  int64_t value = 1;
+  EXPECT_THROW(ppc::coll::all_reduce(world, &value, 1, &value, std::plus<>(), Algorithm::SCATTER_ALLGATHER),
+               std::invalid_argument);
+  EXPECT_THROW(ppc::coll::broadcast(world, &value, 1, 0, Algorithm::RING), std::invalid_argument);
+}
+
+TEST(mpi_collectives, check_nonblocking_reductions) {
+  boost::mpi::communicator world;
+  for (size_t count : {1, 7, 20000}) {
+    auto in = rank_values(world.rank(), count);
+    std::vector<int64_t> all(count);
+    std::vector<int64_t> root_out(world.rank() == 0 ? count : 0);
+    auto all_request = ppc::coll::iall_reduce(world, in.data(), static_cast<int>(count), all.data(), std::plus<>());
+    auto reduce_request =
+        ppc::coll::ireduce(world, in.data(), static_cast<int>(count), root_out.data(), std::plus<>(), 0);
+    while (!all_request.test()) {
+    }
+    reduce_request.wait();
+    EXPECT_FALSE(all_request.active());
+    EXPECT_EQ(all, expected_sum(world.size(), count)) << count;
+    if (world.rank() == 0) {
+      EXPECT_EQ(root_out, expected_sum(world.size(), count)) << count;
+    }
+  }
+  auto future = ppc::coll::iall_reduce(world, Sample{world.rank(), 1.0}, [](const Sample &a, const Sample &b) {
+    return Sample{std::max(a.id, b.id), a.value + b.value};
+  });
+  EXPECT_EQ(future.get(), (Sample{world.size() - 1, static_cast<double>(world.size())}));
+}
+
+TEST(mpi_collectives, check_convergence_check_lags_one_iteration) {
+  using SumCheck = ppc::coll::ConvergenceCheck<int, std::plus<>>;
+  boost::mpi::communicator world;
+  SumCheck check(world, 3);
+  std::vector<int> checked;
+  for (int iteration = 0; iteration < 8; iteration++) {
+    auto sum = check.update(iteration);
+    if (sum) checked.push_back(*sum);
+  }
+  // sums of iterations 0, 3 and 6 come at iterations 1, 4 and 7
+  EXPECT_EQ(checked, (std::vector<int>{0, 3 * world.size(), 6 * world.size()}));
+  EXPECT_THROW(SumCheck(world, 0), std::invalid_argument);
+}
+
+TEST(mpi_collectives, check_typed_reduction_ops) {
+  boost::mpi::communicator world;
+  using Value = ppc::coll::IndexedValue<double>;
+  for (auto algorithm : {Algorithm::AUTO, Algorithm::BINOMIAL, Algorithm::RECURSIVE_DOUBLING, Algorithm::RABENSEIFNER,
+                         Algorithm::RING}) {
+    // minimum of i-th element is on rank i % size, equal minimums of all ranks at the end go to rank 0
+    std::vector<Value> in(1000);
+    for (size_t i = 0; i < in.size(); i++) {
+      bool owner = i % world.size() == static_cast<size_t>(world.rank());
+      in[i] = {i >= 990 ? -1.0 : (owner ? 0.0 : 1.0 + world.rank()), world.rank()};
+    }
+    std::vector<Value> out(in.size());
+    ppc::coll::all_reduce(world, in.data(), static_cast<int>(in.size()), out.data(), ppc::coll::ArgMin<double>(),
+                          algorithm);
+    for (size_t i = 0; i < out.size(); i++) {
+      ASSERT_EQ(out[i].index, i >= 990 ? 0 : static_cast<int>(i % world.size())) << i;
+    }
+  }
+  auto local = ppc::coll::KahanSum<double>()(ppc::coll::KahanSum<double>::identity(), world.rank() == 0 ? 1.0 : 1e-16);
+  ppc::coll::CompensatedValue<double> total{};
+  ppc::coll::all_reduce(world, &local, 1, &total, ppc::coll::KahanSum<double>());
+  EXPECT_DOUBLE_EQ(ppc::coll::KahanSum<double>::result(total), 1.0 + 1e-16 * (world.size() - 1));
+}
+
+TEST(mpi_collectives, check_traits_choose_ordered_algorithms) {
+  boost::mpi::communicator world;
+  int64_t expected = 0;
+  for (int rank = 0; rank < world.size(); rank++) expected = Concat()(expected, rank + 1);
+
+  // large message would take Rabenseifner or ring if op were commutative
+  std::vector<int64_t> in(100000, world.rank() + 1);
+  std::vector<int64_t> out(in.size());
+  ppc::coll::all_reduce(world, in.data(), static_cast<int>(in.size()), out.data(), Concat());
+  EXPECT_EQ(out, std::vector<int64_t>(in.size(), expected));
+  ppc::coll::reduce(world, in.data(), static_cast<int>(in.size()), out.data(), Concat(), 0);
+  if (world.rank() == 0) {
+    EXPECT_EQ(out, std::vector<int64_t>(in.size(), expected));
+  }
+  auto sum = ppc::coll::iall_reduce(world, world.rank() + 1, Concat());
+  EXPECT_EQ(sum.get(), expected);
+  EXPECT_THROW(ppc::coll::all_reduce(world, in.data(), 1, out.data(), Concat(), Algorithm::RING),
+               std::invalid_argument);
+}
+
+TEST(mpi_collectives, check_node_hierarchy_collectives) {
+  boost::mpi::communicator world;
+  // real nodes, and simulated nodes of interleaved and of contiguous ranks on one machine
+  for (int split = 0; split < 3; split++) {
+    int color = split == 0 ? 0 : (split == 1 ? world.rank() % 2 : world.rank() / 3);
+    auto node = split == 0 ? ppc::core::node_communicator(world) : world.split(color, world.rank());
+    ppc::coll::NodeHierarchy hierarchy(world, node);
+    EXPECT_EQ(static_cast<bool>(hierarchy.leaders()), hierarchy.is_leader());
+    for (size_t count : {1, 7, 20000}) {
+      auto in = rank_values(world.rank(), count);
+      std::vector<int64_t> out(count);
+      hierarchy.all_reduce(in.data(), static_cast<int>(count), out.data(), ppc::coll::Sum<int64_t>());
+      EXPECT_EQ(out, expected_sum(world.size(), count)) << split << " " << count;
+
+      for (int root = 0; root < world.size(); root++) {
+        std::vector<int64_t> reduced(count);
+        hierarchy.reduce(in.data(), static_cast<int>(count), reduced.data(), ppc::coll::Sum<int64_t>(), root);
+        std::vector<int64_t> values = world.rank() == root ? rank_values(root, count) : std::vector<int64_t>(count);
+        hierarchy.broadcast(values.data(), static_cast<int>(count), root);
+        std::vector<int64_t> gathered(world.rank() == root ? count * world.size() : 0);
+        hierarchy.gather(in.data(), static_cast<int>(count), gathered.data(), root);
+        EXPECT_EQ(values, rank_values(root, count)) << split << " " << root;
+        if (world.rank() == root) {
+          EXPECT_EQ(reduced, expected_sum(world.size(), count)) << split << " " << root;
+          for (int rank = 0; rank < world.size(); rank++) {
+            auto expected = rank_values(rank, count);
+            ASSERT_TRUE(std::equal(expected.begin(), expected.end(), gathered.begin() + rank * count))
+                << split << " " << root << " " << rank;
+          }
+        }
+      }
+    }
+    // op which isn't commutative falls back to flat algorithm keeping order of ranks
+    int64_t in = world.rank() + 1;
+    int64_t out = 0;
+    hierarchy.all_reduce(&in, 1, &out, Concat());
+    int64_t expected = 0;
+    for (int rank = 0; rank < world.size(); rank++) expected = Concat()(expected, rank + 1);
+    EXPECT_EQ(out, expected);
+  }
+}
@@ -0,0 +1,54 @@
+// Copyright 2024 Nesterov Alexander
+#pragma once
+
+#include <boost/mpi/communicator.hpp>
+#include <memory>
+#include <optional>
+#include <span>
+#include <utility>
+
+#include "core/coll/include/coll.hpp"
+#include "core/coll/include/hier_mpi.hpp"
+#include "core/task/include/task.hpp"
+
+namespace collectives_mpi {
+
+// Broadcast of input of root to outputs of all processes by ppc::coll algorithm,
+// empty algorithm is boost::mpi::broadcast as baseline
+class BroadcastTaskMPI : public ppc::core::Task {
+ public:
+  explicit BroadcastTaskMPI(std::shared_ptr<ppc::core::TaskData> taskData_,
+                            std::optional<ppc::coll::Algorithm> algorithm_ = ppc::coll::Algorithm::AUTO)
+      : Task(std::move(taskData_)), algorithm(algorithm_) {}
+  bool pre_processing() override;
+  bool validation() override;
+  bool run() override;
+  bool post_processing() override;
+
+ private:
+  std::optional<ppc::coll::Algorithm> algorithm;
+  std::span<double> values;
+  boost::mpi::communicator world;
+};
+
+// Sum of inputs of all processes in outputs of all processes, by flat ppc::coll::all_reduce or by two-level
+// all_reduce of ppc::coll::NodeHierarchy
+class AllReduceTaskMPI : public ppc::core::Task {
+ public:
+  explicit AllReduceTaskMPI(std::shared_ptr<ppc::core::TaskData> taskData_, bool hierarchical_)
+      : Task(std::move(taskData_)), hierarchical(hierarchical_) {}
+  bool pre_processing() override;
+  bool validation() override;
+  bool run() override;
+  bool post_processing() override;
+
+ private:
+  bool hierarchical;
+  std::span<const double> input;
+  std::span<double> values;
+  boost::mpi::communicator world;
+  // created on first pre_processing, its shared window is reused by later runs
+  std::unique_ptr<ppc::coll::NodeHierarchy> hierarchy;
+};
+
+}  // namespace collectives_mpi
@@ -0,0 +1,104 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <boost/mpi/communicator.hpp>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "core/coll/include/coll.hpp"
+#include "core/perf/include/perf.hpp"
+#include "core/perf/include/perf_mpi.hpp"
+#include "mpi/collectives/include/ops_mpi.hpp"
+
+namespace {
+
+// Times broadcast of 16 MiB, results are reported as tasks/mpi/collectives/<name>
+void run_broadcast(const std::string &name, std::optional<ppc::coll::Algorithm> algorithm) {
+  boost::mpi::communicator world;
+  const size_t count = 1 << 21;
+  std::vector<double> in(world.rank() == 0 ? count : 0);
+  for (size_t i = 0; i < in.size(); i++) in[i] = 0.5 * static_cast<double>(i);
+  std::vector<double> out(count);
+
+  // Create TaskData
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  auto task = std::make_shared<collectives_mpi::BroadcastTaskMPI>(taskData, algorithm);
+
+  // Create Perf attributes
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 10;
+  ppc::core::set_mpi_timing(world, *perfAttr);
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  auto perfAnalyzer = std::make_shared<ppc::core::Perf>(task);
+  perfAnalyzer->task_run(perfAttr, perfResults);
+  if (world.rank() == 0) {
+    ppc::core::Perf::print_perf_statistic("tasks/mpi/collectives/" + name, perfResults);
+    EXPECT_LT(perfResults->time_sec, ppc::core::PerfResults::MAX_TIME);
+  }
+  EXPECT_EQ(out[count - 1], 0.5 * static_cast<double>(count - 1));
+}
+
+// Times all_reduce of 8 MiB of every process, results are reported as tasks/mpi/collectives/<name>
+void run_all_reduce(const std::string &name, bool hierarchical) {
+  boost::mpi::communicator world;
+  const size_t count = 1 << 20;
+  std::vector<double> in(count, 1.0);
+  std::vector<double> out(count);
+
+  // Create TaskData
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  auto task = std::make_shared<collectives_mpi::AllReduceTaskMPI>(taskData, hierarchical);
+
+  // Create Perf attributes
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 10;
+  ppc::core::set_mpi_timing(world, *perfAttr);
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  auto perfAnalyzer = std::make_shared<ppc::core::Perf>(task);
+  perfAnalyzer->task_run(perfAttr, perfResults);
+  if (world.rank() == 0) {
+    ppc::core::Perf::print_perf_statistic("tasks/mpi/collectives/" + name, perfResults);
+    EXPECT_LT(perfResults->time_sec, ppc::core::PerfResults::MAX_TIME);
+  }
+  EXPECT_EQ(out[count - 1], static_cast<double>(world.size()));
+}
+
+}  // namespace
+
+TEST(mpi_collectives_perf_test, test_boost_broadcast) { run_broadcast("broadcast_boost", std::nullopt); }
+
+TEST(mpi_collectives_perf_test, test_pipelined_chain_broadcast) {
+  run_broadcast("broadcast_chain", ppc::coll::Algorithm::PIPELINED_CHAIN);
+}
+
+TEST(mpi_collectives_perf_test, test_pipelined_binary_broadcast) {
+  run_broadcast("broadcast_binary", ppc::coll::Algorithm::PIPELINED_BINARY);
+}
+
+TEST(mpi_collectives_perf_test, test_auto_broadcast) { run_broadcast("broadcast_auto", ppc::coll::Algorithm::AUTO); }
+
+TEST(mpi_collectives_perf_test, test_flat_all_reduce) { run_all_reduce("all_reduce_flat", false); }
+
+TEST(mpi_collectives_perf_test, test_hierarchical_all_reduce) { run_all_reduce("all_reduce_hier", true); }
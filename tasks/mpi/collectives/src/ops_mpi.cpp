@@ -0,0 +1,126 @@
+// Copyright 2024 Nesterov Alexander
+#include "mpi/collectives/include/ops_mpi.hpp"
+
+#include <algorithm>
+#include <boost/mpi/collectives.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/coll/include/coll_mpi.hpp"
+#include "core/registry/include/registry.hpp"
+
+bool collectives_mpi::BroadcastTaskMPI::validation() {
+  internal_order_test();
+  if (taskData->outputs.empty() || taskData->outputs_count[0] == 0) return false;
+  return world.rank() != 0 || (!taskData->inputs.empty() && taskData->inputs_count[0] == taskData->outputs_count[0]);
+}
+
+bool collectives_mpi::BroadcastTaskMPI::pre_processing() {
+  internal_order_test();
+  values = taskData->output_view<double>(0);
+  if (world.rank() == 0) {
+    auto input = taskData->input_view<double>(0);
+    std::copy(input.begin(), input.end(), values.begin());
+  }
+  return true;
+}
+
+bool collectives_mpi::BroadcastTaskMPI::run() {
+  internal_order_test();
+  if (algorithm) {
+    ppc::coll::broadcast(world, values.data(), static_cast<int>(values.size()), 0, *algorithm);
+  } else {
+    boost::mpi::broadcast(world, values.data(), static_cast<int>(values.size()), 0);
+  }
+  return true;
+}
+
+bool collectives_mpi::BroadcastTaskMPI::post_processing() {
+  internal_order_test();
+  return true;
+}
+
+bool collectives_mpi::AllReduceTaskMPI::validation() {
+  internal_order_test();
+  return !taskData->inputs.empty() && !taskData->outputs.empty() &&
+         taskData->inputs_count[0] == taskData->outputs_count[0];
+}
+
+bool collectives_mpi::AllReduceTaskMPI::pre_processing() {
+  internal_order_test();
+  input = taskData->input_view<double>(0);
+  values = taskData->output_view<double>(0);
+  if (hierarchical && !hierarchy) hierarchy = std::make_unique<ppc::coll::NodeHierarchy>(world);
+  return true;
+}
+
+bool collectives_mpi::AllReduceTaskMPI::run() {
+  internal_order_test();
+  const auto n = static_cast<int>(input.size());
+  if (hierarchical) {
+    hierarchy->all_reduce(input.data(), n, values.data(), ppc::coll::Sum<double>());
+  } else {
+    ppc::coll::all_reduce(world, input.data(), n, values.data(), ppc::coll::Sum<double>());
+  }
+  return true;
+}
+
+bool collectives_mpi::AllReduceTaskMPI::post_processing() {
+  internal_order_test();
+  return true;
+}
+
+namespace {
+
+// Every process gets output of size values, root gets input too
+ppc::core::BenchInput make_input(uint64_t size) {
+  boost::mpi::communicator world;
+  std::vector<double> in(world.rank() == 0 ? size : 0);
+  for (size_t i = 0; i < in.size(); i++) in[i] = 0.5 * static_cast<double>(i);
+  return ppc::core::make_bench_input(std::move(in), std::vector<double>(size), [](const std::vector<double> &out) {
+    for (size_t i = 0; i < out.size(); i++) {
+      if (out[i] != 0.5 * static_cast<double>(i)) return false;
+    }
+    return true;
+  });
+}
+
+ppc::core::TaskEntry broadcast_entry(const std::string &name, std::optional<ppc::coll::Algorithm> algorithm) {
+  auto factory = [algorithm](std::shared_ptr<ppc::core::TaskData> taskData) -> std::shared_ptr<ppc::core::Task> {
+    return std::make_shared<collectives_mpi::BroadcastTaskMPI>(std::move(taskData), algorithm);
+  };
+  return {"mpi/" + name, factory, make_input, {1 << 16, 1 << 21}};
+}
+
+// mpi/broadcast_* compare broadcasts of 512 KiB and 16 MiB in bench
+const ppc::core::TaskRegistrar boost_registrar(broadcast_entry("broadcast_boost", std::nullopt));
+const ppc::core::TaskRegistrar auto_registrar(broadcast_entry("broadcast_auto", ppc::coll::Algorithm::AUTO));
+const ppc::core::TaskRegistrar chain_registrar(broadcast_entry("broadcast_chain",
+                                                               ppc::coll::Algorithm::PIPELINED_CHAIN));
+const ppc::core::TaskRegistrar binary_registrar(broadcast_entry("broadcast_binary",
+                                                                ppc::coll::Algorithm::PIPELINED_BINARY));
+
+// Every process gives size ones and gets sums equal to count of processes
+ppc::core::BenchInput make_all_reduce_input(uint64_t size) {
+  boost::mpi::communicator world;
+  const auto expected = static_cast<double>(world.size());
+  return ppc::core::make_bench_input(std::vector<double>(size, 1.0), std::vector<double>(size),
+                                     [expected](const std::vector<double> &out) {
+                                       return std::all_of(out.begin(), out.end(),
+                                                          [expected](double value) { return value == expected; });
+                                     });
+}
+
+ppc::core::TaskEntry all_reduce_entry(const std::string &name, bool hierarchical) {
+  auto factory = [hierarchical](std::shared_ptr<ppc::core::TaskData> taskData) -> std::shared_ptr<ppc::core::Task> {
+    return std::make_shared<collectives_mpi::AllReduceTaskMPI>(std::move(taskData), hierarchical);
+  };
+  return {"mpi/" + name, factory, make_all_reduce_input, {1 << 10, 1 << 20}};
+}
+
+// mpi/all_reduce_* compare flat and node-aware all_reduce of 8 KiB and 8 MiB in bench
+const ppc::core::TaskRegistrar flat_registrar(all_reduce_entry("all_reduce_flat", false));
+const ppc::core::TaskRegistrar hier_registrar(all_reduce_entry("all_reduce_hier", true));
+
+}  // namespace
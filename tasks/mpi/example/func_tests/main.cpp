@@ -4,8 +4,12 @@
 #include <boost/mpi/communicator.hpp>
 #include <boost/mpi/environment.hpp>
 #include <memory>
+#include <numeric>
+#include <stdexcept>
 #include <vector>
 
+#include "core/batch/include/batch_mpi.hpp"
+#include "core/hybrid/include/hybrid_mpi.hpp"
 #include "mpi/example/include/ops_mpi.hpp"
 
 TEST(Parallel_Operations_MPI, Test_Sum) {
@@ -17,7 +21,7 @@ TEST(Parallel_Operations_MPI, Test_Sum) {
 
   if (world.rank() == 0) {
     const int count_size_vector = 120;
-    global_vec = nesterov_a_test_task_mpi::getRandomVector(count_size_vector);
+    global_vec = nesterov_a_test_task_mpi::getRandomVector(count_size_vector, 1);
     taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(global_vec.data()));
     taskDataPar->inputs_count.emplace_back(global_vec.size());
     taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t*>(global_sum.data()));
@@ -61,7 +65,7 @@ TEST(Parallel_Operations_MPI, Test_Diff) {
 
   if (world.rank() == 0) {
     const int count_size_vector = 240;
-    global_vec = nesterov_a_test_task_mpi::getRandomVector(count_size_vector);
+    global_vec = nesterov_a_test_task_mpi::getRandomVector(count_size_vector, 2);
     taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(global_vec.data()));
     taskDataPar->inputs_count.emplace_back(global_vec.size());
     taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t*>(global_diff.data()));
@@ -105,7 +109,7 @@ TEST(Parallel_Operations_MPI, Test_Diff_2) {
 
   if (world.rank() == 0) {
     const int count_size_vector = 120;
-    global_vec = nesterov_a_test_task_mpi::getRandomVector(count_size_vector);
+    global_vec = nesterov_a_test_task_mpi::getRandomVector(count_size_vector, 3);
     taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(global_vec.data()));
     taskDataPar->inputs_count.emplace_back(global_vec.size());
     taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t*>(global_diff.data()));
@@ -149,7 +153,7 @@ TEST(Parallel_Operations_MPI, Test_Max) {
 
   if (world.rank() == 0) {
     const int count_size_vector = 240;
-    global_vec = nesterov_a_test_task_mpi::getRandomVector(count_size_vector);
+    global_vec = nesterov_a_test_task_mpi::getRandomVector(count_size_vector, 4);
     taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(global_vec.data()));
     taskDataPar->inputs_count.emplace_back(global_vec.size());
     taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t*>(global_max.data()));
@@ -193,7 +197,7 @@ TEST(Parallel_Operations_MPI, Test_Max_2) {
 
   if (world.rank() == 0) {
     const int count_size_vector = 120;
-    global_vec = nesterov_a_test_task_mpi::getRandomVector(count_size_vector);
+    global_vec = nesterov_a_test_task_mpi::getRandomVector(count_size_vector, 5);
     taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(global_vec.data()));
     taskDataPar->inputs_count.emplace_back(global_vec.size());
     taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t*>(global_max.data()));
@@ -228,8 +232,97 @@ TEST(Parallel_Operations_MPI, Test_Max_2) {
   }
 }
 
+TEST(Parallel_Operations_MPI, Test_Batch_Sum) {
+  boost::mpi::communicator world;
+  const int count_instances = 37;
+  std::vector<std::vector<int>> global_vecs(count_instances);
+  std::vector<std::vector<int32_t>> global_sums(count_instances, std::vector<int32_t>(1, 0));
+  // Create TaskData for every small instance
+  std::vector<std::shared_ptr<ppc::core::TaskData>> batch;
+  if (world.rank() == 0) {
+    for (int i = 0; i < count_instances; i++) {
+      global_vecs[i] = nesterov_a_test_task_mpi::getRandomVector(i + 1, i);
+      auto taskData = std::make_shared<ppc::core::TaskData>();
+      taskData->inputs.emplace_back(reinterpret_cast<uint8_t*>(global_vecs[i].data()));
+      taskData->inputs_count.emplace_back(global_vecs[i].size());
+      taskData->outputs.emplace_back(reinterpret_cast<uint8_t*>(global_sums[i].data()));
+      taskData->outputs_count.emplace_back(global_sums[i].size());
+      batch.push_back(taskData);
+    }
+  }
+
+  // Whole instances are distributed over processes and solved sequentially
+  ppc::core::BatchRunner runner([](std::shared_ptr<ppc::core::TaskData> taskData) {
+    return std::make_shared<nesterov_a_test_task_mpi::TestMPITaskSequential>(taskData, "+");
+  });
+  auto results = ppc::core::run_batch_mpi(world, runner, batch, {{sizeof(int)}, {sizeof(int32_t)}});
+
+  if (world.rank() == 0) {
+    ASSERT_EQ(results.size(), static_cast<size_t>(count_instances));
+    for (int i = 0; i < count_instances; i++) {
+      EXPECT_TRUE(results[i]);
+      ASSERT_EQ(std::accumulate(global_vecs[i].begin(), global_vecs[i].end(), 0), global_sums[i][0]);
+    }
+  }
+}
+
+TEST(Parallel_Operations_MPI, Test_Batch_Rejects_Wrong_Instance_On_All_Ranks) {
+  boost::mpi::communicator world;
+  std::vector<int> global_vec(10, 1);
+  std::vector<std::shared_ptr<ppc::core::TaskData>> batch;
+  if (world.rank() == 0) {
+    // instance without output doesn't match layout
+    auto taskData = std::make_shared<ppc::core::TaskData>();
+    taskData->inputs.emplace_back(reinterpret_cast<uint8_t*>(global_vec.data()));
+    taskData->inputs_count.emplace_back(global_vec.size());
+    batch.push_back(taskData);
+  }
+
+  ppc::core::BatchRunner runner([](std::shared_ptr<ppc::core::TaskData> taskData) {
+    return std::make_shared<nesterov_a_test_task_mpi::TestMPITaskSequential>(taskData, "+");
+  });
+  EXPECT_THROW(ppc::core::run_batch_mpi(world, runner, batch, {{sizeof(int)}, {sizeof(int32_t)}}),
+               std::invalid_argument);
+  // layout has to be the same on all ranks
+  ppc::core::BatchLayout layout{{sizeof(int)}, {world.rank() == 0 ? sizeof(int32_t) : sizeof(int64_t)}};
+  if (world.size() > 1) {
+    EXPECT_THROW(ppc::core::run_batch_mpi(world, runner, {}, layout), std::invalid_argument);
+  }
+  world.barrier();
+}
+
+TEST(Parallel_Operations_MPI, Test_Batch_Runner_Failure_Throws_On_All_Ranks) {
+  boost::mpi::communicator world;
+  const int count_instances = 8;
+  std::vector<std::vector<int>> global_vecs(count_instances);
+  std::vector<std::vector<int32_t>> global_sums(count_instances, std::vector<int32_t>(1, 0));
+  std::vector<std::shared_ptr<ppc::core::TaskData>> batch;
+  if (world.rank() == 0) {
+    for (int i = 0; i < count_instances; i++) {
+      // first instance is empty, its input buffer is null
+      global_vecs[i] = std::vector<int>(i, 1);
+      auto taskData = std::make_shared<ppc::core::TaskData>();
+      taskData->inputs.emplace_back(reinterpret_cast<uint8_t*>(global_vecs[i].data()));
+      taskData->inputs_count.emplace_back(global_vecs[i].size());
+      taskData->outputs.emplace_back(reinterpret_cast<uint8_t*>(global_sums[i].data()));
+      taskData->outputs_count.emplace_back(global_sums[i].size());
+      batch.push_back(taskData);
+    }
+  }
+
+  // only last rank fails, the others must not wait for its outputs
+  const bool fail = world.rank() == world.size() - 1;
+  ppc::core::BatchRunner runner([fail](std::shared_ptr<ppc::core::TaskData> taskData) {
+    if (fail) throw std::runtime_error("task can't be created");
+    return std::make_shared<nesterov_a_test_task_mpi::TestMPITaskSequential>(taskData, "+");
+  });
+  EXPECT_THROW(ppc::core::run_batch_mpi(world, runner, batch, {{sizeof(int)}, {sizeof(int32_t)}}),
+               std::runtime_error);
+  world.barrier();
+}
+
 int main(int argc, char** argv) {
-  boost::mpi::environment env(argc, argv);
+  boost::mpi::environment env(argc, argv, ppc::core::HYBRID_THREADING);
   boost::mpi::communicator world;
   ::testing::InitGoogleTest(&argc, argv);
   auto& listeners = ::testing::UnitTest::GetInstance()->listeners();
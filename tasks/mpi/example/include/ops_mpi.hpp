@@ -5,8 +5,10 @@
 
 #include <boost/mpi/collectives.hpp>
 #include <boost/mpi/communicator.hpp>
+#include <cstdint>
 #include <memory>
 #include <numeric>
+#include <span>
 #include <string>
 #include <utility>
 #include <vector>
@@ -15,7 +17,8 @@
 
 namespace nesterov_a_test_task_mpi {
 
-std::vector<int> getRandomVector(int sz);
+// Reproducible random vector, same seed gives same vector
+std::vector<int> getRandomVector(int sz, uint64_t seed);
 
 class TestMPITaskSequential : public ppc::core::Task {
  public:
@@ -27,7 +30,7 @@ class TestMPITaskSequential : public ppc::core::Task {
   bool post_processing() override;
 
  private:
-  std::vector<int> input_;
+  std::span<const int> input_;
   int res{};
   std::string ops;
 };
@@ -42,7 +45,8 @@ class TestMPITaskParallel : public ppc::core::Task {
   bool post_processing() override;
 
  private:
-  std::vector<int> input_, local_input_;
+  std::span<const int> input_, local_input_;
+  std::vector<int> local_buffer_;
   int res{};
   std::string ops;
   boost::mpi::communicator world;
@@ -1,10 +1,12 @@
 // Copyright 2023 Nesterov Alexander
 #include <gtest/gtest.h>
 
-#include <boost/mpi/timer.hpp>
 #include <vector>
 
+#include "core/hybrid/include/hybrid_mpi.hpp"
 #include "core/perf/include/perf.hpp"
+#include "core/perf/include/perf_mpi.hpp"
+#include "core/trace/include/trace_mpi.hpp"
 #include "mpi/example/include/ops_mpi.hpp"
 
 TEST(mpi_example_perf_test, test_pipeline_run) {
@@ -32,8 +34,7 @@ TEST(mpi_example_perf_test, test_pipeline_run) {
   // Create Perf attributes
   auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
   perfAttr->num_running = 10;
-  const boost::mpi::timer current_timer;
-  perfAttr->current_timer = [&] { return current_timer.elapsed(); };
+  ppc::core::set_mpi_timing(world, *perfAttr);
 
   // Create and init perf results
   auto perfResults = std::make_shared<ppc::core::PerfResults>();
@@ -72,8 +73,7 @@ TEST(mpi_example_perf_test, test_task_run) {
   // Create Perf attributes
   auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
   perfAttr->num_running = 10;
-  const boost::mpi::timer current_timer;
-  perfAttr->current_timer = [&] { return current_timer.elapsed(); };
+  ppc::core::set_mpi_timing(world, *perfAttr);
 
   // Create and init perf results
   auto perfResults = std::make_shared<ppc::core::PerfResults>();
@@ -88,7 +88,7 @@ TEST(mpi_example_perf_test, test_task_run) {
 }
 
 int main(int argc, char** argv) {
-  boost::mpi::environment env(argc, argv);
+  boost::mpi::environment env(argc, argv, ppc::core::HYBRID_THREADING);
   boost::mpi::communicator world;
   ::testing::InitGoogleTest(&argc, argv);
   auto& listeners = ::testing::UnitTest::GetInstance()->listeners();
@@ -134,5 +134,7 @@ int main(int argc, char** argv) {
     boost::mpi::communicator world;
   };
   listeners.Append(new BufferGarbageDetector);
-  return RUN_ALL_TESTS();
+  auto result = RUN_ALL_TESTS();
+  ppc::core::write_trace(world);
+  return result;
 }
@@ -3,31 +3,24 @@
 
 #include <algorithm>
 #include <functional>
-#include <random>
 #include <string>
 #include <thread>
+#include <utility>
 #include <vector>
 
+#include "core/gen/include/generators.hpp"
+#include "core/registry/include/registry.hpp"
+
 using namespace std::chrono_literals;
 
-std::vector<int> nesterov_a_test_task_mpi::getRandomVector(int sz) {
-  std::random_device dev;
-  std::mt19937 gen(dev());
-  std::vector<int> vec(sz);
-  for (int i = 0; i < sz; i++) {
-    vec[i] = gen() % 100;
-  }
-  return vec;
+std::vector<int> nesterov_a_test_task_mpi::getRandomVector(int sz, uint64_t seed) {
+  return ppc::core::random_vector<int>(sz, 0, 99, seed);
 }
 
 bool nesterov_a_test_task_mpi::TestMPITaskSequential::pre_processing() {
   internal_order_test();
-  // Init vectors
-  input_ = std::vector<int>(taskData->inputs_count[0]);
-  auto* tmp_ptr = reinterpret_cast<int*>(taskData->inputs[0]);
-  for (unsigned i = 0; i < taskData->inputs_count[0]; i++) {
-    input_[i] = tmp_ptr[i];
-  }
+  // Init view of input without copying
+  input_ = taskData->input_view<int>(0);
   // Init value for output
   res = 0;
   return true;
@@ -66,21 +59,16 @@ bool nesterov_a_test_task_mpi::TestMPITaskParallel::pre_processing() {
   broadcast(world, delta, 0);
 
   if (world.rank() == 0) {
-    // Init vectors
-    input_ = std::vector<int>(taskData->inputs_count[0]);
-    auto* tmp_ptr = reinterpret_cast<int*>(taskData->inputs[0]);
-    for (unsigned i = 0; i < taskData->inputs_count[0]; i++) {
-      input_[i] = tmp_ptr[i];
-    }
+    // Init view of input without copying, root works on its part in place
+    input_ = taskData->input_view<int>(0);
     for (int proc = 1; proc < world.size(); proc++) {
       world.send(proc, 0, input_.data() + proc * delta, delta);
     }
-  }
-  local_input_ = std::vector<int>(delta);
-  if (world.rank() == 0) {
-    local_input_ = std::vector<int>(input_.begin(), input_.begin() + delta);
+    local_input_ = input_.first(delta);
   } else {
-    world.recv(0, 0, local_input_.data(), delta);
+    local_buffer_.resize(delta);
+    world.recv(0, 0, local_buffer_.data(), delta);
+    local_input_ = local_buffer_;
   }
   // Init value for output
   res = 0;
@@ -122,3 +110,25 @@ bool nesterov_a_test_task_mpi::TestMPITaskParallel::post_processing() {
   }
   return true;
 }
+
+namespace {
+
+std::shared_ptr<ppc::core::Task> make_task(std::shared_ptr<ppc::core::TaskData> taskData) {
+  return std::make_shared<nesterov_a_test_task_mpi::TestMPITaskParallel>(std::move(taskData), "+");
+}
+
+// Input is given on root only, other processes get empty task data
+ppc::core::BenchInput make_input(uint64_t size) {
+  boost::mpi::communicator world;
+  if (world.rank() != 0) {
+    return {std::make_shared<ppc::core::TaskData>(), nullptr, nullptr};
+  }
+  // example drops remainder of input which is not divisible by count of processes
+  auto expected = static_cast<int>(size - size % world.size());
+  return ppc::core::make_bench_input(std::vector<int>(size, 1), std::vector<int>(1, 0),
+                                     [expected](const std::vector<int>& out) { return out[0] == expected; });
+}
+
+const ppc::core::TaskRegistrar registrar({"mpi/example", make_task, make_input, {100000, 1000000}});
+
+}  // namespace
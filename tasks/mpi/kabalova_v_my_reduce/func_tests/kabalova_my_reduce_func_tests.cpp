@@ -62,7 +62,7 @@ int lxor(std::vector<int>& vec) {
 }
 
 int band(std::vector<int>& vec) {
-  int result = 1;
+  int result = ~0;
   for (size_t i = 0; i < vec.size(); i++) {
     result = result & vec[i];
   }
@@ -12,19 +12,11 @@
 #include <string>
 #include <utility>
 
+#include "core/coll/include/reduce_ops.hpp"
 #include "core/task/include/task.hpp"
 
 namespace kabalova_v_my_reduce {
 bool checkValidOperation(const std::string& ops);
-void myReduce(const boost::mpi::communicator& comm, const int& inValue, int& outValue, const std::string& ops,
-              int root);
-void reduceImplementation(const boost::mpi::communicator& comm, const int& inValue, int& outValue,
-                          const std::string& ops, int root);
-void reduceImplementation(const boost::mpi::communicator& comm, const int& inValue, const std::string& ops, int root);
-void reduceTree(const boost::mpi::communicator& comm, const int& inValue, int& outValue, const std::string& ops,
-                int root);
-void reduceTree(const boost::mpi::communicator& comm, const int& inValue, const std::string& ops, int root);
-int op(const int& a, const int& b, const std::string& ops);
 
 class Tree {
  private:
@@ -45,6 +37,49 @@ class Tree {
   int begin() const;
 };
 
+// Commutative reduction with tree-based algorithm, op is typed operator of core/coll/include/reduce_ops.hpp,
+// outValue is result on the root
+template <typename T, typename Op>
+void reduceTree(const boost::mpi::communicator& comm, const T& inValue, T& outValue, Op op, int root) {
+  outValue = inValue;
+  int size = comm.size();
+  int rank = comm.rank();
+
+  kabalova_v_my_reduce::Tree tree(rank, size, root);
+
+  MPI_Status status;
+  int children = 0;
+  // begin() - returns the index for the first child of this process
+  // We have binary tree so we go until 2
+  // Child = (child + 1) % size - recalculate the next child of this process
+  for (int child = tree.begin(); children < 2 && child != root; children++, child = (child + 1) % size) {
+    // Receive archive
+    boost::mpi::packed_iarchive iarchive(comm);
+    boost::mpi::detail::packed_archive_recv(comm, child, 0, iarchive, status);
+    T incoming;
+    iarchive >> incoming;
+    outValue = op(outValue, incoming);
+  }
+  // For non-roots, send the result to the parent.
+  if (tree.parent() != rank) {
+    boost::mpi::packed_oarchive oarchive(comm);
+    oarchive << outValue;
+    boost::mpi::detail::packed_archive_send(comm, tree.parent(), 0, oarchive);
+  }
+}
+
+// Main function of reduce. Supports reducing at the root and for the root
+template <typename T, typename Op>
+void myReduce(const boost::mpi::communicator& comm, const T& inValue, T& outValue, Op op, int root) {
+  static_assert(ppc::coll::reduction_traits<Op>::commutative, "Tree reduction needs commutative op");
+  if (comm.rank() == root) {
+    reduceTree(comm, inValue, outValue, op, root);
+  } else {
+    T result{};
+    reduceTree(comm, inValue, result, op, root);
+  }
+}
+
 class TestMPITaskParallel : public ppc::core::Task {
  public:
   explicit TestMPITaskParallel(std::shared_ptr<ppc::core::TaskData> taskData_, std::string ops_)
@@ -55,6 +90,10 @@ class TestMPITaskParallel : public ppc::core::Task {
   bool post_processing() override;
 
  private:
+  // Reduces local parts with op, string of operation is dispatched to it once in run
+  template <typename Op>
+  void reduceWith(Op op);
+
   std::vector<int> input_, local_input_;
   int result{};
   boost::mpi::communicator world;
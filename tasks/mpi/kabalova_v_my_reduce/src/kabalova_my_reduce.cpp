@@ -70,89 +70,10 @@ bool kabalova_v_my_reduce::checkValidOperation(const std::string& ops) {
   return false;
 }
 
-int kabalova_v_my_reduce::op(const int& a, const int& b, const std::string& ops) {
-  int tmp = 0;
-  if (ops == "+") {
-    tmp = a + b;
-  } else if (ops == "*") {
-    tmp = a * b;
-  } else if (ops == "min") {
-    tmp = std::min(a, b);
-  } else if (ops == "max") {
-    tmp = std::max(a, b);
-  } else if (ops == "&&") {
-    tmp = static_cast<int>(static_cast<bool>(a) && static_cast<bool>(b));
-  } else if (ops == "||") {
-    tmp = static_cast<int>(static_cast<bool>(a) || static_cast<bool>(b));
-  } else if (ops == "&") {
-    tmp = a & b;
-  } else if (ops == "|") {
-    tmp = a | b;
-  } else if (ops == "^") {
-    tmp = a ^ b;
-  } else if (ops == "lxor") {
-    bool res1 = !static_cast<bool>(a);
-    bool res2 = !static_cast<bool>(b);
-    tmp = static_cast<int>(res1 != res2);
-  }
-  return tmp;
-}
-
-// Main function of reduce. Supports reducing at the root and for the root
-void kabalova_v_my_reduce::myReduce(const boost::mpi::communicator& comm, const int& value, int& outValue,
-                                    const std::string& ops, int root) {
-  if (comm.rank() == root)
-    kabalova_v_my_reduce::reduceImplementation(comm, value, outValue, ops, root);
-  else
-    kabalova_v_my_reduce::reduceImplementation(comm, value, ops, root);
-}
-
-// Reducing at the root with tree-based algorithm
-void kabalova_v_my_reduce::reduceImplementation(const boost::mpi::communicator& comm, const int& inValue, int& outValue,
-                                                const std::string& ops, int root) {
-  kabalova_v_my_reduce::reduceTree(comm, inValue, outValue, ops, root);
-}
-
-// Reducing to the root with tree-based algorithm
-void kabalova_v_my_reduce::reduceImplementation(const boost::mpi::communicator& comm, const int& inValue,
-                                                const std::string& ops, int root) {
-  kabalova_v_my_reduce::reduceTree(comm, inValue, ops, root);
-}
-
-// Commutative reduction
-void kabalova_v_my_reduce::reduceTree(const boost::mpi::communicator& comm, const int& inValue, int& outValue,
-                                      const std::string& ops, int root) {
-  outValue = inValue;
-  int size = comm.size();
-  int rank = comm.rank();
-
-  kabalova_v_my_reduce::Tree tree(rank, size, root);
-
-  MPI_Status status;
-  int children = 0;
-  // begin() - returns the index for the first child of this process
-  // We have binary tree so we go until 2
-  // Child = (child + 1) % size - recalculate the next child of this process
-  for (int child = tree.begin(); children < 2 && child != root; children++, child = (child + 1) % size) {
-    // Receive archive
-    boost::mpi::packed_iarchive iarchive(comm);
-    boost::mpi::detail::packed_archive_recv(comm, child, 0, iarchive, status);
-    int incoming;
-    iarchive >> incoming;
-    outValue = op(outValue, incoming, ops);
-  }
-  // For non-roots, send the result to the parent.
-  if (tree.parent() != rank) {
-    boost::mpi::packed_oarchive oarchive(comm);
-    oarchive << outValue;
-    boost::mpi::detail::packed_archive_send(comm, tree.parent(), 0, oarchive);
-  }
-}
-// Commutative reduction from a non-root.
-void kabalova_v_my_reduce::reduceTree(const boost::mpi::communicator& comm, const int& inValue, const std::string& ops,
-                                      int root) {
-  int result = 0;
-  kabalova_v_my_reduce::reduceTree(comm, inValue, result, ops, root);
+template <typename Op>
+void kabalova_v_my_reduce::TestMPITaskParallel::reduceWith(Op op) {
+  int local_res = ppc::coll::fold(local_input_.data(), local_input_.size(), op);
+  myReduce(world, local_res, result, op, 0);
 }
 
 bool kabalova_v_my_reduce::TestMPITaskParallel::pre_processing() {
@@ -215,60 +136,26 @@ bool kabalova_v_my_reduce::TestMPITaskParallel::run() {
   }
 
   // After this we can finally use reduce
-  int local_res;
   if (ops == "+") {  // MPI_SUM
-    local_res = std::accumulate(local_input_.begin(), local_input_.end(), 0);
-    myReduce(world, local_res, result, "+", 0);
+    reduceWith(ppc::coll::Sum<int>());
   } else if (ops == "*") {  // MPI_PROD
-    local_res = 1;
-    for (size_t i = 0; i < local_input_.size(); i++) {
-      local_res *= local_input_[i];
-    }
-    myReduce(world, local_res, result, "*", 0);
+    reduceWith(ppc::coll::Prod<int>());
   } else if (ops == "max") {  // MPI_MAX
-    local_res = *std::max_element(local_input_.begin(), local_input_.end());
-    myReduce(world, local_res, result, "max", 0);
+    reduceWith(ppc::coll::Max<int>());
   } else if (ops == "min") {  // MPI_MIN
-    local_res = *std::min_element(local_input_.begin(), local_input_.end());
-    myReduce(world, local_res, result, "min", 0);
+    reduceWith(ppc::coll::Min<int>());
   } else if (ops == "&&") {  // MPI_LAND
-    local_res = 1;
-    for (size_t i = 0; i < local_input_.size(); i++) {
-      local_res = static_cast<int>(static_cast<bool>(local_res) && static_cast<bool>(local_input_[i]));
-    }
-    myReduce(world, local_res, result, "&&", 0);
+    reduceWith(ppc::coll::LogicalAnd<int>());
   } else if (ops == "||") {  // MPI_LOR
-    local_res = 0;
-    for (size_t i = 0; i < local_input_.size(); i++) {
-      local_res = static_cast<int>(static_cast<bool>(local_res) || static_cast<bool>(local_input_[i]));
-    }
-    myReduce(world, local_res, result, "||", 0);
+    reduceWith(ppc::coll::LogicalOr<int>());
   } else if (ops == "&") {  // MPI_BAND
-    local_res = 1;
-    for (size_t i = 0; i < local_input_.size(); i++) {
-      local_res = local_res & local_input_[i];
-    }
-    myReduce(world, local_res, result, "&", 0);
+    reduceWith(ppc::coll::BitAnd<int>());
   } else if (ops == "|") {  // MPI_BOR
-    local_res = 0;
-    for (size_t i = 0; i < local_input_.size(); i++) {
-      local_res = local_res | local_input_[i];
-    }
-    myReduce(world, local_res, result, "|", 0);
+    reduceWith(ppc::coll::BitOr<int>());
   } else if (ops == "^") {  // MPI_BXOR
-    local_res = 0;
-    for (size_t i = 0; i < local_input_.size(); i++) {
-      local_res = local_res ^ local_input_[i];
-    }
-    myReduce(world, local_res, result, "^", 0);
+    reduceWith(ppc::coll::BitXor<int>());
   } else if (ops == "lxor") {  // MPI_LXOR
-    local_res = 0;
-    for (size_t i = 0; i < local_input_.size(); i++) {
-      bool res1 = !static_cast<bool>(local_res);
-      bool res2 = !static_cast<bool>(local_input_[i]);
-      local_res = static_cast<int>(res1 != res2);
-    }
-    myReduce(world, local_res, result, "lxor", 0);
+    reduceWith(ppc::coll::LogicalXor<int>());
   }
   return true;
 }
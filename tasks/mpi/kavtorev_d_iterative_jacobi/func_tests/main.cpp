@@ -48,7 +48,7 @@ void generateTestData(size_t n, std::vector<double>& A_flat, std::vector<double>
   }
 }
 
-void run_test(int n, double eps = 0.001, int iterations = 1000) {
+void run_test(int n, double eps = 0.001, int iterations = 1000, int check_every = 1) {
   boost::mpi::communicator world;
 
   std::vector<double> A;
@@ -80,7 +80,8 @@ void run_test(int n, double eps = 0.001, int iterations = 1000) {
     taskDataPar->outputs_count.emplace_back(mpi_X.size());
   }
 
-  auto taskParallel = std::make_shared<kavtorev_d_iterative_jacobi_mpi::IterativeJacobiParallelMPI>(taskDataPar);
+  auto taskParallel =
+      std::make_shared<kavtorev_d_iterative_jacobi_mpi::IterativeJacobiParallelMPI>(taskDataPar, check_every);
   if (taskParallel->validation()) {
     taskParallel->pre_processing();
     bool mpi_run_res = taskParallel->run();
@@ -233,6 +234,10 @@ TEST(kavtorev_d_iterative_jacobi_mpi, fifty_random_matrix) { kavtorev_d_iterativ
 
 TEST(kavtorev_d_iterative_jacobi_mpi, hundred_random_matrix) { kavtorev_d_iterative_jacobi_mpi::run_test(100); }
 
+TEST(kavtorev_d_iterative_jacobi_mpi, hundred_random_matrix_checked_every_fourth_iteration) {
+  kavtorev_d_iterative_jacobi_mpi::run_test(100, 0.001, 1000, 4);
+}
+
 TEST(kavtorev_d_iterative_jacobi_mpi, null_task_data) {
   kavtorev_d_iterative_jacobi_mpi::run_val(0, 0.0, 0, {}, {}, {});
 }
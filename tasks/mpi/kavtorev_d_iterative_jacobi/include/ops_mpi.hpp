@@ -8,6 +8,8 @@
 #include <utility>
 #include <vector>
 
+#include "core/coll/include/icoll_mpi.hpp"
+#include "core/hybrid/include/hybrid_mpi.hpp"
 #include "core/task/include/task.hpp"
 
 namespace kavtorev_d_iterative_jacobi_mpi {
@@ -17,7 +19,9 @@ bool jacobi_method(int N, const std::vector<double>& A_flat, const std::vector<d
 
 class IterativeJacobiParallelMPI : public ppc::core::Task {
  public:
-  explicit IterativeJacobiParallelMPI(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(std::move(taskData_)) {}
+  // norm of every check_every-th iteration is reduced while next iteration is computed
+  explicit IterativeJacobiParallelMPI(std::shared_ptr<ppc::core::TaskData> taskData_, int check_every_ = 1)
+      : Task(std::move(taskData_)), check_every(check_every_) {}
   bool pre_processing() override;
   bool validation() override;
   bool run() override;
@@ -41,6 +45,7 @@ class IterativeJacobiParallelMPI : public ppc::core::Task {
 
   int local_size;
   int local_displ;
+  int check_every;
 
   std::vector<int> sendcounts_A;
   std::vector<int> displs_A;
@@ -48,6 +53,9 @@ class IterativeJacobiParallelMPI : public ppc::core::Task {
   std::vector<int> displs_F;
 
   boost::mpi::communicator world;
+  // local rows are processed by thread pool of rank in hybrid MPI + threads mode, context is created by first
+  // pre_processing as its construction is collective
+  std::unique_ptr<ppc::core::HybridContext> hybrid;
 };
 
 class IterativeJacobiSequentialMPI : public ppc::core::Task {
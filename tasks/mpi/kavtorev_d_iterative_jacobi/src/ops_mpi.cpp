@@ -1,5 +1,6 @@
 #include "mpi/kavtorev_d_iterative_jacobi/include/ops_mpi.hpp"
 
+#include <algorithm>
 #include <boost/serialization/array.hpp>
 #include <boost/serialization/vector.hpp>
 #include <cassert>
@@ -99,6 +100,11 @@ bool kavtorev_d_iterative_jacobi_mpi::IterativeJacobiParallelMPI::pre_processing
   num_proc = world.size();
   rank = world.rank();
 
+  if (!hybrid) {
+    hybrid = std::make_unique<ppc::core::HybridContext>(world);
+    hybrid->apply();
+  }
+
   if (rank == 0) {
     auto* A_data = reinterpret_cast<double*>(taskData->inputs[3]);
     int A_size = taskData->inputs_count[3];
@@ -155,52 +161,50 @@ bool kavtorev_d_iterative_jacobi_mpi::IterativeJacobiParallelMPI::run() {
 
   boost::mpi::broadcast(world, X, 0);
 
-  std::vector<std::vector<double>> local_A(local_size, std::vector<double>(n));
-  for (int i = 0; i < local_size; ++i) {
-    for (int j = 0; j < n; ++j) {
-      local_A[i][j] = local_A_flat[i * n + j];
-    }
-  }
-
-  std::vector<double> TempX(n);
-  double norm;
+  // Working buffers are owned by the task, so repeated runs don't reallocate them
+  auto TempX = arena.get<double>("TempX", n);
+  auto local_TempX = arena.get<double>("local_TempX", local_size);
+  ppc::coll::ConvergenceCheck<double, boost::mpi::maximum<double>> convergence(world, check_every);
+  bool converged = false;
+  const auto& threads = hybrid->local_executor();
+  const auto rows = static_cast<size_t>(local_size);
 
   int iteration = 0;
   do {
-    std::vector<double> local_TempX(local_size);
-    for (int i = 0; i < local_size; ++i) {
-      int global_i = local_displ + i;
+    threads.parallel_for(0, rows, [&](size_t i) {
+      int global_i = local_displ + static_cast<int>(i);
+      const double* local_A_row = local_A_flat.data() + i * n;
       double sum = local_F[i];
       for (int g = 0; g < n; ++g) {
-        if (global_i != g) sum -= local_A[i][g] * X[g];
+        if (global_i != g) sum -= local_A_row[g] * X[g];
       }
-      local_TempX[i] = sum / local_A[i][global_i];
-    }
+      local_TempX[i] = sum / local_A_row[global_i];
+    });
 
     if (rank == 0) {
-      boost::mpi::gatherv(world, local_TempX.data(), local_TempX.size(), TempX.data(), sizes, displs, 0);
+      boost::mpi::gatherv(world, local_TempX.data(), local_size, TempX.data(), sizes, displs, 0);
     } else {
-      boost::mpi::gatherv(world, local_TempX.data(), local_TempX.size(), 0);
+      boost::mpi::gatherv(world, local_TempX.data(), local_size, 0);
     }
 
-    boost::mpi::broadcast(world, TempX, 0);
+    boost::mpi::broadcast(world, TempX.data(), n, 0);
 
-    double local_norm = 0.0;
-    for (int i = 0; i < local_size; ++i) {
-      int global_i = local_displ + i;
-      double diff = fabs(X[global_i] - TempX[global_i]);
-      if (diff > local_norm) local_norm = diff;
-    }
+    double local_norm = threads.parallel_reduce(
+        0, rows, 0.0, [&](size_t i) { return fabs(X[local_displ + i] - TempX[local_displ + i]); },
+        [](double a, double b) { return std::max(a, b); });
 
-    boost::mpi::all_reduce(world, local_norm, norm, boost::mpi::maximum<double>());
+    // norm of earlier iteration is checked, its all_reduce overlapped with computation of this one
+    const auto norm = convergence.update(local_norm);
+    converged = norm.has_value() && *norm <= eps;
 
-    X = TempX;
+    std::copy(TempX.begin(), TempX.end(), X.begin());
 
     iteration++;
 
-  } while (iteration < iterations && norm > eps);
+  } while (iteration < iterations && !converged);
 
-  return iteration != iterations;
+  // convergence on the last allowed iteration is success too
+  return converged;
 }
 
 bool kavtorev_d_iterative_jacobi_mpi::IterativeJacobiParallelMPI::post_processing() {
@@ -238,7 +242,7 @@ bool kavtorev_d_iterative_jacobi_mpi::jacobi_method(int N, const std::vector<dou
     }
     iteration++;
   } while (iteration < iterations && norm > eps);
-  return iteration != iterations;
+  return norm <= eps;
 }
 
 bool kavtorev_d_iterative_jacobi_mpi::IterativeJacobiSequentialMPI::validation() {
@@ -55,7 +55,7 @@ std::pair<std::vector<double>, std::vector<double>> generate_diagonally_dominant
 }
 }  // namespace korablev_v_jacobi_method_mpi
 
-void run_jacobi_test_for_matrix_size(size_t matrix_size) {
+void run_jacobi_test_for_matrix_size(size_t matrix_size, int check_every = 1) {
   boost::mpi::communicator world;
 
   auto [A_flat, b] = korablev_v_jacobi_method_mpi::generate_diagonally_dominant_matrix(matrix_size);
@@ -77,7 +77,7 @@ void run_jacobi_test_for_matrix_size(size_t matrix_size) {
     taskDataPar->outputs_count.emplace_back(x_parallel.size());
   }
 
-  korablev_v_jacobi_method_mpi::JacobiMethodParallel jacobi_parallel(taskDataPar);
+  korablev_v_jacobi_method_mpi::JacobiMethodParallel jacobi_parallel(taskDataPar, check_every);
   ASSERT_TRUE(jacobi_parallel.validation());
   jacobi_parallel.pre_processing();
   jacobi_parallel.run();
@@ -119,6 +119,9 @@ TEST(korablev_v_jacobi_method_mpi, test_matrix_16x16) { run_jacobi_test_for_matr
 TEST(korablev_v_jacobi_method_mpi, test_matrix_32x32) { run_jacobi_test_for_matrix_size(32); }
 TEST(korablev_v_jacobi_method_mpi, test_matrix_100x100) { run_jacobi_test_for_matrix_size(100); }
 TEST(korablev_v_jacobi_method_mpi, test_matrix_1000x1000) { run_jacobi_test_for_matrix_size(512); }
+TEST(korablev_v_jacobi_method_mpi, test_matrix_100x100_checked_every_fourth_iteration) {
+  run_jacobi_test_for_matrix_size(100, 4);
+}
 
 TEST(korablev_v_jacobi_method_mpi, invalid_input_count) {
   boost::mpi::communicator world;
@@ -34,7 +34,9 @@ class JacobiMethodSequential : public ppc::core::Task {
 
 class JacobiMethodParallel : public ppc::core::Task {
  public:
-  explicit JacobiMethodParallel(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(std::move(taskData_)) {}
+  // residual of every check_every-th iteration is reduced while next iteration is computed
+  explicit JacobiMethodParallel(std::shared_ptr<ppc::core::TaskData> taskData_, int check_every_ = 1)
+      : Task(std::move(taskData_)), check_every(check_every_) {}
   bool pre_processing() override;
   bool validation() override;
   bool run() override;
@@ -57,7 +59,7 @@ class JacobiMethodParallel : public ppc::core::Task {
 
   size_t maxIterations_ = 2000;
   double epsilon_ = 1e-5;
-  bool isNeedToComplete(const std::vector<double>& x_old, const std::vector<double>& x_new) const;
+  int check_every;
 
   boost::mpi::communicator world;
   static void calculate_distribution_a(int rows, int num_proc, std::vector<int>& sizes, std::vector<int>& displs);
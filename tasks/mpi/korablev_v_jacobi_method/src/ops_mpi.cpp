@@ -9,6 +9,23 @@
 #include <vector>
 
 #include "boost/mpi/collectives/broadcast.hpp"
+#include "core/coll/include/icoll_mpi.hpp"
+
+namespace {
+
+// Sums of squares of change of x and of new x over rows of rank
+struct Residual {
+  double sum_up;
+  double sum_low;
+};
+
+struct ResidualSum {
+  Residual operator()(const Residual& a, const Residual& b) const {
+    return {a.sum_up + b.sum_up, a.sum_low + b.sum_low};
+  }
+};
+
+}  // namespace
 
 bool korablev_v_jacobi_method_mpi::JacobiMethodParallel::isNonSingular(const std::vector<double>& A, size_t n) {
   std::vector<double> matrix = A;
@@ -139,17 +156,6 @@ bool korablev_v_jacobi_method_mpi::JacobiMethodSequential::post_processing() {
   return true;
 }
 
-bool korablev_v_jacobi_method_mpi::JacobiMethodParallel::isNeedToComplete(const std::vector<double>& x_old,
-                                                                          const std::vector<double>& x_new) const {
-  double sum_up = 0;
-  double sum_low = 0;
-  for (size_t k = 0; k < x_old.size(); k++) {
-    sum_up += (x_new[k] - x_old[k]) * (x_new[k] - x_old[k]);
-    sum_low += x_new[k] * x_new[k];
-  }
-  return (sqrt(sum_up / sum_low) < epsilon_);
-}
-
 bool korablev_v_jacobi_method_mpi::JacobiMethodParallel::pre_processing() {
   internal_order_test();
   sizes_a.resize(world.size());
@@ -244,6 +250,7 @@ bool korablev_v_jacobi_method_mpi::JacobiMethodParallel::run() {
     boost::mpi::scatterv(world, local_b.data(), loc_vec_size, 0);
   }
 
+  ppc::coll::ConvergenceCheck<Residual, ResidualSum> convergence(world, check_every);
   for (size_t numberOfIter = 0; numberOfIter < maxIterations_; numberOfIter++) {
     if (world.rank() == 0) {
       std::copy(x_.begin(), x_.end(), x_prev.begin());
@@ -265,13 +272,16 @@ bool korablev_v_jacobi_method_mpi::JacobiMethodParallel::run() {
     } else {
       boost::mpi::gatherv(world, local_x.data(), sizes_b[world.rank()], 0);
     }
-    bool need;
-    if (world.rank() == 0) {
-      need = isNeedToComplete(x_prev, x_);
-    }
-    boost::mpi::broadcast(world, need, 0);
 
-    if (need) break;
+    Residual local{0.0, 0.0};
+    for (int k = 0; k < sizes_b[world.rank()]; k++) {
+      double diff = local_x[k] - x_prev[displs_b[world.rank()] + k];
+      local.sum_up += diff * diff;
+      local.sum_low += local_x[k] * local_x[k];
+    }
+    // residual of earlier iteration is checked, its all_reduce overlapped with computation of this one
+    const auto residual = convergence.update(local);
+    if (residual && sqrt(residual->sum_up / residual->sum_low) < epsilon_) break;
   }
 
   return true;
@@ -0,0 +1,7 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include "core/backend/func_tests/backend_kernels_tests.hpp"
+#include "core/backend/include/backend_omp.hpp"
+
+INSTANTIATE_TYPED_TEST_SUITE_P(openmp_backend_kernels, BackendKernelsTest, ppc::core::OmpExecutor);
@@ -0,0 +1,10 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/backend/include/backend_omp.hpp"
+#include "core/backend/include/kernel_tasks.hpp"
+
+namespace {
+
+// omp/backend_dot and omp/backend_column_max for bench
+const ppc::core::KernelTasksRegistrar<ppc::core::OmpExecutor> registrar;
+
+}  // namespace
@@ -1,6 +1,8 @@
 // Copyright 2023 Nesterov Alexander
 #pragma once
 
+#include <cstdint>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -8,7 +10,8 @@
 
 namespace nesterov_a_test_task_omp {
 
-std::vector<int> getRandomVector(int sz);
+// Reproducible random vector, same seed gives same vector
+std::vector<int> getRandomVector(int sz, uint64_t seed);
 
 class TestOMPTaskSequential : public ppc::core::Task {
  public:
@@ -20,7 +23,7 @@ class TestOMPTaskSequential : public ppc::core::Task {
   bool post_processing() override;
 
  private:
-  std::vector<int> input_;
+  std::span<int> input_;
   int res{};
   std::string ops;
 };
@@ -35,7 +38,7 @@ class TestOMPTaskParallel : public ppc::core::Task {
   bool post_processing() override;
 
  private:
-  std::vector<int> input_;
+  std::span<int> input_;
   int res{};
   std::string ops;
 };
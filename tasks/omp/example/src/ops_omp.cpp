@@ -3,33 +3,31 @@
 
 #include <omp.h>
 
+#include <algorithm>
 #include <iostream>
 #include <numeric>
-#include <random>
 #include <string>
 #include <thread>
+#include <utility>
 #include <vector>
 
+#include "core/affinity/include/affinity_omp.hpp"
+#include "core/gen/include/generators.hpp"
+#include "core/registry/include/registry.hpp"
+
 using namespace std::chrono_literals;
 
-std::vector<int> nesterov_a_test_task_omp::getRandomVector(int sz) {
-  std::random_device dev;
-  std::mt19937 gen(dev());
-  std::vector<int> vec(sz);
-  for (int i = 0; i < sz; i++) {
-    vec[i] = gen() % 100 + 1;
-  }
-  return vec;
+std::vector<int> nesterov_a_test_task_omp::getRandomVector(int sz, uint64_t seed) {
+  return ppc::core::random_vector<int>(sz, 1, 100, seed);
 }
 
 bool nesterov_a_test_task_omp::TestOMPTaskSequential::pre_processing() {
   internal_order_test();
   // Init vectors
-  input_ = std::vector<int>(taskData->inputs_count[0]);
+  // storage of arena isn't zero-filled, so input is written once
+  input_ = arena.get<int>("input", taskData->inputs_count[0]);
   auto* tmp_ptr = reinterpret_cast<int*>(taskData->inputs[0]);
-  for (unsigned i = 0; i < taskData->inputs_count[0]; i++) {
-    input_[i] = tmp_ptr[i];
-  }
+  std::copy(tmp_ptr, tmp_ptr + input_.size(), input_.begin());
   // Init value for output
   res = 1;
   return true;
@@ -62,11 +60,11 @@ bool nesterov_a_test_task_omp::TestOMPTaskSequential::post_processing() {
 bool nesterov_a_test_task_omp::TestOMPTaskParallel::pre_processing() {
   internal_order_test();
   // Init vectors
-  input_ = std::vector<int>(taskData->inputs_count[0]);
+  ppc::core::pin_omp_threads();
+  // storage of arena isn't zero-filled, so pages are first touched by placed copy
+  input_ = arena.get<int>("input", taskData->inputs_count[0]);
   auto* tmp_ptr = reinterpret_cast<int*>(taskData->inputs[0]);
-  for (unsigned i = 0; i < taskData->inputs_count[0]; i++) {
-    input_[i] = tmp_ptr[i];
-  }
+  ppc::core::placed_copy(input_.data(), tmp_ptr, input_.size() * sizeof(int), omp_get_max_threads());
   // Init value for output
   res = 1;
   return true;
@@ -109,3 +107,19 @@ bool nesterov_a_test_task_omp::TestOMPTaskParallel::post_processing() {
   reinterpret_cast<int*>(taskData->outputs[0])[0] = res;
   return true;
 }
+
+namespace {
+
+std::shared_ptr<ppc::core::Task> make_task(std::shared_ptr<ppc::core::TaskData> taskData) {
+  return std::make_shared<nesterov_a_test_task_omp::TestOMPTaskParallel>(std::move(taskData), "+");
+}
+
+ppc::core::BenchInput make_input(uint64_t size) {
+  auto expected = static_cast<int>(size) + 1;
+  return ppc::core::make_bench_input(std::vector<int>(size, 1), std::vector<int>(1, 0),
+                                     [expected](const std::vector<int>& out) { return out[0] == expected; });
+}
+
+const ppc::core::TaskRegistrar registrar({"omp/example", make_task, make_input, {100000, 1000000}});
+
+}  // namespace
@@ -0,0 +1,10 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/backend/include/backend.hpp"
+#include "core/backend/include/kernel_tasks.hpp"
+
+namespace {
+
+// seq/backend_dot and seq/backend_column_max for bench
+const ppc::core::KernelTasksRegistrar<ppc::core::SeqExecutor> registrar;
+
+}  // namespace
@@ -2,6 +2,10 @@
 #include "seq/example/include/ops_seq.hpp"
 
 #include <thread>
+#include <utility>
+#include <vector>
+
+#include "core/registry/include/registry.hpp"
 
 using namespace std::chrono_literals;
 
@@ -32,3 +36,19 @@ bool nesterov_a_test_task_seq::TestTaskSequential::post_processing() {
   reinterpret_cast<int*>(taskData->outputs[0])[0] = res;
   return true;
 }
+
+namespace {
+
+std::shared_ptr<ppc::core::Task> make_task(std::shared_ptr<ppc::core::TaskData> taskData) {
+  return std::make_shared<nesterov_a_test_task_seq::TestTaskSequential>(std::move(taskData));
+}
+
+ppc::core::BenchInput make_input(uint64_t size) {
+  auto expected = static_cast<int>(size);
+  return ppc::core::make_bench_input(std::vector<int>(1, static_cast<int>(size)), std::vector<int>(1, 0),
+                                     [expected](const std::vector<int>& out) { return out[0] == expected; });
+}
+
+const ppc::core::TaskRegistrar registrar({"seq/example", make_task, make_input, {1000, 100000}});
+
+}  // namespace
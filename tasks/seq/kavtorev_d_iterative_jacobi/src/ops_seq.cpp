@@ -29,7 +29,7 @@ bool kavtorev_d_iterative_jacobi_seq::jacobi_method(int N, const std::vector<dou
     }
     iteration++;
   } while (iteration < iterations && norm > eps);
-  return iteration != iterations;
+  return norm <= eps;
 }
 
 bool kavtorev_d_iterative_jacobi_seq::IterativeJacobiSequential::validation() {
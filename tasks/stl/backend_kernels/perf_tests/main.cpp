@@ -0,0 +1,7 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include "core/backend/func_tests/backend_kernels_perf_tests.hpp"
+#include "core/backend/include/backend.hpp"
+
+INSTANTIATE_TYPED_TEST_SUITE_P(stl_backend_kernels_perf_test, BackendKernelsPerfTest, ppc::core::StlExecutor);
@@ -0,0 +1,10 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/backend/include/backend.hpp"
+#include "core/backend/include/kernel_tasks.hpp"
+
+namespace {
+
+// stl/backend_dot and stl/backend_column_max for bench
+const ppc::core::KernelTasksRegistrar<ppc::core::StlExecutor> registrar;
+
+}  // namespace
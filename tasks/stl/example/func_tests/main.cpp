@@ -8,7 +8,7 @@
 
 TEST(Parallel_Operations_STL_Threads, Test_Sum) {
   auto nthreads = std::thread::hardware_concurrency() * 10;
-  std::vector<int> vec = nesterov_a_test_task_stl::getRandomVector(static_cast<int>(nthreads));
+  std::vector<int> vec = nesterov_a_test_task_stl::getRandomVector(static_cast<int>(nthreads), 1);
   // Create data
   std::vector<int> ref_res(1, 0);
 
@@ -47,7 +47,7 @@ TEST(Parallel_Operations_STL_Threads, Test_Sum) {
 
 TEST(Parallel_Operations_STL_Threads, Test_Sum_2) {
   auto nthreads = std::thread::hardware_concurrency() * 11;
-  std::vector<int> vec = nesterov_a_test_task_stl::getRandomVector(static_cast<int>(nthreads));
+  std::vector<int> vec = nesterov_a_test_task_stl::getRandomVector(static_cast<int>(nthreads), 2);
   // Create data
   std::vector<int> ref_res(1, 0);
 
@@ -86,7 +86,7 @@ TEST(Parallel_Operations_STL_Threads, Test_Sum_2) {
 
 TEST(Parallel_Operations_STL_Threads, Test_Sum_3) {
   auto nthreads = std::thread::hardware_concurrency() * 13;
-  std::vector<int> vec = nesterov_a_test_task_stl::getRandomVector(static_cast<int>(nthreads));
+  std::vector<int> vec = nesterov_a_test_task_stl::getRandomVector(static_cast<int>(nthreads), 3);
   // Create data
   std::vector<int> ref_res(1, 0);
 
@@ -125,7 +125,7 @@ TEST(Parallel_Operations_STL_Threads, Test_Sum_3) {
 
 TEST(Parallel_Operations_STL_Threads, Test_Diff) {
   auto nthreads = std::thread::hardware_concurrency() * 14;
-  std::vector<int> vec = nesterov_a_test_task_stl::getRandomVector(static_cast<int>(nthreads));
+  std::vector<int> vec = nesterov_a_test_task_stl::getRandomVector(static_cast<int>(nthreads), 4);
   // Create data
   std::vector<int> ref_res(1, 0);
 
@@ -164,7 +164,7 @@ TEST(Parallel_Operations_STL_Threads, Test_Diff) {
 
 TEST(Parallel_Operations_STL_Threads, Test_Diff_2) {
   auto nthreads = std::thread::hardware_concurrency() * 15;
-  std::vector<int> vec = nesterov_a_test_task_stl::getRandomVector(static_cast<int>(nthreads));
+  std::vector<int> vec = nesterov_a_test_task_stl::getRandomVector(static_cast<int>(nthreads), 5);
   // Create data
   std::vector<int> ref_res(1, 0);
 
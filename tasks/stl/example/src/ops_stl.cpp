@@ -4,22 +4,21 @@
 #include <future>
 #include <iostream>
 #include <numeric>
-#include <random>
+#include <span>
 #include <string>
 #include <thread>
 #include <utility>
 #include <vector>
 
+#include "core/affinity/include/affinity.hpp"
+#include "core/backend/include/backend.hpp"
+#include "core/gen/include/generators.hpp"
+#include "core/registry/include/registry.hpp"
+
 using namespace std::chrono_literals;
 
-std::vector<int> nesterov_a_test_task_stl::getRandomVector(int sz) {
-  std::random_device dev;
-  std::mt19937 gen(dev());
-  std::vector<int> vec(sz);
-  for (int i = 0; i < sz; i++) {
-    vec[i] = static_cast<int>(gen()) % 100;
-  }
-  return vec;
+std::vector<int> nesterov_a_test_task_stl::getRandomVector(int sz, uint64_t seed) {
+  return ppc::core::random_vector<int>(sz, -99, 99, seed);
 }
 
 bool nesterov_a_test_task_stl::TestSTLTaskSequential::pre_processing() {
@@ -59,7 +58,8 @@ bool nesterov_a_test_task_stl::TestSTLTaskSequential::post_processing() {
 
 std::mutex my_mutex;
 
-void atomOps(std::vector<int> vec, const std::string &ops, std::promise<int> &&pr) {
+void atomOps(int worker, std::span<const int> vec, const std::string &ops, std::promise<int> &&pr) {
+  ppc::core::pin_worker(worker);
   auto sz = vec.size();
   int reduction_elem = 0;
   if (ops == "+") {
@@ -79,11 +79,10 @@ void atomOps(std::vector<int> vec, const std::string &ops, std::promise<int> &&p
 bool nesterov_a_test_task_stl::TestSTLTaskParallel::pre_processing() {
   internal_order_test();
   // Init vectors
-  input_ = std::vector<int>(taskData->inputs_count[0]);
+  // storage of arena isn't zero-filled, so pages are first touched by placed copy
+  input_ = arena.get<int>("input", taskData->inputs_count[0]);
   auto *tmp_ptr = reinterpret_cast<int *>(taskData->inputs[0]);
-  for (unsigned i = 0; i < taskData->inputs_count[0]; i++) {
-    input_[i] = tmp_ptr[i];
-  }
+  ppc::core::placed_copy(input_.data(), tmp_ptr, input_.size() * sizeof(int), ppc::core::default_num_threads());
   // Init value for output
   res = 0;
   return true;
@@ -97,8 +96,7 @@ bool nesterov_a_test_task_stl::TestSTLTaskParallel::validation() {
 
 bool nesterov_a_test_task_stl::TestSTLTaskParallel::run() {
   internal_order_test();
-  const auto nthreads = std::thread::hardware_concurrency();
-  const auto delta = (input_.end() - input_.begin()) / nthreads;
+  const auto nthreads = static_cast<unsigned>(ppc::core::default_num_threads());
 
   auto *promises = new std::promise<int>[nthreads];
   auto *futures = new std::future<int>[nthreads];
@@ -106,8 +104,12 @@ bool nesterov_a_test_task_stl::TestSTLTaskParallel::run() {
 
   for (unsigned i = 0; i < nthreads; i++) {
     futures[i] = promises[i].get_future();
-    std::vector<int> tmp_vec(input_.begin() + i * delta, input_.begin() + (i + 1) * delta);
-    threads[i] = std::thread(atomOps, tmp_vec, ops, std::move(promises[i]));
+    auto [first, last] = ppc::core::block_range(0, input_.size(), nthreads, i);
+    // worker reads its block in place, placed copy first touched its pages near the worker
+    std::span<const int> block = input_.subspan(first, last - first);
+    threads[i] = std::thread(atomOps, static_cast<int>(i), block, ops, std::move(promises[i]));
+  }
+  for (unsigned i = 0; i < nthreads; i++) {
     threads[i].join();
     res += futures[i].get();
   }
@@ -123,3 +125,19 @@ bool nesterov_a_test_task_stl::TestSTLTaskParallel::post_processing() {
   reinterpret_cast<int *>(taskData->outputs[0])[0] = res;
   return true;
 }
+
+namespace {
+
+std::shared_ptr<ppc::core::Task> make_task(std::shared_ptr<ppc::core::TaskData> taskData) {
+  return std::make_shared<nesterov_a_test_task_stl::TestSTLTaskParallel>(std::move(taskData), "+");
+}
+
+ppc::core::BenchInput make_input(uint64_t size) {
+  auto expected = static_cast<int>(size);
+  return ppc::core::make_bench_input(std::vector<int>(size, 1), std::vector<int>(1, 0),
+                                     [expected](const std::vector<int> &out) { return out[0] == expected; });
+}
+
+const ppc::core::TaskRegistrar registrar({"stl/example", make_task, make_input, {100000, 1000000}});
+
+}  // namespace
@@ -0,0 +1,10 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/backend/include/backend_tbb.hpp"
+#include "core/backend/include/kernel_tasks.hpp"
+
+namespace {
+
+// tbb/backend_dot and tbb/backend_column_max for bench
+const ppc::core::KernelTasksRegistrar<ppc::core::TbbExecutor> registrar;
+
+}  // namespace
@@ -6,7 +6,7 @@
 #include "tbb/example/include/ops_tbb.hpp"
 
 TEST(Parallel_Operations_TBB, Test_Sum) {
-  std::vector<int> vec = nesterov_a_test_task_tbb::getRandomVector(100);
+  std::vector<int> vec = nesterov_a_test_task_tbb::getRandomVector(100, 1);
   // Create data
   std::vector<int> ref_res(1, 0);
 
@@ -44,7 +44,7 @@ TEST(Parallel_Operations_TBB, Test_Sum) {
 }
 
 TEST(Parallel_Operations_TBB, Test_Diff) {
-  std::vector<int> vec = nesterov_a_test_task_tbb::getRandomVector(100);
+  std::vector<int> vec = nesterov_a_test_task_tbb::getRandomVector(100, 2);
   // Create data
   std::vector<int> ref_res(1, 0);
 
@@ -82,7 +82,7 @@ TEST(Parallel_Operations_TBB, Test_Diff) {
 }
 
 TEST(Parallel_Operations_TBB, Test_Diff_2) {
-  std::vector<int> vec = nesterov_a_test_task_tbb::getRandomVector(50);
+  std::vector<int> vec = nesterov_a_test_task_tbb::getRandomVector(50, 3);
   // Create data
   std::vector<int> ref_res(1, 0);
 
@@ -120,7 +120,7 @@ TEST(Parallel_Operations_TBB, Test_Diff_2) {
 }
 
 TEST(Parallel_Operations_TBB, Test_Mult) {
-  std::vector<int> vec = nesterov_a_test_task_tbb::getRandomVector(10);
+  std::vector<int> vec = nesterov_a_test_task_tbb::getRandomVector(10, 4);
   // Create data
   std::vector<int> ref_res(1, 0);
 
@@ -158,7 +158,7 @@ TEST(Parallel_Operations_TBB, Test_Mult) {
 }
 
 TEST(Parallel_Operations_TBB, Test_Mult_2) {
-  std::vector<int> vec = nesterov_a_test_task_tbb::getRandomVector(5);
+  std::vector<int> vec = nesterov_a_test_task_tbb::getRandomVector(5, 5);
   // Create data
   std::vector<int> ref_res(1, 0);
 
@@ -2,6 +2,8 @@
 #ifndef TASKS_EXAMPLES_TEST_TBB_OPS_TBB_H_
 #define TASKS_EXAMPLES_TEST_TBB_OPS_TBB_H_
 
+#include <cstdint>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -9,7 +11,8 @@
 
 namespace nesterov_a_test_task_tbb {
 
-std::vector<int> getRandomVector(int sz);
+// Reproducible random vector, same seed gives same vector
+std::vector<int> getRandomVector(int sz, uint64_t seed);
 
 class TestTBBTaskSequential : public ppc::core::Task {
  public:
@@ -36,7 +39,7 @@ class TestTBBTaskParallel : public ppc::core::Task {
   bool post_processing() override;
 
  private:
-  std::vector<int> input_;
+  std::span<int> input_;
   int res{};
   std::string ops;
 };
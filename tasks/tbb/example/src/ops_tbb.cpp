@@ -5,21 +5,21 @@
 
 #include <functional>
 #include <numeric>
-#include <random>
+#include <span>
 #include <string>
 #include <thread>
+#include <utility>
 #include <vector>
 
+#include "core/affinity/include/affinity_tbb.hpp"
+#include "core/backend/include/backend.hpp"
+#include "core/gen/include/generators.hpp"
+#include "core/registry/include/registry.hpp"
+
 using namespace std::chrono_literals;
 
-std::vector<int> nesterov_a_test_task_tbb::getRandomVector(int sz) {
-  std::random_device dev;
-  std::mt19937 gen(dev());
-  std::vector<int> vec(sz);
-  for (int i = 0; i < sz; i++) {
-    vec[i] = gen() % 20 + 1;
-  }
-  return vec;
+std::vector<int> nesterov_a_test_task_tbb::getRandomVector(int sz, uint64_t seed) {
+  return ppc::core::random_vector<int>(sz, 1, 20, seed);
 }
 
 bool nesterov_a_test_task_tbb::TestTBBTaskSequential::pre_processing() {
@@ -62,11 +62,10 @@ bool nesterov_a_test_task_tbb::TestTBBTaskSequential::post_processing() {
 bool nesterov_a_test_task_tbb::TestTBBTaskParallel::pre_processing() {
   internal_order_test();
   // Init vectors
-  input_ = std::vector<int>(taskData->inputs_count[0]);
+  // storage of arena isn't zero-filled, so pages are first touched by placed copy
+  input_ = arena.get<int>("input", taskData->inputs_count[0]);
   auto* tmp_ptr = reinterpret_cast<int*>(taskData->inputs[0]);
-  for (unsigned i = 0; i < taskData->inputs_count[0]; i++) {
-    input_[i] = tmp_ptr[i];
-  }
+  ppc::core::placed_copy(input_.data(), tmp_ptr, input_.size() * sizeof(int), ppc::core::default_num_threads());
   // Init value for output
   res = 1;
   return true;
@@ -80,31 +79,36 @@ bool nesterov_a_test_task_tbb::TestTBBTaskParallel::validation() {
 
 bool nesterov_a_test_task_tbb::TestTBBTaskParallel::run() {
   internal_order_test();
-  if (ops == "+") {
-    res += oneapi::tbb::parallel_reduce(
-        oneapi::tbb::blocked_range<std::vector<int>::iterator>(input_.begin(), input_.end()), 0,
-        [](tbb::blocked_range<std::vector<int>::iterator> r, int running_total) {
-          running_total += std::accumulate(r.begin(), r.end(), 0);
-          return running_total;
-        },
-        std::plus<>());
-  } else if (ops == "-") {
-    res -= oneapi::tbb::parallel_reduce(
-        oneapi::tbb::blocked_range<std::vector<int>::iterator>(input_.begin(), input_.end()), 0,
-        [](tbb::blocked_range<std::vector<int>::iterator> r, int running_total) {
-          running_total += std::accumulate(r.begin(), r.end(), 0);
-          return running_total;
-        },
-        std::plus<>());
-  } else if (ops == "*") {
-    res *= oneapi::tbb::parallel_reduce(
-        oneapi::tbb::blocked_range<std::vector<int>::iterator>(input_.begin(), input_.end()), 1,
-        [](tbb::blocked_range<std::vector<int>::iterator> r, int running_total) {
-          running_total *= std::accumulate(r.begin(), r.end(), 1, std::multiplies<>());
-          return running_total;
-        },
-        std::multiplies<>());
-  }
+  // own arena, so PPC_NUM_THREADS limits workers, observer has to be created inside it
+  oneapi::tbb::task_arena arena(ppc::core::default_num_threads());
+  arena.execute([&] {
+    ppc::core::TbbPinningObserver pinning;
+    if (ops == "+") {
+      res += oneapi::tbb::parallel_reduce(
+          oneapi::tbb::blocked_range<std::span<int>::iterator>(input_.begin(), input_.end()), 0,
+          [](tbb::blocked_range<std::span<int>::iterator> r, int running_total) {
+            running_total += std::accumulate(r.begin(), r.end(), 0);
+            return running_total;
+          },
+          std::plus<>());
+    } else if (ops == "-") {
+      res -= oneapi::tbb::parallel_reduce(
+          oneapi::tbb::blocked_range<std::span<int>::iterator>(input_.begin(), input_.end()), 0,
+          [](tbb::blocked_range<std::span<int>::iterator> r, int running_total) {
+            running_total += std::accumulate(r.begin(), r.end(), 0);
+            return running_total;
+          },
+          std::plus<>());
+    } else if (ops == "*") {
+      res *= oneapi::tbb::parallel_reduce(
+          oneapi::tbb::blocked_range<std::span<int>::iterator>(input_.begin(), input_.end()), 1,
+          [](tbb::blocked_range<std::span<int>::iterator> r, int running_total) {
+            running_total *= std::accumulate(r.begin(), r.end(), 1, std::multiplies<>());
+            return running_total;
+          },
+          std::multiplies<>());
+    }
+  });
   return true;
 }
 
@@ -113,3 +117,19 @@ bool nesterov_a_test_task_tbb::TestTBBTaskParallel::post_processing() {
   reinterpret_cast<int*>(taskData->outputs[0])[0] = res;
   return true;
 }
+
+namespace {
+
+std::shared_ptr<ppc::core::Task> make_task(std::shared_ptr<ppc::core::TaskData> taskData) {
+  return std::make_shared<nesterov_a_test_task_tbb::TestTBBTaskParallel>(std::move(taskData), "+");
+}
+
+ppc::core::BenchInput make_input(uint64_t size) {
+  auto expected = static_cast<int>(size) + 1;
+  return ppc::core::make_bench_input(std::vector<int>(size, 1), std::vector<int>(1, 0),
+                                     [expected](const std::vector<int>& out) { return out[0] == expected; });
+}
+
+const ppc::core::TaskRegistrar registrar({"tbb/example", make_task, make_input, {100000, 1000000}});
+
+}  // namespace